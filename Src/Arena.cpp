@@ -0,0 +1,160 @@
+/**
+** Arena.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Hand out memory from a few large blocks and release them all at once.
+**
+** ChangeLog:
+**     April 2025:
+**       Arena class created
+**/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "Arena.h"
+
+using namespace std;
+
+const size_t Arena::MIN_BLOCK;
+const size_t Arena::MAX_BLOCK;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an empty arena
+*
+* @preconditions: none
+* @postconditions: no memory is taken until the first allocation
+*
+* @parameters: none
+*/
+Arena::Arena()
+    : blocks(nullptr), cursor(nullptr), limit(nullptr),
+      next_block(MIN_BLOCK), bytes_used(0), bytes_reserved(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: destructor
+* @purpose: give every block back to the heap
+*/
+Arena::~Arena()
+{
+    release();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* release
+* purpose: give every block back to the heap at once
+*
+* parameters: none
+* returns: none
+*
+* notes: everything allocated from the arena is gone afterwards; the
+*        arena can be used again, starting over from a small block
+*/
+void Arena::release()
+{
+    while (blocks != nullptr) {
+        Block *next = blocks->next;
+        free(blocks);
+        blocks = next;
+    }
+
+    cursor = limit = nullptr;
+    next_block = MIN_BLOCK;
+    bytes_used = bytes_reserved = 0;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* swap
+* purpose: exchange the blocks of two arenas
+*
+* parameters: an Arena reference, the other arena
+* returns: none
+*
+* notes: memory allocated from either arena stays where it is and now
+*        belongs to the other one
+*/
+void Arena::swap(Arena &other)
+{
+    std::swap(blocks, other.blocks);
+    std::swap(cursor, other.cursor);
+    std::swap(limit, other.limit);
+    std::swap(next_block, other.next_block);
+    std::swap(bytes_used, other.bytes_used);
+    std::swap(bytes_reserved, other.bytes_reserved);
+}
+
+
+
+
+
+/**********************************************************************
+ ******************** private function definitions ********************
+**********************************************************************/
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* grow
+* purpose: take a new block from the heap and allocate from it
+*
+* parameters: 1) a size_t, the number of bytes wanted
+*             2) a size_t, their alignment, a power of two
+* returns: a void pointer, the start of the bytes
+*
+* notes: what was left of the newest block is abandoned. A request too
+*        big for the next block gets a block of exactly its size, linked
+*        in behind the newest one so that block can still be used up.
+*        throws a bad_alloc if the heap is out of memory
+*/
+void *Arena::grow(size_t bytes, size_t align)
+{
+    /* malloc aligns the block for any type; the header keeps that */
+    size_t header = (sizeof(Block) + align - 1) & ~(align - 1);
+    size_t wanted = header + bytes;
+
+    if (wanted > next_block / 2 and blocks != nullptr) {
+        Block *block = static_cast<Block *>(malloc(wanted));
+        if (block == nullptr) throw bad_alloc();
+        block->next = blocks->next;
+        blocks->next = block;
+        bytes_used += bytes;
+        bytes_reserved += wanted;
+        return reinterpret_cast<char *>(block) + header;
+    }
+
+    size_t size = next_block;
+    while (size < wanted) size *= 2;
+
+    Block *block = static_cast<Block *>(malloc(size));
+    if (block == nullptr) throw bad_alloc();
+    block->next = blocks;
+    blocks = block;
+    bytes_reserved += size;
+    if (next_block < MAX_BLOCK) next_block *= 2;
+
+    char *start = reinterpret_cast<char *>(block) + header;
+    cursor = start + bytes;
+    limit = reinterpret_cast<char *>(block) + size;
+    bytes_used += bytes;
+    return start;
+}
@@ -0,0 +1,131 @@
+/**
+** Arena.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A monotonic (bump) allocator: memory is handed out from a few large
+**   blocks, front to back, and is never given back piece by piece; the
+**   whole arena is released at once. Building a graph out of thousands
+**   of small records then costs a few malloc calls instead of one per
+**   record, and tearing it down costs one free per block.
+**
+** Notes:
+**   1) Blocks double in size as the arena grows, from MIN_BLOCK bytes up
+**      to MAX_BLOCK; a request bigger than half the next block gets a
+**      block of its own. The number of blocks stays small, so release is
+**      as good as O(1)
+**   2) Nothing is destroyed: only types with trivial destructors belong
+**      in an arena
+**   3) Array is a growable array whose storage comes from an arena. It
+**      has no constructor or destructor of its own, so it can sit inside
+**      other arena records; an Array that is zero-initialized ({}) is
+**      empty. Growing it takes a block twice the size and leaves the old
+**      one behind, which the arena gets back on release
+**   4) Not safe to allocate from several threads at once
+**
+** ChangeLog:
+**     April 2025:
+**       Arena class created
+**/
+
+#ifndef __ARENA__
+#define __ARENA__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+class Arena {
+
+public:
+    static const size_t MIN_BLOCK = 64 << 10;
+    static const size_t MAX_BLOCK = 4 << 20;
+
+    Arena();
+    ~Arena();
+
+    /* 'align' must be a power of two, no more than malloc's */
+    void *allocate(size_t bytes, size_t align)
+    {
+        uintptr_t at = (reinterpret_cast<uintptr_t>(cursor) + align - 1)
+                       & ~uintptr_t(align - 1);
+        if (cursor == nullptr or
+            at + bytes > reinterpret_cast<uintptr_t>(limit)) {
+            return grow(bytes, align);
+        }
+        cursor = reinterpret_cast<char *>(at + bytes);
+        bytes_used += bytes;
+        return reinterpret_cast<void *>(at);
+    }
+
+    void release();
+    void swap(Arena &other);
+
+    /* bytes handed out, and bytes taken from the heap for them */
+    size_t used() const { return bytes_used; }
+    size_t reserved() const { return bytes_reserved; }
+
+    template <typename T>
+    T *allocate_array(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "an arena never runs destructors");
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    template <typename T>
+    struct Array {
+        T *items;
+        uint32_t count;
+        uint32_t capacity;
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        T &operator[](size_t i) { return items[i]; }
+        const T &operator[](size_t i) const { return items[i]; }
+        T &front() { return items[0]; }
+        const T &front() const { return items[0]; }
+
+        T *begin() { return items; }
+        T *end() { return items + count; }
+        const T *begin() const { return items; }
+        const T *end() const { return items + count; }
+
+        void push_back(Arena &arena, const T &item)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "an Array moves its items with memcpy");
+            if (count == capacity) {
+                uint32_t grown = capacity == 0 ? 1 : 2 * capacity;
+                T *moved = arena.allocate_array<T>(grown);
+                if (count > 0) memcpy(moved, items, count * sizeof(T));
+                items = moved;
+                capacity = grown;
+            }
+            items[count++] = item;
+        }
+    };
+
+private:
+    /* the header of every block; the memory handed out follows it */
+    struct Block {
+        Block *next;
+    };
+
+    Block *blocks;          // most recent first
+    char *cursor;           // next free byte of the newest block
+    char *limit;            // end of the newest block
+    size_t next_block;      // size of the next block to take
+    size_t bytes_used;
+    size_t bytes_reserved;
+
+    void *grow(size_t bytes, size_t align);
+
+    Arena(const Arena &);
+    Arena &operator=(const Arena &);
+};
+
+#endif /* __ARENA__ */
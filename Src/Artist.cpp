@@ -14,14 +14,29 @@
  **
  **   17 Nov 2020: zgolds01
  **     Refactored for concision & clarity, updated documentation
+ **
+ **     April 2025:
+ **     Names and songs are interned in a shared StringPool and kept as
+ **     32-bit symbols, so comparisons are integer compares
+ **     Songs are also kept in a sorted SongSet; collaborations are found
+ **     by intersecting two sets, and every shared song can be listed
  **/
 
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 #include "Artist.h"
 
+/* Intern a name or song; the empty string has no symbol */
+static Artist::Symbol intern(const std::string &str)
+{
+    if (str.empty()) return StringPool::NO_SYMBOL;
+    return Artist::symbols().intern(str);
+}
+
 
 
 
@@ -43,7 +58,7 @@
  */
 Artist::Artist()
 {
-    name = "";
+    name = StringPool::NO_SYMBOL;
 }
 
 
@@ -59,7 +74,25 @@ Artist::Artist()
  */
 Artist::Artist(const std::string &name)
 {
-    this->name = name;
+    this->name = intern(name);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * @function: symbols
+ * @purpose: retrieve the string pool shared by all Artist instances
+ *
+ * @preconditions: none
+ * @postconditions: none
+ *
+ * @parameters: none
+ * @returns: a StringPool reference, where names and songs are interned
+ */
+StringPool &Artist::symbols()
+{
+    static StringPool pool;
+    return pool;
 }
 
 
@@ -78,7 +111,9 @@ Artist::Artist(const std::string &name)
  */
 void Artist::add_song(const std::string &song)
 {
-    discography.push_back(song);
+    Symbol symbol = intern(song);
+    discography.push_back(symbol);
+    song_set.insert(symbol);
 }
 
 
@@ -97,7 +132,7 @@ void Artist::add_song(const std::string &song)
  */
 void Artist::set_name(const std::string &name)
 {
-    this->name = name;
+    this->name = intern(name);
 }
 
 
@@ -113,6 +148,25 @@ void Artist::set_name(const std::string &name)
  * @returns: a std::string, the name of this Artist instance 
  */
 std::string Artist::get_name() const
+{
+    if (name == StringPool::NO_SYMBOL) return "";
+    return symbols().get(name).str();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * @function: get_name_id
+ * @purpose: retrieve the symbol of this Artist instance's name
+ *
+ * @preconditions: none
+ * @postconditions: none
+ *
+ * @parameters: none
+ * @returns: a Symbol, the name's symbol in symbols(), or NO_SYMBOL if the
+ *           name is empty
+ */
+Artist::Symbol Artist::get_name_id() const
 {
     return name;
 }
@@ -133,14 +187,32 @@ std::string Artist::get_name() const
  */
 bool Artist::in_song(const std::string &song) const
 {
-    for (std::size_t i = 0; i < discography.size(); i++) {
-        if (discography.at(i) == song) {
-            return true;
-        }
-    }
+    /* A song nobody has sung was never interned; the empty song has no
+     * symbol to begin with */
+    if (song.empty()) return in_song(StringPool::NO_SYMBOL);
+    Symbol symbol = symbols().find(song);
+    if (symbol == StringPool::NO_SYMBOL) return false;
 
-    /* If the song is not present in discography, then return false */
-    return false;
+    return in_song(symbol);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * @function: in_song
+ * @purpose: determine whether this Artist instance collaborated in
+ *           a given song
+ *
+ * @preconditions: none
+ * @postconditions: none
+ *
+ * @parameters: a Symbol, the song's symbol in symbols()
+ * @returns: a bool, true iff this Artist instance collaborates in the
+ *           provided song
+ */
+bool Artist::in_song(Symbol song) const
+{
+    return song_set.contains(song);
 }
 
 
@@ -159,16 +231,61 @@ bool Artist::in_song(const std::string &song) const
  */
 std::string Artist::get_collaboration(const Artist &artist) const
 {
-    for (std::string song : discography) {
-        if (artist.in_song(song)) {
-            return song;
-        }
-    }
+    std::vector<Symbol> songs = get_collaborations(artist);
 
     /* The empty string represents no collaboration
      * between this instance and the the provided 'artist'
      */
-    return "";
+    if (songs.empty()) return "";
+    return symbols().get(songs.front()).str();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * @function: get_collaborations
+ * @purpose: find every song in which this Artist instance collaborated
+ *           with the given 'artist'
+ *
+ * @preconditions: none
+ * @postconditions: none
+ *
+ * @parameters: a const Artist reference, another artist
+ * @returns: a std::vector of Symbols, the shared songs in the order they
+ *           first appear in this instance's discography (empty if the two
+ *           never collaborated); the first is get_collaboration's song
+ */
+std::vector<Artist::Symbol> Artist::get_collaborations(const Artist &artist) const
+{
+    std::vector<Symbol> songs;
+    song_set.intersect(artist.song_set, songs);
+
+    /* The empty song was never interned, so it is no collaboration */
+    if (not songs.empty() and in_song(StringPool::NO_SYMBOL)) {
+        songs.erase(std::find(songs.begin(), songs.end(),
+                              StringPool::NO_SYMBOL));
+    }
+
+    return songs;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * @function: get_discography
+ * @purpose: retrieve the songs of this Artist instance, in the order
+ *           they were added
+ *
+ * @preconditions: none
+ * @postconditions: none
+ *
+ * @parameters: none
+ * @returns: a const reference to the discography of this Artist instance,
+ *           as symbols in symbols()
+ */
+const std::vector<Artist::Symbol> &Artist::get_discography() const
+{
+    return discography;
 }
 
 
@@ -230,7 +347,9 @@ bool operator!=(const Artist &a1, const Artist &a2)
  */
 std::ostream &operator<<(std::ostream &out, const Artist &artist)
 {
-    out << artist.name;
+    if (artist.name != StringPool::NO_SYMBOL) {
+        out << Artist::symbols().get(artist.name);
+    }
     return out; 
 }
 
@@ -313,6 +432,7 @@ Artist &Artist::operator=(const Artist &rhs)
 
     name = rhs.name;
     discography = rhs.discography;
+    song_set = rhs.song_set;
 
     return *this;
 }
@@ -330,7 +450,7 @@ Artist &Artist::operator=(const Artist &rhs)
  */
 Artist::Artist(Artist &&source)
 {
-    *this = source;
+    *this = std::move(source);
 }
 
 
@@ -348,7 +468,8 @@ Artist::Artist(Artist &&source)
 Artist &Artist::operator=(Artist &&rhs)
 {
     name = rhs.name;
-    discography = rhs.discography;
+    discography = std::move(rhs.discography);
+    song_set = std::move(rhs.song_set);
 
     return *this;
 }
@@ -16,6 +16,10 @@
 **     Refactored for concision & clarity, updated documentation
 **       
 **     April 2025:
+**     Names and songs are interned in a shared StringPool and kept as
+**     32-bit symbols, so comparisons are integer compares
+**     Songs are also kept in a sorted SongSet; collaborations are found
+**     by intersecting two sets, and every shared song can be listed
 **/
 
 #ifndef __ARTIST__
@@ -25,9 +29,17 @@
 #include <string>
 #include <vector>
 
+#include "SongSet.h"
+#include "StringPool.h"
+
 class Artist {
 
 public:
+typedef StringPool::Symbol Symbol;
+
+/* The pool every Artist interns its name and songs in; interning is not
+ * thread-safe, so Artists should be built by one thread at a time */
+static StringPool &symbols();
 
 /* Constructors */
 Artist();
@@ -47,8 +59,12 @@ void set_name(const std::string &name);
 
 /* Accessors */
 std::string get_name() const;
+Symbol      get_name_id() const;
 bool        in_song(const std::string &song) const;
+bool        in_song(Symbol song) const;
 std::string get_collaboration(const Artist &artist) const;
+std::vector<Symbol> get_collaborations(const Artist &artist) const;
+const std::vector<Symbol> &get_discography() const;
 
 
 /* friend functions */
@@ -58,8 +74,9 @@ friend std::ostream & operator << (std::ostream &out,
                                     const Artist &artist);
 
 private:
-std::string name;
-std::vector<std::string> discography;
+Symbol name;                      /* NO_SYMBOL while the name is empty */
+std::vector<Symbol> discography;  /* in the order songs were added */
+SongSet song_set;                 /* the same songs, for lookups */
 };
 
 #endif /* __ARTIST__ */
@@ -0,0 +1,175 @@
+/**
+** BidirectionalSearch.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Find a shortest collaboration path by growing breadth-first frontiers
+**   from both the source and the destination until they meet. On
+**   small-world graphs this visits a tiny fraction of the vertices a
+**   one-sided breadth-first search would.
+**
+** ChangeLog:
+**     April 2025:
+**       bidirectional_search created
+**/
+
+#include <algorithm>
+#include <stack>
+#include <vector>
+
+#include "BidirectionalSearch.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+/*********************************************************************
+ ******************** helper function definitions ********************
+*********************************************************************/
+
+namespace {
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* expand_level
+* purpose: advance one side of the search by a whole breadth-first level
+*
+* parameters: 1) a const FrozenGraph reference, the graph being searched
+*             2) a vector<VertexId> reference, this side's frontier; replaced
+*                by the next level
+*             3) a vector<VertexId> reference, scratch space for the next level
+*             4) a TraversalContext reference, this side's marks/predecessors
+*             5) a const TraversalContext reference, the other side's marks
+* returns: a VertexId, the first newly reached vertex the other side has
+*          already reached, or NO_VERTEX if the sides have not met
+*/
+VertexId expand_level(const FrozenGraph &graph, vector<VertexId> &frontier,
+                      vector<VertexId> &next, TraversalContext &near,
+                      const TraversalContext &far)
+{
+    next.clear();
+
+    for (VertexId current : frontier) {
+        near.count_expansion(graph.degree(current), frontier.size() + next.size());
+        for (EdgeId e = graph.edge_begin(current); e < graph.edge_end(current);
+             e++) {
+            VertexId neighbor = graph.edge_target(e);
+            if (near.is_marked(neighbor)) continue;
+
+            near.mark_vertex(neighbor);
+            near.set_predecessor(neighbor, current);
+            if (far.is_marked(neighbor)) return neighbor;
+            next.push_back(neighbor);
+        }
+    }
+
+    frontier.swap(next);
+    return FrozenGraph::NO_VERTEX;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* join_path
+* purpose: stitch the two halves of a bidirectional search together
+*
+* parameters: 1) a const TraversalContext reference, the source side
+*             2) a const TraversalContext reference, the destination side
+*             3) a VertexId, the source
+*             4) a VertexId, the destination
+*             5) a VertexId, the vertex where the two sides met
+* returns: a stack of VertexIds with the source on top and the destination
+*          at the bottom, as TraversalContext::report_path returns
+*/
+stack<VertexId> join_path(const TraversalContext &forward,
+                          const TraversalContext &backward,
+                          VertexId source, VertexId dest, VertexId meet)
+{
+    vector<VertexId> path;
+    for (VertexId v = meet; v != source; v = forward.get_predecessor(v)) {
+        path.push_back(v);
+    }
+    path.push_back(source);
+    reverse(path.begin(), path.end());
+
+    for (VertexId v = meet; v != dest; ) {
+        v = backward.get_predecessor(v);
+        path.push_back(v);
+    }
+
+    stack<VertexId> result;
+    for (size_t i = path.size(); i > 0; i--) {
+        result.push(path[i - 1]);
+    }
+    return result;
+}
+
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* bidirectional_search
+* purpose: find a shortest path between two artists, searching from both
+*          ends at once
+*
+* parameters: 1) a const FrozenGraph reference, the graph to search
+*             2) a VertexId, the source artist
+*             3) a VertexId, the destination artist
+*             4) a const vector<VertexId> reference, artists the path may not
+*                pass through (the source itself is never excluded)
+*             5) a TraversalContext reference, scratch state for the search;
+*                its backward() context holds the destination side
+* returns: a stack of VertexIds with the source on top and the destination
+*          at the bottom, or an empty stack if no path exists
+*
+* notes: the side with the smaller frontier is always the one expanded
+*/
+stack<VertexId> bidirectional_search(const FrozenGraph &graph,
+                                     VertexId source, VertexId dest,
+                                     const vector<VertexId> &exclude,
+                                     TraversalContext &context)
+{
+    TraversalContext &forward = context;
+    TraversalContext &backward = context.backward();
+    forward.reset(graph.num_vertices());
+    backward.reset(graph.num_vertices());
+
+    stack<VertexId> path;
+    if (source == dest) {
+        path.push(source);
+        return path;
+    }
+
+    for (VertexId artist : exclude) {
+        if (artist == dest) return path;
+        if (artist == source) continue;
+        forward.mark_vertex(artist);
+        backward.mark_vertex(artist);
+    }
+
+    forward.mark_vertex(source);
+    backward.mark_vertex(dest);
+
+    vector<VertexId> front(1, source), back(1, dest), next;
+    while (not front.empty() and not back.empty()) {
+        VertexId meet;
+        if (front.size() <= back.size()) {
+            meet = expand_level(graph, front, next, forward, backward);
+        } else {
+            meet = expand_level(graph, back, next, backward, forward);
+        }
+
+        if (meet != FrozenGraph::NO_VERTEX) {
+            return join_path(forward, backward, source, dest, meet);
+        }
+    }
+
+    return path;
+}
@@ -0,0 +1,42 @@
+/**
+** BidirectionalSearch.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Find a shortest collaboration path by growing breadth-first frontiers
+**   from both the source and the destination until they meet. On
+**   small-world graphs this visits a tiny fraction of the vertices a
+**   one-sided breadth-first search would.
+**
+** Notes:
+**   1) Each round expands one whole level of whichever side has the
+**      smaller frontier; the first vertex reached by both sides lies on a
+**      shortest path, so the path returned is always a shortest one
+**   2) When several shortest paths exist, the one returned can differ from
+**      the one a one-sided search would find
+**   3) Excluded artists are never entered by either side, which is how
+**      the "not" command is answered
+**
+** ChangeLog:
+**     April 2025:
+**       bidirectional_search created
+**/
+
+#ifndef __BIDIRECTIONAL_SEARCH__
+#define __BIDIRECTIONAL_SEARCH__
+
+#include <stack>
+#include <vector>
+
+#include "FrozenGraph.h"
+#include "TraversalContext.h"
+
+std::stack<FrozenGraph::VertexId>
+bidirectional_search(const FrozenGraph &graph,
+                     FrozenGraph::VertexId source,
+                     FrozenGraph::VertexId dest,
+                     const std::vector<FrozenGraph::VertexId> &exclude,
+                     TraversalContext &context);
+
+#endif /* __BIDIRECTIONAL_SEARCH__ */
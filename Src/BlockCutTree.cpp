@@ -0,0 +1,309 @@
+/**
+** BlockCutTree.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Find the biconnected blocks, articulation points and bridges of the
+**   graph, and tell whether excluding some artists can cut two others
+**   apart without searching.
+**
+** ChangeLog:
+**     April 2025:
+**       BlockCutTree class created
+**/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "BlockCutTree.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+typedef BlockCutTree::NodeId NodeId;
+
+const NodeId BlockCutTree::NO_NODE;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize a tree of no vertices
+*
+* @preconditions: none
+* @postconditions: the tree is empty until build is called
+*
+* @parameters: none
+*/
+BlockCutTree::BlockCutTree()
+    : blocks(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* build
+* purpose: find the blocks and cut vertices of a graph and join them into
+*          a tree
+*
+* parameters: a const FrozenGraph reference, the graph; the tree stays
+*             valid for it (and its copies) only
+* returns: none
+*
+* notes: a depth-first search numbers the vertices in discovery order and
+*        works out the lowest number each subtree reaches over a single
+*        back edge. When a child's subtree reaches no higher than its
+*        parent, the parent cuts it off: the vertices stacked since the
+*        child, with the parent, make a block, and a non-root parent is a
+*        cut vertex. The root is one only if it has several children
+*/
+void BlockCutTree::build(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    node.assign(n, NO_NODE);
+    parent.clear();
+    depth.clear();
+    owner.clear();
+    cuts.clear();
+    bridge_list.clear();
+    blocks = 0;
+
+    /* discovery numbers (0 for unvisited), lowest numbers reached, and
+     * the search's own stack frames */
+    vector<uint32_t> number(n, 0), low(n, 0);
+    vector<VertexId> dfs_parent(n, FrozenGraph::NO_VERTEX);
+    vector<EdgeId> next_edge(n);
+    vector<VertexId> frames, members;
+    vector<NodeId> root_blocks;
+    uint32_t counter = 0;
+
+    for (VertexId root = 0; root < n; root++) {
+        if (number[root] != 0 or graph.degree(root) == 0) continue;
+
+        number[root] = low[root] = ++counter;
+        next_edge[root] = graph.edge_begin(root);
+        frames.push_back(root);
+        members.push_back(root);
+        root_blocks.clear();
+
+        while (not frames.empty()) {
+            VertexId u = frames.back();
+            if (next_edge[u] < graph.edge_end(u)) {
+                VertexId w = graph.edge_target(next_edge[u]++);
+                if (number[w] == 0) {
+                    dfs_parent[w] = u;
+                    number[w] = low[w] = ++counter;
+                    next_edge[w] = graph.edge_begin(w);
+                    frames.push_back(w);
+                    members.push_back(w);
+                } else if (w != dfs_parent[u]) {
+                    low[u] = min(low[u], number[w]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            if (u == root) break;
+
+            VertexId p = dfs_parent[u];
+            low[p] = min(low[p], low[u]);
+            if (low[u] < number[p]) continue;
+
+            /* p cuts off u's subtree: the vertices stacked since u and p
+             * make a block, hung under p's node unless p is the root */
+            if (low[u] > number[p]) {
+                bridge_list.push_back(make_pair(min(p, u), max(p, u)));
+            }
+            if (p != root and node[p] == NO_NODE) node[p] = new_node(p);
+            NodeId block = new_node(FrozenGraph::NO_VERTEX);
+            blocks++;
+            VertexId w;
+            do {
+                w = members.back();
+                members.pop_back();
+                if (node[w] == NO_NODE) {
+                    node[w] = block;
+                } else {
+                    parent[node[w]] = block;
+                }
+            } while (w != u);
+
+            if (p == root) {
+                root_blocks.push_back(block);
+            } else {
+                parent[block] = node[p];
+            }
+        }
+        members.pop_back();
+
+        if (root_blocks.size() > 1) {
+            node[root] = new_node(root);
+            for (NodeId block : root_blocks) parent[block] = node[root];
+        } else {
+            node[root] = root_blocks[0];
+        }
+    }
+
+    for (VertexId v = 0; v < n; v++) {
+        if (is_cut_vertex(v)) cuts.push_back(v);
+    }
+    sort(bridge_list.begin(), bridge_list.end());
+    set_depths();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* effect
+* purpose: tell whether excluding some artists can change the shortest
+*          paths between two others
+*
+* parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist, connected to the
+*                source
+*             3) a const vector of VertexIds reference, the excluded artists
+* returns: an Effect: SEPARATES if an excluded artist is a cut vertex
+*          between the two, NO_EFFECT if none is in a block on their tree
+*          path (see note 3 in BlockCutTree.h), and MAY_SEPARATE otherwise,
+*          or if the source or destination is itself excluded
+*
+* notes: costs time in proportion to the tree path times the number of
+*        excluded artists, however large the graph
+*/
+BlockCutTree::Effect BlockCutTree::effect(VertexId source, VertexId dest,
+                                          const vector<VertexId> &exclude) const
+{
+    if (source == dest) return MAY_SEPARATE;
+    for (VertexId x : exclude) {
+        if (x == source or x == dest) return MAY_SEPARATE;
+    }
+
+    vector<NodeId> path;
+    if (not tree_path(node[source], node[dest], path)) return MAY_SEPARATE;
+
+    /* A cut vertex is in its parent block and in each of its children */
+    bool touched = false;
+    for (VertexId x : exclude) {
+        NodeId at = node[x];
+        if (at == NO_NODE) continue;
+
+        bool on_path = find(path.begin(), path.end(), at) != path.end();
+        if (owner[at] != x) {
+            touched = touched or on_path;
+            continue;
+        }
+        if (on_path) return SEPARATES;
+
+        if (parent[at] != NO_NODE and
+            find(path.begin(), path.end(), parent[at]) != path.end()) {
+            touched = true;
+        }
+        for (NodeId step : path) {
+            if (parent[step] == at) touched = true;
+        }
+    }
+
+    return touched ? MAY_SEPARATE : NO_EFFECT;
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* new_node
+* purpose: add a node to the tree, with no parent yet
+*
+* parameters: a VertexId, the cut vertex the node stands for, or
+*             FrozenGraph::NO_VERTEX for a block
+* returns: a NodeId, the new node
+*/
+NodeId BlockCutTree::new_node(VertexId v)
+{
+    parent.push_back(NO_NODE);
+    owner.push_back(v);
+
+    return owner.size() - 1;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* set_depths
+* purpose: work out how far below its tree's root every node is
+*
+* parameters: none
+* returns: none
+*
+* notes: nodes are made in no particular order relative to their parents,
+*        so each node climbs to the nearest one already done and fills in
+*        the way back down; every node is filled in once
+*/
+void BlockCutTree::set_depths()
+{
+    const uint32_t UNKNOWN = UINT32_MAX;
+    depth.assign(owner.size(), UNKNOWN);
+
+    vector<NodeId> climb;
+    for (NodeId x = 0; x < owner.size(); x++) {
+        NodeId at = x;
+        while (at != NO_NODE and depth[at] == UNKNOWN) {
+            climb.push_back(at);
+            at = parent[at];
+        }
+
+        uint32_t d = at == NO_NODE ? 0 : depth[at] + 1;
+        for (; not climb.empty(); climb.pop_back(), d++) {
+            depth[climb.back()] = d;
+        }
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* tree_path
+* purpose: list the nodes on the tree path between two nodes
+*
+* parameters: 1) a NodeId, one end
+*             2) a NodeId, the other end
+*             3) a vector of NodeIds reference, filled with the path's
+*                nodes, ends included, in no particular order
+* returns: a bool, false if either end is NO_NODE or the two are in
+*          different trees
+*
+* notes: the deeper end climbs until the two are level, then both climb
+*        until they meet, so the cost is the length of the path
+*/
+bool BlockCutTree::tree_path(NodeId a, NodeId b, vector<NodeId> &path) const
+{
+    if (a == NO_NODE or b == NO_NODE) return false;
+
+    while (depth[a] > depth[b]) {
+        path.push_back(a);
+        a = parent[a];
+    }
+    while (depth[b] > depth[a]) {
+        path.push_back(b);
+        b = parent[b];
+    }
+    while (a != b) {
+        path.push_back(a);
+        path.push_back(b);
+        a = parent[a];
+        b = parent[b];
+        if (a == NO_NODE) return false;
+    }
+    path.push_back(a);
+
+    return true;
+}
@@ -0,0 +1,103 @@
+/**
+** BlockCutTree.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Split the graph into its biconnected blocks and find the artists and
+**   collaborations every path between some two artists must go through,
+**   so a not query can tell, by walking a short tree path, whether the
+**   artists it excludes can cut its source off from its destination.
+**
+** Notes:
+**   1) A block is a largest set of collaborations no one artist's removal
+**      disconnects; blocks meet at articulation points (cut vertices),
+**      and a block of a single collaboration is a bridge
+**   2) The block-cut tree has a node per block and per cut vertex, joined
+**      when the cut vertex is in the block; every connected component is
+**      one tree. A cut vertex stands for itself in the tree, any other
+**      artist for the one block it is in; isolated artists are in none
+**   3) Every simple path between two artists keeps to the blocks on
+**      their tree path, so an excluded artist in none of those blocks
+**      leaves every such path, the shortest ones included, alone; and an
+**      excluded cut vertex on the tree path separates the two outright
+**   4) build finds the blocks with Tarjan's depth-first search, kept on
+**      explicit stacks so long chains cannot overflow the call stack,
+**      in time and space proportional to the graph
+**   5) The tree belongs to one graph; the owner must drop or rebuild it
+**      when the graph changes. Lookups never change the tree, so any
+**      number of threads may read it at once
+**
+** ChangeLog:
+**     April 2025:
+**       BlockCutTree class created
+**/
+
+#ifndef __BLOCK_CUT_TREE__
+#define __BLOCK_CUT_TREE__
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class BlockCutTree {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef uint32_t NodeId;
+
+    /* the node of an isolated artist, and the parent of a tree's root */
+    static const NodeId NO_NODE = UINT32_MAX;
+
+    /* what excluding some artists does to the paths between two others */
+    enum Effect {
+        NO_EFFECT,    // no shortest path goes through any of them
+        MAY_SEPARATE, // some might; only a search can tell
+        SEPARATES     // one of them is on every path
+    };
+
+    BlockCutTree();
+
+    void build(const FrozenGraph &graph);
+
+    bool empty() const { return node.empty(); }
+    size_t num_vertices() const { return node.size(); }
+    size_t num_blocks() const { return blocks; }
+
+    bool is_cut_vertex(VertexId v) const
+    {
+        return node[v] != NO_NODE and owner[node[v]] == v;
+    }
+
+    /* in id order, and in order of their lower then higher ids */
+    const std::vector<VertexId> &cut_vertices() const { return cuts; }
+    const std::vector<std::pair<VertexId, VertexId>> &bridges() const
+    {
+        return bridge_list;
+    }
+
+    Effect effect(VertexId source, VertexId dest,
+                  const std::vector<VertexId> &exclude) const;
+
+private:
+    /* the tree node of every vertex */
+    std::vector<NodeId> node;
+
+    /* per tree node: its parent, its depth below its tree's root, and the
+     * vertex it stands for (NO_VERTEX for blocks) */
+    std::vector<NodeId> parent;
+    std::vector<uint32_t> depth;
+    std::vector<VertexId> owner;
+
+    size_t blocks;
+    std::vector<VertexId> cuts;
+    std::vector<std::pair<VertexId, VertexId>> bridge_list;
+
+    NodeId new_node(VertexId v);
+    void set_depths();
+    bool tree_path(NodeId a, NodeId b, std::vector<NodeId> &path) const;
+};
+
+#endif /* __BLOCK_CUT_TREE__ */
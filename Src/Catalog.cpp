@@ -0,0 +1,361 @@
+/**
+** Catalog.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Remember which songs every artist sings and which artists sing every
+**   song, so catalog updates can find the collaborations they affect.
+**
+** ChangeLog:
+**     April 2025:
+**       Catalog class created
+**       Record order kept for renumbered graphs
+**/
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "Catalog.h"
+
+using namespace std;
+
+typedef Catalog::VertexId VertexId;
+typedef Catalog::SongId SongId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+const SongId Catalog::NO_SONG;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize a catalog of no artists and no songs
+*
+* @preconditions: none
+* @postconditions: the catalog is empty until build or derive is called
+*
+* @parameters: none
+*/
+Catalog::Catalog()
+    : song_offsets(1, 0), singer_offsets(1, 0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* build
+* purpose: fill the catalog from the lines of a data file
+*
+* parameters: 1) a const StringPool reference, the song titles; a credit's
+*                song is its title's symbol in this pool
+*             2) a size_t, the number of artists
+*             3) a const vector of Credits reference, every song line of
+*                every record, in file order
+* returns: none
+*
+* notes: a song repeated by one artist is kept where it first appears.
+*        Any earlier contents are dropped
+*/
+void Catalog::build(const StringPool &titles, size_t num_artists,
+                    const vector<Credit> &credits)
+{
+    this->titles = titles;
+    edited_songs.clear();
+    edited_singers.clear();
+    record_order.clear();
+
+    /* Lay out every artist's lines, then squeeze out the repeats */
+    song_offsets.assign(num_artists + 1, 0);
+    for (const Credit &credit : credits) song_offsets[credit.artist + 1]++;
+    for (size_t v = 0; v < num_artists; v++) {
+        song_offsets[v + 1] += song_offsets[v];
+    }
+
+    discography.resize(credits.size());
+    vector<uint64_t> fill(song_offsets.begin(), song_offsets.end() - 1);
+    for (const Credit &credit : credits) {
+        discography[fill[credit.artist]++] = credit.song;
+    }
+
+    size_t num_songs = titles.size();
+    vector<VertexId> listed_by(num_songs, FrozenGraph::NO_VERTEX);
+    uint64_t kept = 0;
+    for (VertexId v = 0; v < num_artists; v++) {
+        uint64_t begin = song_offsets[v], end = song_offsets[v + 1];
+        song_offsets[v] = kept;
+        for (uint64_t i = begin; i < end; i++) {
+            SongId song = discography[i];
+            if (listed_by[song] == v) continue;
+            listed_by[song] = v;
+            discography[kept++] = song;
+        }
+    }
+    song_offsets[num_artists] = kept;
+    discography.resize(kept);
+    discography.shrink_to_fit();
+
+    /* Walking the artists in id order lists every song's singers in order */
+    singer_offsets.assign(num_songs + 1, 0);
+    for (SongId song : discography) singer_offsets[song + 1]++;
+    for (size_t s = 0; s < num_songs; s++) {
+        singer_offsets[s + 1] += singer_offsets[s];
+    }
+
+    singer_list.resize(discography.size());
+    fill.assign(singer_offsets.begin(), singer_offsets.end() - 1);
+    for (VertexId v = 0; v < num_artists; v++) {
+        for (uint64_t i = song_offsets[v]; i < song_offsets[v + 1]; i++) {
+            singer_list[fill[discography[i]]++] = v;
+        }
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* derive
+* purpose: fill the catalog from the songs on a graph's collaborations
+*
+* parameters: a const FrozenGraph reference, the graph
+* returns: none
+*
+* notes: the best that can be done for a graph loaded from a snapshot;
+*        see note 4 in Catalog.h
+*/
+void Catalog::derive(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    size_t num_songs = graph.num_songs();
+
+    /* The graph's titles are distinct, so each keeps its id here */
+    StringPool pool;
+    pool.reserve(num_songs);
+    for (SongId s = 0; s < num_songs; s++) pool.intern(graph.get_song(s));
+
+    vector<Credit> credits;
+    vector<VertexId> listed_by(num_songs, FrozenGraph::NO_VERTEX);
+    for (VertexId v = 0; v < n; v++) {
+        for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+            for (const SongId *s = graph.edge_songs_begin(e);
+                 s != graph.edge_songs_end(e); s++) {
+                if (listed_by[*s] == v) continue;
+                listed_by[*s] = v;
+                credits.push_back({ v, *s });
+            }
+        }
+    }
+
+    build(pool, n, credits);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert_artist
+* purpose: add an artist who sings nothing yet
+*
+* parameters: none
+* returns: a VertexId, the new artist, numbered after every existing one
+*/
+VertexId Catalog::insert_artist()
+{
+    song_offsets.push_back(song_offsets.back());
+    if (not record_order.empty()) record_order.push_back(num_artists() - 1);
+
+    return num_artists() - 1;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* songs
+* purpose: list the songs an artist sings
+*
+* parameters: a VertexId, the artist
+* returns: a Range of SongIds, in the artist's order
+*/
+Catalog::Range<SongId> Catalog::songs(VertexId v) const
+{
+    auto edited = edited_songs.find(v);
+    if (edited != edited_songs.end()) {
+        const vector<SongId> &list = edited->second;
+        return { list.data(), list.data() + list.size() };
+    }
+
+    const SongId *base = discography.data();
+    return { base + song_offsets[v], base + song_offsets[v + 1] };
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* singers
+* purpose: list the artists who sing a song
+*
+* parameters: a SongId, the song
+* returns: a Range of VertexIds, in id order; empty for a song nobody
+*          sings
+*/
+Catalog::Range<VertexId> Catalog::singers(SongId song) const
+{
+    auto edited = edited_singers.find(song);
+    if (edited != edited_singers.end()) {
+        const vector<VertexId> &list = edited->second;
+        return { list.data(), list.data() + list.size() };
+    }
+    if (song + 1 >= singer_offsets.size()) return { nullptr, nullptr };
+
+    const VertexId *base = singer_list.data();
+    return { base + singer_offsets[song], base + singer_offsets[song + 1] };
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* add_song
+* purpose: record that an artist sings a song
+*
+* parameters: 1) a VertexId, the artist
+*             2) a SongId, the song, from insert_song
+* returns: a bool, false if the artist sang it already (nothing changes)
+*/
+bool Catalog::add_song(VertexId v, SongId song)
+{
+    Range<SongId> current = songs(v);
+    if (find(current.begin(), current.end(), song) != current.end()) {
+        return false;
+    }
+
+    songs_to_edit(v).push_back(song);
+    vector<VertexId> &list = singers_to_edit(song);
+    list.insert(lower_bound(list.begin(), list.end(), v), v);
+
+    return true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* remove_song
+* purpose: record that an artist no longer sings a song
+*
+* parameters: 1) a VertexId, the artist
+*             2) a SongId, the song
+* returns: a bool, false if the artist did not sing it (nothing changes)
+*/
+bool Catalog::remove_song(VertexId v, SongId song)
+{
+    Range<SongId> current = songs(v);
+    if (find(current.begin(), current.end(), song) == current.end()) {
+        return false;
+    }
+
+    vector<SongId> &list = songs_to_edit(v);
+    list.erase(find(list.begin(), list.end(), song));
+    vector<VertexId> &singing = singers_to_edit(song);
+    singing.erase(lower_bound(singing.begin(), singing.end(), v));
+
+    return true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* shared
+* purpose: list the songs two artists both sing
+*
+* parameters: 1) a VertexId, one artist
+*             2) a VertexId, another artist
+* returns: a vector of SongIds, in the first artist's order; these are the
+*          songs of the two artists' collaboration when the first is
+*          listed_before the other
+*/
+vector<SongId> Catalog::shared(VertexId a, VertexId b) const
+{
+    Range<SongId> theirs = songs(b);
+    vector<SongId> sorted(theirs.begin(), theirs.end());
+    sort(sorted.begin(), sorted.end());
+
+    vector<SongId> result;
+    for (SongId song : songs(a)) {
+        if (binary_search(sorted.begin(), sorted.end(), song)) {
+            result.push_back(song);
+        }
+    }
+
+    return result;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* set_record_order
+* purpose: remember the order the artists' records came in, once the
+*          artists have been renumbered
+*
+* parameters: a const vector<VertexId> reference, the new id of every
+*             artist, indexed by its id in record order
+* returns: none
+*
+* notes: listed_before then compares places in the data file rather than
+*        ids, so songs are ordered as when the graph was built
+*/
+void Catalog::set_record_order(const vector<VertexId> &new_id)
+{
+    record_order.assign(num_artists(), 0);
+    for (VertexId v = 0; v < new_id.size(); v++) record_order[new_id[v]] = v;
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* songs_to_edit
+* purpose: get an artist's own list of songs, copying its row the first
+*          time
+*
+* parameters: a VertexId, the artist
+* returns: a vector of SongIds reference, the artist's songs
+*/
+vector<SongId> &Catalog::songs_to_edit(VertexId v)
+{
+    auto edited = edited_songs.find(v);
+    if (edited == edited_songs.end()) {
+        Range<SongId> current = songs(v);
+        edited = edited_songs.insert(
+            { v, vector<SongId>(current.begin(), current.end()) }).first;
+    }
+
+    return edited->second;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* singers_to_edit
+* purpose: get a song's own list of singers, copying its row the first
+*          time
+*
+* parameters: a SongId, the song
+* returns: a vector of VertexIds reference, the song's singers
+*/
+vector<VertexId> &Catalog::singers_to_edit(SongId song)
+{
+    auto edited = edited_singers.find(song);
+    if (edited == edited_singers.end()) {
+        Range<VertexId> current = singers(song);
+        edited = edited_singers.insert(
+            { song, vector<VertexId>(current.begin(), current.end()) }).first;
+    }
+
+    return edited->second;
+}
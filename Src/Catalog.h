@@ -0,0 +1,123 @@
+/**
+** Catalog.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Remember which songs every artist sings and which artists sing every
+**   song, so a change to one artist's songs can be turned into changes to
+**   just the collaborations it affects.
+**
+** Notes:
+**   1) Artists are numbered as in the FrozenGraph; songs by their title's
+**      symbol in the catalog's own title pool, which is not the graph's
+**   2) An artist's songs keep the order of its data file record, each
+**      listed once, with added songs at the end; a song's singers are
+**      kept in id order
+**   3) Built from the records while the graph is built, as two CSR
+**      tables. Artists and songs changed later get lists of their own,
+**      which take the place of their rows in the tables
+**   4) derive rebuilds a catalog from the graph alone, for a graph loaded
+**      from a snapshot: songs no two artists share were never saved, so
+**      it does not know them, and an artist's songs are listed in the
+**      order its collaborations list them
+**   5) A collaboration lists its songs in the order of the artist whose
+**      record came first. That is the one with the lower id, unless the
+**      graph was renumbered after it was built (see VertexOrder), when
+**      set_record_order says which; added artists come after the rest
+**
+** ChangeLog:
+**     April 2025:
+**       Catalog class created
+**       Record order kept for renumbered graphs
+**/
+
+#ifndef __CATALOG__
+#define __CATALOG__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "FrozenGraph.h"
+#include "StringPool.h"
+#include "StringRef.h"
+
+class Catalog {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef StringPool::Symbol SongId;
+
+    /* song returned by find_song for titles no artist has sung */
+    static const SongId NO_SONG = StringPool::NO_SYMBOL;
+
+    /* one line of a record: an artist sings a song */
+    struct Credit {
+        VertexId artist;
+        SongId song;
+    };
+
+    /* a run of ids; valid until the catalog next changes */
+    template <typename T>
+    struct Range {
+        const T *first;
+        const T *last;
+
+        const T *begin() const { return first; }
+        const T *end() const { return last; }
+        size_t size() const { return last - first; }
+    };
+
+    Catalog();
+
+    void build(const StringPool &titles, size_t num_artists,
+               const std::vector<Credit> &credits);
+    void derive(const FrozenGraph &graph);
+
+    size_t num_artists() const { return song_offsets.size() - 1; }
+    VertexId insert_artist();
+
+    SongId find_song(const StringRef &title) const { return titles.find(title); }
+    SongId insert_song(const StringRef &title) { return titles.intern(title); }
+    StringRef title(SongId song) const { return titles.get(song); }
+
+    Range<SongId> songs(VertexId v) const;
+    Range<VertexId> singers(SongId song) const;
+
+    bool add_song(VertexId v, SongId song);
+    bool remove_song(VertexId v, SongId song);
+
+    std::vector<SongId> shared(VertexId a, VertexId b) const;
+
+    void set_record_order(const std::vector<VertexId> &new_id);
+    bool listed_before(VertexId a, VertexId b) const
+    {
+        return record_order.empty() ? a < b
+                                    : record_order[a] < record_order[b];
+    }
+
+private:
+    StringPool titles;
+
+    /* as built: the songs of artist v are [song_offsets[v],
+     * song_offsets[v + 1]) of 'discography', the singers of song s are
+     * [singer_offsets[s], singer_offsets[s + 1]) of 'singer_list' */
+    std::vector<uint64_t> song_offsets;
+    std::vector<SongId>   discography;
+    std::vector<uint64_t> singer_offsets;
+    std::vector<VertexId> singer_list;
+
+    /* the lists of artists and songs changed since */
+    std::unordered_map<VertexId, std::vector<SongId>> edited_songs;
+    std::unordered_map<SongId, std::vector<VertexId>> edited_singers;
+
+    /* the place of artist v's record among all of them; empty if that
+     * is v itself */
+    std::vector<VertexId> record_order;
+
+    std::vector<SongId> &songs_to_edit(VertexId v);
+    std::vector<VertexId> &singers_to_edit(SongId song);
+};
+
+#endif /* __CATALOG__ */
@@ -0,0 +1,162 @@
+/**
+** CatalogGenerator.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Draw a synthetic catalog with power-law song and artist distributions
+**   and write it in the data file format.
+**
+** ChangeLog:
+**     April 2025:
+**       CatalogGenerator class created
+**/
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CatalogGenerator.h"
+
+using namespace std;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: Shape nullary constructor
+* @purpose: initialize the default shape
+*
+* @preconditions: none
+* @postconditions: the fields hold the defaults below, which connect about
+*                  five artists in six into one giant component, as in
+*                  real collaboration graphs, at any size
+*
+* @parameters: none
+*/
+CatalogGenerator::Shape::Shape()
+    : artist_exponent(2.8), song_exponent(2.0), max_singers(30),
+      songs_per_artist(3.0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: draw a catalog
+*
+* @preconditions: the exponents are in range (see Shape) and max_singers is
+*                 at least 1
+* @postconditions: the catalog is ready to write
+*
+* @parameters: 1) a size_t, the number of artists
+*             2) an unsigned, the random seed
+*             3) a const Shape reference, the distributions to draw from
+*
+* @notes: a singer is picked by a binary search of the running sums of the
+*         weights, so drawing costs O(credits * log(artists)); a song
+*         that picks an artist twice gets one more try per singer before
+*         it settles for fewer
+*/
+CatalogGenerator::CatalogGenerator(size_t num_artists, unsigned seed,
+                                   const Shape &shape)
+    : offsets(num_artists + 1, 0), songs(0)
+{
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    /* Pareto weights, x = (1 - u) ^ (-1 / (alpha - 1)), summed as we go */
+    vector<double> running(num_artists);
+    double total = 0;
+    for (size_t i = 0; i < num_artists; i++) {
+        total += pow(1.0 - uniform(rng), -1.0 / (shape.artist_exponent - 1.0));
+        running[i] = total;
+    }
+
+    vector<uint32_t> artist_of, song_of;
+    size_t target = size_t(shape.songs_per_artist * num_artists);
+    vector<uint32_t> singers;
+    while (num_artists > 0 and artist_of.size() < target) {
+        double tail = pow(1.0 - uniform(rng), -1.0 / (shape.song_exponent - 1.0));
+        uint32_t wanted = uint32_t(min(tail, double(shape.max_singers)));
+        wanted = max<uint32_t>(1, min<size_t>(wanted, num_artists));
+
+        singers.clear();
+        for (uint32_t tries = 0; tries < 2 * wanted and singers.size() < wanted;
+             tries++) {
+            size_t i = upper_bound(running.begin(), running.end(),
+                                   uniform(rng) * total) - running.begin();
+            i = min(i, num_artists - 1);
+            if (find(singers.begin(), singers.end(), i) == singers.end()) {
+                singers.push_back(i);
+            }
+        }
+
+        for (uint32_t i : singers) {
+            artist_of.push_back(i);
+            song_of.push_back(songs);
+        }
+        songs++;
+    }
+
+    /* Count each artist's songs, giving the silent ones a solo song */
+    for (uint32_t i : artist_of) offsets[i + 1]++;
+    for (size_t i = 0; i < num_artists; i++) {
+        if (offsets[i + 1] == 0) {
+            artist_of.push_back(i);
+            song_of.push_back(songs++);
+            offsets[i + 1]++;
+        }
+        offsets[i + 1] += offsets[i];
+    }
+
+    credits.resize(artist_of.size());
+    vector<uint64_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t k = 0; k < artist_of.size(); k++) {
+        credits[fill[artist_of[k]]++] = song_of[k];
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* write
+* purpose: write the catalog in the data file format
+*
+* parameters: a std::ostream reference, the stream to write to
+* returns: none
+*
+* notes: records are formatted into a buffer that is handed to the stream
+*        a megabyte at a time
+*/
+void CatalogGenerator::write(ostream &out) const
+{
+    const size_t FLUSH_AT = 1 << 20;
+    string buffer;
+    buffer.reserve(FLUSH_AT + 256);
+
+    for (size_t i = 0; i < num_artists(); i++) {
+        buffer += "Artist ";
+        buffer += to_string(i);
+        buffer += '\n';
+        for (uint64_t k = offsets[i]; k < offsets[i + 1]; k++) {
+            buffer += "Song ";
+            buffer += to_string(credits[k]);
+            buffer += '\n';
+        }
+        buffer += "*\n";
+
+        if (buffer.size() >= FLUSH_AT) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+}
@@ -0,0 +1,70 @@
+/**
+** CatalogGenerator.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Make up synthetic data files of any size, shaped like real catalogs:
+**   most artists sing a few songs with one or two others, while a few
+**   stars sing a great many, so benchmarks can be run on graphs far
+**   larger than the test data.
+**
+** Notes:
+**   1) Every artist gets an activity weight drawn from a Pareto
+**      (power-law) distribution. Songs are made one at a time; each gets
+**      a number of singers drawn from another, steeper power law, and the
+**      singers are picked in proportion to their weights. So the songs
+**      per artist and the singers per song both have heavy tails
+**   2) Singers per song are capped (Shape::max_singers): a song shared by
+**      k artists makes k * (k - 1) / 2 collaborations, and an uncapped
+**      tail would make the graph quadratic in its largest song
+**   3) Songs are made until the artists average Shape::songs_per_artist
+**      songs; artists no song picked then get a solo song each, so every
+**      record lists at least one song
+**   4) Artists are named "Artist <i>" and songs "Song <j>"; the same size,
+**      seed and shape always make the same catalog
+**   5) The credits are kept in memory as a CSR table, eight bytes per
+**      artist and four per credit, until written
+**
+** ChangeLog:
+**     April 2025:
+**       CatalogGenerator class created
+**/
+
+#ifndef __CATALOG_GENERATOR__
+#define __CATALOG_GENERATOR__
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class CatalogGenerator {
+
+public:
+    /* the distributions a catalog is drawn from */
+    struct Shape {
+        double artist_exponent;  // tail of artist activity (> 2)
+        double song_exponent;    // tail of singers per song (> 1)
+        uint32_t max_singers;    // most artists on one song
+        double songs_per_artist; // mean songs per artist
+
+        Shape();
+    };
+
+    CatalogGenerator(size_t num_artists, unsigned seed,
+                     const Shape &shape = Shape());
+
+    size_t num_artists() const { return offsets.size() - 1; }
+    size_t num_songs() const { return songs; }
+    size_t num_credits() const { return credits.size(); }
+
+    void write(std::ostream &out) const;
+
+private:
+    /* the songs of artist i are [offsets[i], offsets[i + 1]) of credits */
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> credits;
+    size_t songs;
+};
+
+#endif /* __CATALOG_GENERATOR__ */
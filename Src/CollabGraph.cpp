@@ -27,21 +27,53 @@
 **   
 **     April 2025:
 **       Implemented get_vertex_neighbors and report_path functions.
+**       Added freeze, which compacts the graph into a FrozenGraph.
+**       Vertices and edges are keyed by StringPool symbols.
+**       Edges keep every shared song, not just the first.
+**       print_graph ends lines without flushing.
+**       Vertices, adjacency lists and song lists come from an Arena and
+**       are released all at once.
+**       Added VertexHandle-based traversal functions; edges point at
+**       their neighbor's vertex instead of naming it.
+**       find_edge probes a hash table of vertex pairs.
 **
 **/
 
+#include <algorithm>
 #include <iostream>
 #include <stack>
 #include <vector>
 #include <unordered_map>
 #include <functional>
 #include <exception>
+#include <stdexcept>
+#include <memory>
 
+#include "Arena.h"
 #include "Artist.h"
 #include "CollabGraph.h"
 
 using namespace std;
 
+/* marks a free slot of the edge table; no two vertex ids make it */
+static const uint64_t NO_PAIR = UINT64_MAX;
+
+/* The key of the edge between two vertices, whichever comes first */
+static uint64_t pair_key(size_t id1, size_t id2)
+{
+    if (id1 > id2) swap(id1, id2);
+    return uint64_t(id1) << 32 | id2;
+}
+
+/* Spread a pair key over the table; ids are dense, so the low bits of
+ * the key alone would pile neighbors of one vertex into one run */
+static size_t pair_hash(uint64_t pair)
+{
+    pair ^= pair >> 33;
+    pair *= 0xff51afd7ed558ccdull;
+    return pair ^ (pair >> 33);
+}
+
 /*********************************************************************
  ******************** public function definitions ********************
 *********************************************************************/
@@ -57,6 +89,7 @@ using namespace std;
 * @parameters: none
 */
 CollabGraph::CollabGraph()
+    : num_edges(0)
 {
     
 }
@@ -71,6 +104,9 @@ CollabGraph::CollabGraph()
 * @preconditions: none
 * @postconditions: all heap-allocated memory associated with this CollabGraph
 *                  instace is freed
+*
+* @notes: the vertices and edges all sit in the arena, which frees them in
+*         a few calls however many there are
 */
 CollabGraph::~CollabGraph()
 {
@@ -90,6 +126,7 @@ CollabGraph::~CollabGraph()
 * @parameters: a const CollabGraph reference, to be deeply copied
 */
 CollabGraph::CollabGraph(const CollabGraph &source)
+    : num_edges(0)
 {
     *this = source;
 }
@@ -109,24 +146,45 @@ CollabGraph &CollabGraph::operator=(const CollabGraph &rhs)
 
     self_destruct();
 
-    /* ITERATING OVER AN UNORDERED_MAP:
-    * An unordered map is made up of (key, value) pairs, of type std::pair.
-    * We use a std::iterator to iterate over the entire map, which starts
-    * out as the result of the unordered_map begin() function.
-    * 
-    * Declaring iterator types in C++ is pretty complicated, so this is
-    * the one case in which our course style guide allows for the use of
-    * the "auto" keyword.
+    /* Edges keep their positions in the rows, so the edge table copies
+    * as it is */
+    edge_slots = rhs.edge_slots;
+    num_edges = rhs.num_edges;
+
+    /* The copies go in this graph's arena, each list in a block of exactly
+    * its size. Every vertex is copied before any list, so neighbors and
+    * predecessors, which point at the other graph's vertices, can be
+    * moved over by id.
     */
-    for (auto itr = rhs.graph.begin(); itr != rhs.graph.end(); itr++) {
+    vertices.reserve(rhs.vertices.size());
+    by_name.assign(rhs.by_name.size(), nullptr);
+    for (const Vertex *source : rhs.vertices) {
+        Vertex *vertexCopy = arena.allocate_array<Vertex>(1);
+        *vertexCopy = *source;
+
+        vertices.push_back(vertexCopy);
+        by_name[vertexCopy->name] = vertexCopy;
+    }
 
-        Vertex *vertexCopy = new Vertex;
-        vertexCopy->artist      = itr->second->artist;
-        vertexCopy->neighbors   = itr->second->neighbors;
-        vertexCopy->predecessor = itr->second->predecessor;
-        vertexCopy->visited     = itr->second->visited;
+    for (Vertex *vertex : vertices) {
+        if (vertex->predecessor != nullptr) {
+            vertex->predecessor = vertices[vertex->predecessor->id];
+        }
 
-        graph.insert({vertexCopy->artist.get_name(), vertexCopy});
+        Arena::Array<Edge> &neighbors = vertex->neighbors;
+        const Edge *source = neighbors.items;
+        neighbors.items = arena.allocate_array<Edge>(neighbors.count);
+        neighbors.capacity = neighbors.count;
+        for (size_t i = 0; i < neighbors.count; i++) {
+            neighbors[i] = source[i];
+            neighbors[i].neighbor = vertices[source[i].neighbor->id];
+
+            Arena::Array<Symbol> &songs = neighbors[i].songs;
+            songs.items = arena.allocate_array<Symbol>(songs.count);
+            songs.capacity = songs.count;
+            copy(source[i].songs.begin(), source[i].songs.end(),
+                 songs.items);
+        }
     }
 
     return *this;
@@ -156,18 +214,25 @@ void CollabGraph::insert_vertex(const Artist &artist)
     }
 
     /* Do not insert a vertex into the graph if that
-    * vertex already exists in the graph. The unordered_map insert
-    * function won't insert if the key already exists anyways, but since
-    * we're storing everything as vertex pointers, this makes memory
-    * management simpler.
+    * vertex already exists in the graph.
     * 
-    * Storing vertex pointers in the map rather than vertices makes keeping
-    * track of predecessors simpler.
+    * Storing vertex pointers rather than vertices makes keeping
+    * track of predecessors simpler, and the arena keeps the vertices
+    * close together.
     */
     if (not is_vertex(artist)) {
-        Vertex *vertex = new Vertex(artist);
-        /* these curly braces make an initializer list for the pair struct */
-        graph.insert({artist.get_name(), vertex});
+        Symbol name = artist.get_name_id();
+        Vertex *vertex = arena.allocate_array<Vertex>(1);
+        *vertex = Vertex();
+        vertex->name = name;
+        vertex->id = vertices.size();
+
+        vertices.push_back(vertex);
+        if (name >= by_name.size()) {
+            by_name.resize(max<size_t>(name + 1, 2 * by_name.size()),
+                           nullptr);
+        }
+        by_name[name] = vertex;
     }
 }
 
@@ -190,7 +255,10 @@ void CollabGraph::insert_vertex(const Artist &artist)
 *                connect the two provided vertices
 * returns:    none
 * 
-* notes: throws a runtime_error, if:
+* notes: if 'a1' and 'a2' are already connected, 'edgeName' is added to
+*        the songs of their edge (unless it is there already) instead of
+*        creating a second edge.
+*        throws a runtime_error, if:
 *            1) an empty string is provided as the 'edgeName', since this
 *               would violate the representation invariant that empty strings
 *               represent non-existent edges
@@ -201,8 +269,8 @@ void CollabGraph::insert_vertex(const Artist &artist)
 void CollabGraph::insert_edge(const Artist &a1, const Artist &a2,
                             const string &edgeName)
 {
-    enforce_valid_vertex(a1);
-    enforce_valid_vertex(a2);
+    Vertex *v1 = vertex_of(a1);
+    Vertex *v2 = vertex_of(a2);
 
     if (edgeName == "") {
         string message = "the empty string is not a valid edge name";
@@ -215,13 +283,41 @@ void CollabGraph::insert_edge(const Artist &a1, const Artist &a2,
         throw runtime_error(message.c_str());
     }
 
-    /* Do not insert an edge between a1 and a2 if there
-    * is already an edge that connects them.
+    /* Do not insert a second edge between a1 and a2; the song joins
+    * the songs of the edge that connects them.
     */
-    if (get_edge(a1, a2) != "") return;
+    Symbol song = Artist::symbols().intern(edgeName);
+    Edge *forward = find_edge(v1, v2);
+    if (forward != nullptr) {
+        Arena::Array<Symbol> &songs = forward->songs;
+        if (find(songs.begin(), songs.end(), song) == songs.end()) {
+            songs.push_back(arena, song);
+            find_edge(v2, v1)->songs.push_back(arena, song);
+        }
+        return;
+    }
 
-    graph.at(a1.get_name())->neighbors.push_back(Edge(a2, edgeName));
-    graph.at(a2.get_name())->neighbors.push_back(Edge(a1, edgeName));
+    if (2 * (num_edges + 1) > edge_slots.size()) {
+        rehash_edges(edge_slots.empty() ? 16 : 2 * edge_slots.size());
+    }
+
+    Vertex *lower = v1->id < v2->id ? v1 : v2;
+    Vertex *higher = v1->id < v2->id ? v2 : v1;
+    EdgeSlot &slot = edge_slots[edge_slot(pair_key(v1->id, v2->id))];
+    slot.pair = pair_key(v1->id, v2->id);
+    slot.lower_at = lower->neighbors.size();
+    slot.higher_at = higher->neighbors.size();
+    num_edges++;
+
+    Edge edge = Edge();
+    edge.neighbor = v2;
+    edge.songs.push_back(arena, song);
+    v1->neighbors.push_back(arena, edge);
+
+    edge = Edge();
+    edge.neighbor = v1;
+    edge.songs.push_back(arena, song);
+    v2->neighbors.push_back(arena, edge);
 }
 
 
@@ -236,8 +332,7 @@ void CollabGraph::insert_edge(const Artist &a1, const Artist &a2,
 */
 void CollabGraph::mark_vertex(const Artist &artist)
 {
-    enforce_valid_vertex(artist);
-    graph.at(artist.get_name())->visited = true;
+    mark_vertex(find_vertex(artist));
 }
 
 
@@ -252,8 +347,7 @@ void CollabGraph::mark_vertex(const Artist &artist)
 */
 void CollabGraph::unmark_vertex(const Artist &artist)
 {
-    enforce_valid_vertex(artist);
-    graph.at(artist.get_name())->visited = false;
+    vertex_of(artist)->visited = false;
 }
 
 
@@ -275,18 +369,7 @@ void CollabGraph::unmark_vertex(const Artist &artist)
 */
 void CollabGraph::set_predecessor(const Artist &to, const Artist &from)
 {
-    enforce_valid_vertex(to);
-    enforce_valid_vertex(from);
-
-    Vertex *vertex      = graph.at(to.get_name());
-    Vertex *pred_vertex = graph.at(from.get_name());
-
-    /* It is a mistake to set the predecessor of a vertex if it
-    * already has one.
-    */
-    if (vertex->predecessor == nullptr) {
-        vertex->predecessor = pred_vertex;
-    }
+    set_predecessor(find_vertex(to), find_vertex(from));
 }
 
 
@@ -306,13 +389,9 @@ void CollabGraph::set_predecessor(const Artist &to, const Artist &from)
 */
 void CollabGraph::clear_metadata()
 {
-    /* Again, we use the std::iterator to iterate over an unordered_map. 
-    * Whereas the graph.at() function returns just the "value", when we
-    * iterate we're getting the (key, value) pairs, so we have to 
-    * traverse to the second element in the pair to get the vertex itself. */
-    for (auto itr = graph.begin(); itr != graph.end(); itr++) {
-        itr->second->visited = false;
-        itr->second->predecessor = nullptr;
+    for (Vertex *vertex : vertices) {
+        vertex->visited = false;
+        vertex->predecessor = nullptr;
     }
 }
 
@@ -328,7 +407,7 @@ void CollabGraph::clear_metadata()
 */
 bool CollabGraph::is_vertex(const Artist &artist) const
 {
-    return graph.find(artist.get_name()) != graph.end();
+    return vertex_named(artist.get_name_id()) != nullptr;
 }
 
 
@@ -342,8 +421,7 @@ bool CollabGraph::is_vertex(const Artist &artist) const
 */
 bool CollabGraph::is_marked(const Artist &artist) const
 {
-    enforce_valid_vertex(artist);
-    return graph.at(artist.get_name())->visited;
+    return is_marked(find_vertex(artist));
 }
 
 
@@ -359,17 +437,15 @@ bool CollabGraph::is_marked(const Artist &artist) const
 */
 Artist CollabGraph::get_predecessor(const Artist &artist) const
 {
-    enforce_valid_vertex(artist);
-
     /* An artist with the empty string as its name represents a
     * non-existent artist */
     Artist pred_artist;
     
     
-    Vertex *pred_vertex = graph.at(artist.get_name())->predecessor;
+    VertexHandle pred_vertex = get_predecessor(find_vertex(artist));
 
-    if (pred_vertex != nullptr)
-        pred_artist = pred_vertex->artist;
+    if (pred_vertex.valid())
+        pred_artist = get_artist(pred_vertex);
 
     return pred_artist;
 }
@@ -387,30 +463,13 @@ Artist CollabGraph::get_predecessor(const Artist &artist) const
 */
 string CollabGraph::get_edge(const Artist &a1, const Artist &a2) const
 {
-    enforce_valid_vertex(a1);
-    enforce_valid_vertex(a2);
-
-    /* The 'neighbors' and 'edgeNames' vectors are parallel arrays.
-    *
-    * The 'index' is increased until the end of the adjacency list
-    * is reached OR a2 is found in the adjacency list.
-    */
-    vector<Edge> adj = graph.at(a1.get_name())->neighbors;
-
-    size_t idx = 0;
-    bool found = false;
-    while (not found and idx < adj.size()) {
-        if (adj[idx].neighbor == a2) {
-            found = true;
-        }
-        else idx++;
-    }
+    const Edge *edge = find_edge(vertex_of(a1), vertex_of(a2));
 
     /* If a1 and a2 are neighbors, extract the name of the edge that
     * connects them. Otherwise, 'edge' stays ""
     */
-    if (idx < adj.size()) return adj[idx].song;
-    else                  return "";
+    if (edge != nullptr) return Artist::symbols().get(edge->songs.front()).str();
+    else                 return "";
 }
 
 
@@ -425,13 +484,10 @@ string CollabGraph::get_edge(const Artist &a1, const Artist &a2) const
 */
 vector<Artist> CollabGraph::get_vertex_neighbors(const Artist &artist) const
 {
-    enforce_valid_vertex(artist);
-    
     vector<Artist> result;
-    vector<Edge> neighbors = graph.at(artist.get_name())->neighbors;
     
-    for (const Edge &edge : neighbors) {
-        result.push_back(edge.neighbor);
+    for (Neighbor neighbor : neighbors(find_vertex(artist))) {
+        result.push_back(get_artist(neighbor.vertex));
     }
     
     return result;
@@ -460,35 +516,145 @@ vector<Artist> CollabGraph::get_vertex_neighbors(const Artist &artist) const
 stack<Artist> CollabGraph::report_path(const Artist &source,
                                     const Artist &dest) const
 {
-    enforce_valid_vertex(source);
-    enforce_valid_vertex(dest);
+    VertexHandle from = find_vertex(source);
+    VertexHandle to = find_vertex(dest);
     
     stack<Artist> path;
     
     // Start from destination and work backward to source using predecessors
-    Artist current = dest;
-    path.push(current);
+    VertexHandle current = to;
+    path.push(get_artist(current));
     
-    while (current != source && current.get_name() != "") {
+    while (current != from) {
         current = get_predecessor(current);
-        if (current.get_name() != "") {
-            path.push(current);
+        if (current.valid()) {
+            path.push(get_artist(current));
         } else {
             // No valid path exists; return empty stack
             return stack<Artist>();
         }
     }
     
-    // If we didn't reach the source, return empty stack
-    if (path.top() != source) {
-        return stack<Artist>();
-    }
-    
     return path;
 }
 
 
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find_vertex
+* purpose: resolve an artist to a handle on their vertex, so a traversal
+*          looks each artist up once
+*
+* parameters: a const Artist reference, which should be in the graph
+* returns: a VertexHandle, which names the artist's vertex
+*
+* notes: throws a runtime_error if the artist is not in the graph
+*/
+CollabGraph::VertexHandle CollabGraph::find_vertex(const Artist &artist) const
+{
+    return VertexHandle(vertex_of(artist));
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* get_artist
+* purpose: make an Artist for a vertex, to hand out of the graph
+*
+* parameters: a VertexHandle, which should name a vertex in the graph
+* returns: an Artist with the vertex's name and no songs
+*/
+Artist CollabGraph::get_artist(VertexHandle vertex) const
+{
+    return Artist(Artist::symbols().get(vertex_of(vertex)->name).str());
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* neighbors
+* purpose: view the adjacency list of a vertex without copying it
+*
+* parameters: a VertexHandle, which should name a vertex in the graph
+* returns: a NeighborRange over (neighbor, first song) entries, in the
+*          order the edges were inserted
+*/
+CollabGraph::NeighborRange CollabGraph::neighbors(VertexHandle vertex) const
+{
+    const Arena::Array<Edge> &row = vertex_of(vertex)->neighbors;
+    return NeighborRange(row.begin(), row.end());
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* mark_vertex
+* purpose: mark the given vertex as visited
+*
+* parameters: a VertexHandle, which should name a vertex in the graph
+* returns:    none
+*/
+void CollabGraph::mark_vertex(VertexHandle vertex)
+{
+    vertex_of(vertex)->visited = true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* is_marked
+* purpose: determine whether the given vertex has been visited
+*
+* parameters: a VertexHandle, which should name a vertex in the graph
+* returns: a bool, true iff the vertex has been visited
+*/
+bool CollabGraph::is_marked(VertexHandle vertex) const
+{
+    return vertex_of(vertex)->visited;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* set_predecessor
+* purpose: update the predecessor of the 'to' vertex for path generation
+*
+* parameters: 1) a VertexHandle, the vertex whose predecessor is set
+*             2) a VertexHandle, the predecessor
+* returns:    none
+* note:       does nothing if 'to' already has a predecessor
+*/
+void CollabGraph::set_predecessor(VertexHandle to, VertexHandle from)
+{
+    Vertex *vertex      = vertex_of(to);
+    Vertex *pred_vertex = vertex_of(from);
+
+    /* It is a mistake to set the predecessor of a vertex if it
+    * already has one.
+    */
+    if (vertex->predecessor == nullptr) {
+        vertex->predecessor = pred_vertex;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* get_predecessor
+* purpose: retrieve the predecessor of a vertex
+*
+* parameters: a VertexHandle, which should name a vertex in the graph
+* returns:    a VertexHandle, the predecessor, or a handle that names no
+*             vertex if it has none
+*/
+CollabGraph::VertexHandle
+CollabGraph::get_predecessor(VertexHandle vertex) const
+{
+    return VertexHandle(vertex_of(vertex)->predecessor);
+}
+
+
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 * function: print_graph
 * purpose: print a representation of the information stored in the
@@ -499,21 +665,92 @@ stack<Artist> CollabGraph::report_path(const Artist &source,
 */
 void CollabGraph::print_graph(ostream &out)
 {
-    for (auto itr = graph.begin(); itr != graph.end(); itr++) {
+    for (const Vertex *vertex : vertices) {
 
-        vector<Edge> neighbors = itr->second->neighbors;
+        const Arena::Array<Edge> &neighbors = vertex->neighbors;
 
         for (size_t i = 0; i < neighbors.size(); i++) {
-            out << "\"" << itr->second->artist.get_name() << "\" "
+            out << "\"" << Artist::symbols().get(vertex->name) << "\" "
                 << "collaborated with "
-                << "\"" << neighbors.at(i).neighbor << "\" in "
-                << "\"" << neighbors.at(i).song << "\"."
-                << endl;
+                << "\"" << Artist::symbols().get(neighbors[i].neighbor->name)
+                << "\" in "
+                << "\"" << Artist::symbols().get(neighbors[i].songs.front()) << "\".\n";
         }
 
-        out << "***" << endl;
+        out << "***\n";
+    }
+
+}
+
+
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* function: freeze
+* purpose: compact the collaboration graph into compressed sparse row form
+*
+* parameters: none
+* returns: a FrozenGraph holding the same vertices and edges, where each
+*          artist's id is its insertion order and each adjacency row keeps
+*          the order its edges were inserted in
+*
+* notes: song titles are numbered in the order they are first reached
+*        while walking the rows in id order. throws a runtime_error if the
+*        graph has more edges than a 32-bit edge index can address
+*/
+FrozenGraph CollabGraph::freeze() const
+{
+    FrozenGraph frozen;
+    shared_ptr<FrozenGraph::Storage> storage(new FrozenGraph::Storage);
+    size_t num_vertices = vertices.size();
+
+    /* The vertices are kept by id, so rows come out in insertion order */
+    size_t num_entries = 0;
+    for (const Vertex *vertex : vertices) {
+        num_entries += vertex->neighbors.size();
+    }
+
+    if (num_entries >= FrozenGraph::NO_VERTEX) {
+        string message = "collaboration graph has too many edges to freeze";
+        throw runtime_error(message.c_str());
+    }
+
+    /* Interning the names in id order makes each name's symbol its id */
+    storage->names.reserve(num_vertices);
+    for (size_t v = 0; v < num_vertices; v++) {
+        storage->names.intern(Artist::symbols().get(vertices[v]->name));
     }
 
+    /* Interning the titles in row order numbers them by first appearance */
+    unordered_map<Symbol, FrozenGraph::SongId> song_ids;
+    storage->offsets.reserve(num_vertices + 1);
+    storage->offsets.push_back(0);
+    storage->targets.reserve(num_entries);
+    storage->song_offsets.reserve(num_entries + 1);
+    storage->song_offsets.push_back(0);
+    for (size_t v = 0; v < num_vertices; v++) {
+        const Arena::Array<Edge> &row = vertices[v]->neighbors;
+        for (size_t i = 0; i < row.size(); i++) {
+            for (Symbol title : row[i].songs) {
+                auto song = song_ids.find(title);
+                if (song == song_ids.end()) {
+                    FrozenGraph::SongId id = storage->titles.intern(
+                        Artist::symbols().get(title));
+                    song = song_ids.insert({title, id}).first;
+                }
+                storage->songs.push_back(song->second);
+            }
+
+            storage->targets.push_back(row[i].neighbor->id);
+            storage->song_offsets.push_back(storage->songs.size());
+        }
+        storage->offsets.push_back(storage->targets.size());
+    }
+
+    frozen.adopt(storage);
+    frozen.sorted = frozen.rows_sorted();
+    return frozen;
 }
 
 
@@ -533,14 +770,17 @@ void CollabGraph::print_graph(ostream &out)
 *
 * parameters: none
 * returns: none
+*
+* notes: the vertices and their lists need no destructors, so releasing
+*        the arena frees them all at once
 */
 void CollabGraph::self_destruct()
 {
-    for (auto itr = graph.begin(); itr != graph.end(); itr++) {
-        delete itr->second;
-    }
-
-    graph.clear();
+    vector<Vertex *>().swap(vertices);
+    vector<Vertex *>().swap(by_name);
+    vector<EdgeSlot>().swap(edge_slots);
+    num_edges = 0;
+    arena.release();
 }
 
 
@@ -562,4 +802,133 @@ void CollabGraph::enforce_valid_vertex(const Artist &artist) const
                             "\" does not exist in the collaboration graph";
         throw runtime_error(message.c_str());
     }
-}
\ No newline at end of file
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* vertex_named
+* purpose: look up the vertex of an artist by the symbol of their name
+*
+* parameters: a Symbol, the artist's name
+* returns: a Vertex pointer, or nullptr if no vertex has that name
+*/
+CollabGraph::Vertex *CollabGraph::vertex_named(Symbol name) const
+{
+    if (name >= by_name.size()) return nullptr;
+    return by_name[name];
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* vertex_of
+* purpose: look up the vertex of an artist who must be in the graph
+*
+* parameters: a const Artist reference, which should be in the graph
+* returns: a Vertex pointer, never nullptr
+*
+* notes: throws a runtime_error, as enforce_valid_vertex does, if the
+*        artist is not in the graph
+*/
+CollabGraph::Vertex *CollabGraph::vertex_of(const Artist &artist) const
+{
+    Vertex *vertex = vertex_named(artist.get_name_id());
+    if (vertex == nullptr) enforce_valid_vertex(artist);
+
+    return vertex;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* vertex_of
+* purpose: open a handle, which must name a vertex
+*
+* parameters: a VertexHandle, which should name a vertex of this graph
+* returns: a Vertex pointer, never nullptr
+*
+* notes: throws a runtime_error if the handle names no vertex; a handle
+*        of another graph cannot be told apart and must not be used
+*/
+CollabGraph::Vertex *CollabGraph::vertex_of(VertexHandle vertex) const
+{
+    if (not vertex.valid()) {
+        string message = "the vertex handle does not name a vertex";
+        throw runtime_error(message.c_str());
+    }
+
+    return vertex.vertex;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find_edge
+* purpose: find the edge from one vertex to another in the first one's
+*          adjacency list
+*
+* parameters: 1) a const Vertex pointer, a vertex in the graph
+*             2) a const Vertex pointer, another vertex in the graph
+* returns: an Edge pointer, the edge from 'a1' to 'a2', or nullptr if
+*          they are not connected
+*
+* notes: one probe of the edge table, whatever the degree of either
+*        vertex. The pointer is good until an edge is inserted at 'a1'
+*/
+CollabGraph::Edge *CollabGraph::find_edge(const Vertex *a1,
+                                          const Vertex *a2) const
+{
+    if (edge_slots.empty()) return nullptr;
+
+    const EdgeSlot &slot = edge_slots[edge_slot(pair_key(a1->id, a2->id))];
+    if (slot.pair == NO_PAIR) return nullptr;
+
+    /* the rows live in the arena, not in the vertices */
+    Edge *row = a1->neighbors.items;
+    return &row[a1->id < a2->id ? slot.lower_at : slot.higher_at];
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* edge_slot
+* purpose: find where a pair of vertices is, or would go, in the edge table
+*
+* parameters: a uint64_t, the key of the pair
+* returns: a size_t, the slot holding the pair, or the free slot where
+*          probing for it ended
+*
+* notes: the table must not be empty
+*/
+size_t CollabGraph::edge_slot(uint64_t pair) const
+{
+    size_t mask = edge_slots.size() - 1;
+    size_t i = pair_hash(pair) & mask;
+    while (edge_slots[i].pair != pair and edge_slots[i].pair != NO_PAIR) {
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* rehash_edges
+* purpose: rebuild the edge table with a new number of slots
+*
+* parameters: a size_t, the new number of slots, a power of two larger
+*             than twice the number of edges
+* returns: none
+*/
+void CollabGraph::rehash_edges(size_t num_slots)
+{
+    vector<EdgeSlot> old(num_slots);
+    old.swap(edge_slots);
+    for (EdgeSlot &slot : edge_slots) slot.pair = NO_PAIR;
+
+    for (const EdgeSlot &slot : old) {
+        if (slot.pair != NO_PAIR) edge_slots[edge_slot(slot.pair)] = slot;
+    }
+}
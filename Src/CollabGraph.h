@@ -15,6 +15,24 @@
 **   3) Non-existent edges are represented by getting a new empty string
 **   4) Artists with the empty string as their name are forbidden 
 **   5) Loops (edges from a vertex to itself) are forbidden
+**   6) An edge holds every song its two artists share: inserting an edge
+**      between artists that are already connected adds the song to it,
+**      and get_edge returns the song the edge was created with
+**   7) Vertex records, adjacency lists and song lists are all allocated
+**      from an Arena owned by the graph, and freed together with it. A
+**      vertex keeps its artist's name, not the whole Artist, so the
+**      Artists get_predecessor, get_vertex_neighbors and report_path
+**      return carry the name alone
+**   8) Traversals resolve each artist to a VertexHandle once, with
+**      find_vertex, and work on handles from then on: neighbors is a view
+**      of the adjacency list itself, and marking, predecessors and
+**      neighbor lists are reached through the handle without hashing a
+**      name or allocating. Handles stay valid until the graph is
+**      assigned to or destroyed. The Artist overloads look the artist up
+**      on every call
+**   9) Every edge is entered in a hash table keyed by its two vertices, so
+**      get_edge and the check insert_edge makes for an existing edge take
+**      expected constant time, however many collaborators either has
 **
 ** ChangeLog:
 **   17 Nov 2020: zgolds01
@@ -27,21 +45,97 @@
 **
 **       
 **     April 2025:
+**       Added freeze, which compacts the graph into a FrozenGraph.
+**       Vertices and edges are keyed by StringPool symbols.
+**       Edges keep every shared song, not just the first.
+**       Vertices and edges are allocated from an Arena; vertices are
+**       found through a table indexed by name symbol.
+**       Added VertexHandle and neighbors, for traversals that neither
+**       allocate nor hash.
+**       Edges are found through a hash table instead of a row scan.
 **/
 
 #ifndef __COLLAB_GRAPH__
 #define __COLLAB_GRAPH__
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <stack>
-#include <unordered_map>
 
+#include "Arena.h"
 #include "Artist.h"
+#include "FrozenGraph.h"
 
 class CollabGraph {
 
+private:
+    struct Vertex;
+    struct Edge;
+
 public:
+    /* names a vertex of a graph; a default handle names none */
+    class VertexHandle {
+    public:
+        VertexHandle() : vertex(nullptr) {}
+
+        bool valid() const { return vertex != nullptr; }
+        bool operator==(const VertexHandle &other) const
+        {
+            return vertex == other.vertex;
+        }
+        bool operator!=(const VertexHandle &other) const
+        {
+            return vertex != other.vertex;
+        }
+
+    private:
+        friend class CollabGraph;
+        explicit VertexHandle(Vertex *vertex) : vertex(vertex) {}
+
+        Vertex *vertex;
+    };
+
+    /* an entry of an adjacency list: the neighbor, and the song the edge
+     * was created with (a symbol in Artist::symbols()) */
+    struct Neighbor {
+        VertexHandle vertex;
+        Artist::Symbol song;
+    };
+
+    /* the adjacency list of a vertex, in insertion order, read in place;
+     * valid until an edge is inserted at that vertex */
+    class NeighborRange {
+    public:
+        class iterator {
+        public:
+            Neighbor operator*() const;
+            iterator &operator++() { ++edge; return *this; }
+            bool operator!=(const iterator &other) const
+            {
+                return edge != other.edge;
+            }
+
+        private:
+            friend class NeighborRange;
+            explicit iterator(const Edge *edge) : edge(edge) {}
+
+            const Edge *edge;
+        };
+
+        iterator begin() const { return iterator(first); }
+        iterator end() const { return iterator(last); }
+        size_t size() const { return last - first; }
+
+    private:
+        friend class CollabGraph;
+        NeighborRange(const Edge *first, const Edge *last)
+            : first(first), last(last) {}
+
+        const Edge *first;
+        const Edge *last;
+    };
+
     CollabGraph();
     ~CollabGraph();
     CollabGraph(const CollabGraph &source);
@@ -65,34 +159,76 @@ public:
     std::stack<Artist> report_path(const Artist &source,
                                 const Artist &dest) const;
 
+    VertexHandle find_vertex(const Artist &artist) const;
+    Artist get_artist(VertexHandle vertex) const;
+    NeighborRange neighbors(VertexHandle vertex) const;
+    void mark_vertex(VertexHandle vertex);
+    bool is_marked(VertexHandle vertex) const;
+    void set_predecessor(VertexHandle to, VertexHandle from);
+    VertexHandle get_predecessor(VertexHandle vertex) const;
+
     void print_graph(std::ostream &out);
 
+    FrozenGraph freeze() const;
+
 private:
 
-    struct Edge {
-        Artist neighbor;
-        std::string song;
+    typedef Artist::Symbol Symbol;
 
-        Edge(const Artist &neighbor, const std::string &song)
-            : neighbor(neighbor), song(song) {}
+    /* the neighbor, and the songs as symbols in Artist::symbols() in the
+     * order they were inserted; the songs live in the arena */
+    struct Edge {
+        Vertex *neighbor;
+        Arena::Array<Symbol> songs;
     };
 
+    /* lives in the arena, as does its adjacency list */
     struct Vertex {
-        Artist artist;
-        std::vector<Edge> neighbors;
+        Symbol name;
+        Arena::Array<Edge> neighbors;
         Vertex *predecessor;
         bool visited;
+        size_t id;     /* insertion order, used as the frozen vertex id */
+    };
 
-        Vertex(const Artist &artist) 
-            : artist(artist), predecessor(nullptr), visited(false) {}
-        Vertex() 
-            : predecessor(nullptr), visited(false) {}
+    Arena arena;
+
+    /* in insertion order, so a vertex's id is its index */
+    std::vector<Vertex *> vertices;
+
+    /* indexed by the symbol of the artist's name, nullptr for symbols
+     * that name no vertex; only as long as the largest such symbol */
+    std::vector<Vertex *> by_name;
+
+    /* where an edge sits in the rows of its two vertices */
+    struct EdgeSlot {
+        uint64_t pair;        /* lower id << 32 | higher id */
+        uint32_t lower_at;    /* position in the row of the lower id */
+        uint32_t higher_at;   /* position in the row of the higher id */
     };
 
-    std::unordered_map<std::string, Vertex*> graph;
+    /* every edge, by pair; open addressing with linear probing, kept at
+     * most half full, and free slots hold NO_PAIR */
+    std::vector<EdgeSlot> edge_slots;
+    size_t num_edges;
 
     void self_destruct();
     void enforce_valid_vertex(const Artist &artist) const;
+    Vertex *vertex_named(Symbol name) const;
+    Vertex *vertex_of(const Artist &artist) const;
+    Vertex *vertex_of(VertexHandle vertex) const;
+    Edge *find_edge(const Vertex *a1, const Vertex *a2) const;
+    size_t edge_slot(uint64_t pair) const;
+    void rehash_edges(size_t num_slots);
 };
 
+inline CollabGraph::Neighbor CollabGraph::NeighborRange::iterator::operator*()
+    const
+{
+    Neighbor entry;
+    entry.vertex = VertexHandle(edge->neighbor);
+    entry.song = edge->songs.front();
+    return entry;
+}
+
 #endif /* __COLLAB_GRAPH__ */
\ No newline at end of file
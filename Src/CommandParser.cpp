@@ -0,0 +1,173 @@
+/**
+** CommandParser.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Split a stream of command lines into whole commands (bfs, dfs, not,
+**   quit, ...) before any of them is run, so commands can be queued,
+**   executed out of order, or fed in a line at a time from a socket.
+**
+** ChangeLog:
+**     April 2025:
+**       CommandParser class created
+**       "add-artist" and "remove-artist" take one artist
+**/
+
+#include <istream>
+#include <string>
+#include <utility>
+
+#include "CommandParser.h"
+
+using namespace std;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize a CommandParser waiting for a command name
+*
+* @preconditions: none
+* @postconditions: none
+*
+* @parameters: none
+*/
+CommandParser::CommandParser()
+    : state(EXPECT_NAME)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* feed
+* purpose: consume the next line of the command stream
+*
+* parameters: 1) a const string reference, the line (without its newline)
+*             2) a Command reference, receives the command this line
+*                completes, if any
+* returns: a bool, true iff 'command' was filled with a complete command
+*
+* notes: "quit", "components", "critical", "stats" and "flush" complete on
+*        their own line, and "add-artist" and "remove-artist" after their artist's line; every
+*        other name is followed
+*        by a source and a destination line, and "not" additionally by
+*        the artists to exclude and a closing "*"
+*/
+bool CommandParser::feed(const string &line, Command &command)
+{
+    switch (state) {
+    case EXPECT_NAME:
+        if (line.empty()) return false;
+        pending.name = line;
+        if (line == "quit" or line == "components" or line == "critical" or
+            line == "stats" or line == "flush") {
+            return emit(command);
+        }
+        state = EXPECT_SOURCE;
+        return false;
+
+    case EXPECT_SOURCE:
+        /* A blank source or destination drops the command silently */
+        if (line.empty()) {
+            state = EXPECT_NAME;
+            return false;
+        }
+        pending.source = line;
+        if (pending.name == "add-artist" or pending.name == "remove-artist") {
+            return emit(command);
+        }
+        state = EXPECT_DEST;
+        return false;
+
+    case EXPECT_DEST:
+        if (line.empty()) {
+            state = EXPECT_NAME;
+            return false;
+        }
+        pending.dest = line;
+        if (pending.name != "not") return emit(command);
+        state = EXPECT_EXCLUDE;
+        return false;
+
+    case EXPECT_EXCLUDE:
+        if (line == "*") return emit(command);
+        if (not line.empty()) pending.exclude.push_back(line);
+        return false;
+    }
+
+    return false;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* finish
+* purpose: signal the end of the command stream
+*
+* parameters: a Command reference, receives a "not" command whose exclude
+*             list was cut off by the end of input
+* returns: a bool, true iff 'command' was filled
+*
+* notes: any other partial command is dropped, and the parser is ready for
+*        a new stream afterwards
+*/
+bool CommandParser::finish(Command &command)
+{
+    if (state == EXPECT_EXCLUDE) return emit(command);
+
+    state = EXPECT_NAME;
+    pending = Command();
+    return false;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* read
+* purpose: read lines from a stream until a whole command has been parsed
+*
+* parameters: 1) a std::istream reference, the command stream
+*             2) a Command reference, receives the parsed command
+* returns: a bool, true iff a command was read; false once the stream is
+*          exhausted
+*/
+bool CommandParser::read(istream &input, Command &command)
+{
+    string line;
+    while (getline(input, line)) {
+        if (feed(line, command)) return true;
+    }
+
+    return finish(command);
+}
+
+
+
+
+
+/**********************************************************************
+ ******************** private function definitions ********************
+**********************************************************************/
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* emit
+* purpose: hand the command being parsed to the caller and start over
+*
+* parameters: a Command reference, receives the pending command
+* returns: true, for convenience in feed and finish
+*/
+bool CommandParser::emit(Command &command)
+{
+    command = move(pending);
+    pending = Command();
+    state = EXPECT_NAME;
+    return true;
+}
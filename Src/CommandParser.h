@@ -0,0 +1,67 @@
+/**
+** CommandParser.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Split a stream of command lines into whole commands (bfs, dfs, not,
+**   quit, ...) before any of them is run, so commands can be queued,
+**   executed out of order, or fed in a line at a time from a socket.
+**
+** Notes:
+**   1) Lines are fed one at a time; feed returns true once the line
+**      completes a command
+**   2) Blank lines between commands are skipped, but a blank source or
+**      destination line abandons the command, exactly as the original
+**      SixDegrees::process_command did
+**   3) A "not" command runs until its "*" line; at the end of the input,
+**      finish returns a "not" command that was still collecting artists
+**   4) "quit", "components", "critical", "stats" and "flush" take no
+**      artists and complete on their own line; "add-artist" and
+**      "remove-artist" take only a source line, the artist, and "add-song"
+**      and "remove-song" an artist and a song title in place of source and
+**      destination
+**
+** ChangeLog:
+**     April 2025:
+**       CommandParser class created
+**       "add-artist" and "remove-artist" take one artist
+**       "critical" takes no artists
+**       "stats" takes no artists
+**       "flush" takes no artists
+**/
+
+#ifndef __COMMAND_PARSER__
+#define __COMMAND_PARSER__
+
+#include <istream>
+#include <string>
+#include <vector>
+
+struct Command {
+    std::string name;
+    std::string source;
+    std::string dest;
+    std::vector<std::string> exclude;
+};
+
+class CommandParser {
+
+public:
+    CommandParser();
+
+    bool feed(const std::string &line, Command &command);
+    bool finish(Command &command);
+
+    bool read(std::istream &input, Command &command);
+
+private:
+    enum State { EXPECT_NAME, EXPECT_SOURCE, EXPECT_DEST, EXPECT_EXCLUDE };
+
+    State state;
+    Command pending;
+
+    bool emit(Command &command);
+};
+
+#endif /* __COMMAND_PARSER__ */
@@ -0,0 +1,350 @@
+/**
+** ComponentIndex.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Label every artist with its connected component, and keep the labels
+**   right as artists and collaborations come and go, so disconnected
+**   artists are told apart in constant time.
+**
+** ChangeLog:
+**     April 2025:
+**       ComponentIndex class created
+**       Components are labels with member lists, so they can split
+**/
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "ComponentIndex.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+typedef ComponentIndex::ComponentId ComponentId;
+
+const ComponentId ComponentIndex::NO_COMPONENT;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an index of no vertices
+*
+* @preconditions: none
+* @postconditions: the index is empty until build or add_vertex is called
+*
+* @parameters: none
+*/
+ComponentIndex::ComponentIndex()
+    : vertices(0), epoch(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* build
+* purpose: find the connected components of a graph
+*
+* parameters: a const FrozenGraph reference, the graph; the index stays
+*             valid for it (and its copies) only
+* returns: none
+*
+* notes: unites the two ends of every edge in a union-find forest, once
+*        per edge, then gives each tree a component id. Removed artists
+*        get none
+*/
+void ComponentIndex::build(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    vector<VertexId> parent(n);
+    vector<uint32_t> size(n, 1);
+    for (VertexId v = 0; v < n; v++) parent[v] = v;
+
+    for (VertexId v = 0; v < n; v++) {
+        for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+            VertexId a = v, b = graph.edge_target(e);
+            if (b < a) continue;
+
+            for (; parent[a] != a; a = parent[a]) parent[a] = parent[parent[a]];
+            for (; parent[b] != b; b = parent[b]) parent[b] = parent[parent[b]];
+            if (a == b) continue;
+
+            if (size[a] < size[b]) swap(a, b);
+            parent[b] = a;
+            size[a] += size[b];
+        }
+    }
+
+    label.assign(n, NO_COMPONENT);
+    next.resize(n);
+    prev.resize(n);
+    head.clear();
+    count.clear();
+    free_ids.clear();
+    stamps.assign(n, 0);
+    epoch = 0;
+    vertices = 0;
+
+    for (VertexId v = 0; v < n; v++) {
+        if (graph.is_hidden(v)) continue;
+
+        VertexId root = v;
+        while (parent[root] != root) root = parent[root];
+        if (label[root] == NO_COMPONENT) {
+            new_component(root);
+        }
+        if (v != root) link(v, label[root]);
+        vertices++;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* add_vertex
+* purpose: add a vertex that is not connected to any other
+*
+* parameters: none
+* returns: a VertexId, the new vertex, numbered after every existing one
+*/
+VertexId ComponentIndex::add_vertex()
+{
+    VertexId v = label.size();
+    label.push_back(NO_COMPONENT);
+    next.push_back(v);
+    prev.push_back(v);
+    stamps.push_back(0);
+    new_component(v);
+    vertices++;
+
+    return v;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* restore_vertex
+* purpose: bring back a removed vertex, connected to no other
+*
+* parameters: a VertexId, the vertex, which was removed
+* returns: none
+*/
+void ComponentIndex::restore_vertex(VertexId v)
+{
+    new_component(v);
+    vertices++;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* remove_vertex
+* purpose: drop a vertex from the index
+*
+* parameters: a VertexId, the vertex, which must be connected to no other
+* returns: none
+*/
+void ComponentIndex::remove_vertex(VertexId v)
+{
+    unlink(v);
+    label[v] = NO_COMPONENT;
+    vertices--;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* unite
+* purpose: record that two vertices are connected
+*
+* parameters: 1) a VertexId, one end of a new edge
+*             2) a VertexId, the other end
+* returns: none
+*
+* notes: the smaller component's list is spliced into the larger one's
+*        and its vertices relabeled
+*/
+void ComponentIndex::unite(VertexId a, VertexId b)
+{
+    ComponentId keep = label[a], gone = label[b];
+    if (keep == gone) return;
+    if (count[keep] < count[gone]) swap(keep, gone);
+
+    VertexId first = head[gone];
+    VertexId v = first;
+    do {
+        label[v] = keep;
+        v = next[v];
+    } while (v != first);
+
+    VertexId keep_head = head[keep];
+    VertexId keep_tail = prev[keep_head], gone_tail = prev[first];
+    next[keep_tail] = first;
+    prev[first] = keep_tail;
+    next[gone_tail] = keep_head;
+    prev[keep_head] = gone_tail;
+
+    count[keep] += count[gone];
+    count[gone] = 0;
+    free_ids.push_back(gone);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* separate
+* purpose: record that an edge between two vertices was removed
+*
+* parameters: 1) a const FrozenGraph reference, the graph, which no longer
+*                has the edge
+*             2) a VertexId, one end of the removed edge
+*             3) a VertexId, the other end
+* returns: a bool, true if the two ends are no longer connected; the side
+*          found first then has a component of its own
+*
+* notes: see note 4 in ComponentIndex.h
+*/
+bool ComponentIndex::separate(const FrozenGraph &graph, VertexId a, VertexId b)
+{
+    if (label[a] != label[b]) return false;
+
+    if (epoch >= UINT32_MAX - 2) {
+        stamps.assign(stamps.size(), 0);
+        epoch = 0;
+    }
+    epoch += 2;
+
+    vector<VertexId> found[2] = { vector<VertexId>(1, a),
+                                  vector<VertexId>(1, b) };
+    size_t done[2] = { 0, 0 };
+    stamps[a] = epoch;
+    stamps[b] = epoch + 1;
+
+    for (int side = 0; ; side = 1 - side) {
+        vector<VertexId> &mine = found[side];
+        if (done[side] == mine.size()) {
+            /* this side is a whole component: give it a new id */
+            for (VertexId v : mine) unlink(v);
+            ComponentId c = new_component(mine[0]);
+            for (size_t i = 1; i < mine.size(); i++) link(mine[i], c);
+            return true;
+        }
+
+        VertexId v = mine[done[side]++];
+        for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+            VertexId w = graph.edge_target(e);
+            if (stamps[w] == epoch + side) continue;
+            if (stamps[w] == epoch + 1 - side) return false;
+
+            stamps[w] = epoch + side;
+            mine.push_back(w);
+        }
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* sizes
+* purpose: list how many vertices each component has
+*
+* parameters: none
+* returns: a vector of size_ts, one per component, largest first
+*/
+vector<size_t> ComponentIndex::sizes() const
+{
+    vector<size_t> result;
+    result.reserve(num_components());
+    for (ComponentId c = 0; c < count.size(); c++) {
+        if (count[c] > 0) result.push_back(count[c]);
+    }
+    sort(result.begin(), result.end(), greater<size_t>());
+
+    return result;
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* new_component
+* purpose: put a vertex in a component of its own
+*
+* parameters: a VertexId, the vertex, which is in no component
+* returns: a ComponentId, the new component, reusing a freed id if any
+*/
+ComponentId ComponentIndex::new_component(VertexId v)
+{
+    ComponentId c;
+    if (free_ids.empty()) {
+        c = head.size();
+        head.push_back(v);
+        count.push_back(1);
+    } else {
+        c = free_ids.back();
+        free_ids.pop_back();
+        head[c] = v;
+        count[c] = 1;
+    }
+    label[v] = c;
+    next[v] = prev[v] = v;
+
+    return c;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* unlink
+* purpose: take a vertex off its component's list
+*
+* parameters: a VertexId, the vertex
+* returns: none
+*
+* notes: a component left with no vertices gives up its id
+*/
+void ComponentIndex::unlink(VertexId v)
+{
+    ComponentId c = label[v];
+    if (--count[c] == 0) {
+        free_ids.push_back(c);
+        return;
+    }
+
+    next[prev[v]] = next[v];
+    prev[next[v]] = prev[v];
+    if (head[c] == v) head[c] = next[v];
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* link
+* purpose: add a vertex to a component's list
+*
+* parameters: 1) a VertexId, the vertex, on no list
+*             2) a ComponentId, a component with at least one vertex
+* returns: none
+*/
+void ComponentIndex::link(VertexId v, ComponentId c)
+{
+    VertexId first = head[c];
+    next[v] = next[first];
+    prev[v] = first;
+    prev[next[first]] = v;
+    next[first] = v;
+    count[c]++;
+    label[v] = c;
+}
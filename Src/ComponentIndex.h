@@ -0,0 +1,100 @@
+/**
+** ComponentIndex.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Label every artist with the connected component it belongs to, so
+**   whether two artists are connected at all is answered in constant
+**   time, without exploring the source's whole component first.
+**
+** Notes:
+**   1) Every artist carries its component's id, and every component keeps
+**      its artists on a circular list threaded through two per-artist
+**      arrays, so a lookup is one array read
+**   2) build finds the components with a union-find (disjoint set) forest
+**      united by size, then numbers them and lays out their lists
+**   3) add_vertex and unite follow artists and collaborations as they are
+**      added; unite relabels the smaller of the two components, so an
+**      artist is relabeled O(log n) times as components grow
+**   4) separate follows a collaboration being removed: a search is grown
+**      from each end, one artist at a time each, until they meet (still
+**      connected) or one runs out, having found the whole of a component
+**      that split off, which is then relabeled. The cost is in proportion
+**      to the smaller side, unless the two ends are far apart
+**   5) Removed artists have no component; an artist must have lost all
+**      its collaborations before it is removed
+**   6) Lookups never change the index, so any number of threads may read
+**      it at once; everything else needs the index to itself
+**
+** ChangeLog:
+**     April 2025:
+**       ComponentIndex class created
+**       Components are labels with member lists, so they can split
+**/
+
+#ifndef __COMPONENT_INDEX__
+#define __COMPONENT_INDEX__
+
+#include <cstdint>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class ComponentIndex {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef FrozenGraph::VertexId ComponentId;
+
+    /* the component of a removed artist */
+    static const ComponentId NO_COMPONENT = UINT32_MAX;
+
+    ComponentIndex();
+
+    void build(const FrozenGraph &graph);
+
+    VertexId add_vertex();
+    void restore_vertex(VertexId v);
+    void remove_vertex(VertexId v);
+    void unite(VertexId a, VertexId b);
+    bool separate(const FrozenGraph &graph, VertexId a, VertexId b);
+
+    ComponentId component(VertexId v) const { return label[v]; }
+    bool connected(VertexId a, VertexId b) const
+    {
+        return label[a] == label[b];
+    }
+
+    size_t num_vertices() const { return vertices; }
+    size_t num_components() const { return count.size() - free_ids.size(); }
+    size_t component_size(VertexId v) const { return count[label[v]]; }
+
+    std::vector<size_t> sizes() const;
+
+private:
+    /* the component of every vertex */
+    std::vector<ComponentId> label;
+
+    /* each component's vertices, on a circular list through next/prev */
+    std::vector<VertexId> next;
+    std::vector<VertexId> prev;
+
+    /* a vertex of each component and how many it has (0 for unused ids) */
+    std::vector<VertexId> head;
+    std::vector<uint32_t> count;
+    std::vector<ComponentId> free_ids;
+
+    size_t vertices;
+
+    /* search state for separate; a vertex reached from one end is stamped
+     * with 'epoch', from the other with epoch + 1 */
+    std::vector<uint32_t> stamps;
+    uint32_t epoch;
+
+    ComponentId new_component(VertexId v);
+    void unlink(VertexId v);
+    void link(VertexId v, ComponentId c);
+};
+
+#endif /* __COMPONENT_INDEX__ */
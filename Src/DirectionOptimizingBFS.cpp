@@ -0,0 +1,277 @@
+/**
+** DirectionOptimizingBFS.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Single-source breadth-first search over a FrozenGraph that switches
+**   between top-down steps (the frontier looks for unvisited neighbors)
+**   and bottom-up steps (unvisited vertices look for a neighbor in the
+**   frontier), after Beamer, Asanovic and Patterson. Frontiers and the
+**   visited set are bitsets.
+**
+** ChangeLog:
+**     April 2025:
+**       DirectionOptimizingBFS class created
+**/
+
+#include <algorithm>
+#include <stack>
+#include <vector>
+
+#include "DirectionOptimizingBFS.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+const uint32_t BfsTree::UNREACHED;
+const unsigned DirectionOptimizingBFS::ALPHA;
+const unsigned DirectionOptimizingBFS::BETA;
+
+/*********************************************************************
+ ******************** helper function definitions ********************
+*********************************************************************/
+
+namespace {
+
+inline bool test_bit(const vector<uint64_t> &bits, VertexId v)
+{
+    return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+inline void set_bit(vector<uint64_t> &bits, VertexId v)
+{
+    bits[v >> 6] |= uint64_t(1) << (v & 63);
+}
+
+/* index of the lowest set bit of a non-zero word */
+inline unsigned lowest_bit(uint64_t word)
+{
+    return __builtin_ctzll(word);
+}
+
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* path_to
+* purpose: read the path from the tree's source to a vertex off the parents
+*
+* parameters: a VertexId, the destination
+* returns: a stack of VertexIds with the source on top and 'dest' at the
+*          bottom, or an empty stack if the search did not reach 'dest'
+*/
+stack<VertexId> BfsTree::path_to(VertexId dest) const
+{
+    stack<VertexId> path;
+    if (not reaches(dest)) return path;
+
+    for (VertexId v = dest; v != source; v = parent[v]) {
+        path.push(v);
+    }
+    path.push(source);
+
+    return path;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: prepare a search engine for a graph
+*
+* @preconditions: the graph outlives the engine and is not changed while
+*                 the engine is in use
+* @postconditions: none
+*
+* @parameters: a const FrozenGraph reference, the graph to search
+*/
+DirectionOptimizingBFS::DirectionOptimizingBFS(const FrozenGraph &graph)
+    : graph(graph), top_down(0), bottom_up(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* search
+* purpose: breadth-first search from a source, filling a BfsTree
+*
+* parameters: 1) a VertexId, the source
+*             2) a BfsTree reference, receives the distance and parent of
+*                every vertex reached
+*             3) a VertexId, a vertex to stop at (NO_VERTEX to sweep the
+*                whole component); the search stops after the level that
+*                reaches it, so vertices further out stay UNREACHED
+*             4) a const vector<VertexId> reference, vertices the search may
+*                not enter (the source is never excluded)
+* returns: none
+*/
+void DirectionOptimizingBFS::search(VertexId source, BfsTree &tree,
+                                    VertexId stop_at,
+                                    const vector<VertexId> &exclude)
+{
+    size_t n = graph.num_vertices();
+    size_t words = (n + 63) / 64;
+
+    tree.source = source;
+    tree.distance.assign(n, BfsTree::UNREACHED);
+    tree.parent.assign(n, FrozenGraph::NO_VERTEX);
+    frontier.assign(words, 0);
+    next.assign(words, 0);
+    visited.assign(words, 0);
+    top_down = bottom_up = 0;
+
+    /* Edges not yet reached from the frontier; excluded vertices are
+     * treated as already visited and their edges as already explored */
+    uint64_t unexplored_edges = 2 * graph.num_edges();
+    for (VertexId v : exclude) {
+        if (v == source or test_bit(visited, v)) continue;
+        set_bit(visited, v);
+        unexplored_edges -= graph.degree(v);
+    }
+
+    set_bit(frontier, source);
+    set_bit(visited, source);
+    tree.distance[source] = 0;
+    size_t frontier_size = 1;
+    uint64_t frontier_edges = graph.degree(source);
+    unexplored_edges -= frontier_edges;
+
+    bool going_up = false;
+    for (uint32_t depth = 1; frontier_size > 0; depth++) {
+        if (stop_at != FrozenGraph::NO_VERTEX and test_bit(visited, stop_at)) {
+            break;
+        }
+
+        if (not going_up and frontier_edges > unexplored_edges / ALPHA) {
+            going_up = true;
+        } else if (going_up and frontier_size < n / BETA) {
+            going_up = false;
+        }
+
+        uint64_t next_edges = 0;
+        fill(next.begin(), next.end(), 0);
+        if (going_up) {
+            frontier_size = step_bottom_up(tree, depth, next_edges);
+            bottom_up++;
+        } else {
+            frontier_size = step_top_down(tree, depth, next_edges);
+            top_down++;
+        }
+
+        frontier.swap(next);
+        frontier_edges = next_edges;
+        unexplored_edges -= next_edges;
+    }
+}
+
+
+
+
+
+/**********************************************************************
+ ******************** private function definitions ********************
+**********************************************************************/
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* step_top_down
+* purpose: extend the search by one level from the frontier outwards
+*
+* parameters: 1) a BfsTree reference, the tree being built
+*             2) a uint32_t, the distance of the level being discovered
+*             3) a uint64_t reference, receives the total degree of the
+*                vertices discovered
+* returns: a size_t, the number of vertices discovered (now in 'next')
+*/
+size_t DirectionOptimizingBFS::step_top_down(BfsTree &tree, uint32_t depth,
+                                             uint64_t &next_edges)
+{
+    size_t discovered = 0;
+
+    for (size_t w = 0; w < frontier.size(); w++) {
+        for (uint64_t word = frontier[w]; word != 0; word &= word - 1) {
+            VertexId current = (w << 6) + lowest_bit(word);
+
+            for (EdgeId e = graph.edge_begin(current);
+                 e < graph.edge_end(current); e++) {
+                VertexId neighbor = graph.edge_target(e);
+                if (test_bit(visited, neighbor)) continue;
+
+                set_bit(visited, neighbor);
+                set_bit(next, neighbor);
+                tree.distance[neighbor] = depth;
+                tree.parent[neighbor] = current;
+                next_edges += graph.degree(neighbor);
+                discovered++;
+            }
+        }
+    }
+
+    return discovered;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* step_bottom_up
+* purpose: extend the search by one level by having every unvisited vertex
+*          look for a parent in the frontier
+*
+* parameters: 1) a BfsTree reference, the tree being built
+*             2) a uint32_t, the distance of the level being discovered
+*             3) a uint64_t reference, receives the total degree of the
+*                vertices discovered
+* returns: a size_t, the number of vertices discovered (now in 'next')
+*
+* notes: a vertex stops scanning its neighbors at the first one in the
+*        frontier, which is what saves work over a top-down step
+*/
+size_t DirectionOptimizingBFS::step_bottom_up(BfsTree &tree, uint32_t depth,
+                                              uint64_t &next_edges)
+{
+    size_t n = graph.num_vertices();
+    size_t discovered = 0;
+
+    for (size_t w = 0; w < visited.size(); w++) {
+        uint64_t unvisited = ~visited[w];
+        if (w == visited.size() - 1 and n % 64 != 0) {
+            unvisited &= (uint64_t(1) << (n % 64)) - 1;
+        }
+
+        for (; unvisited != 0; unvisited &= unvisited - 1) {
+            VertexId current = (w << 6) + lowest_bit(unvisited);
+
+            for (EdgeId e = graph.edge_begin(current);
+                 e < graph.edge_end(current); e++) {
+                VertexId neighbor = graph.edge_target(e);
+                if (not test_bit(frontier, neighbor)) continue;
+
+                set_bit(next, current);
+                tree.distance[current] = depth;
+                tree.parent[current] = neighbor;
+                next_edges += graph.degree(current);
+                discovered++;
+                break;
+            }
+        }
+
+        /* Fold this word's discoveries into the visited set in one go */
+        visited[w] |= next[w];
+    }
+
+    return discovered;
+}
@@ -0,0 +1,87 @@
+/**
+** DirectionOptimizingBFS.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Single-source breadth-first search over a FrozenGraph that switches
+**   between top-down steps (the frontier looks for unvisited neighbors)
+**   and bottom-up steps (unvisited vertices look for a neighbor in the
+**   frontier), after Beamer, Asanovic and Patterson. Frontiers and the
+**   visited set are bitsets. The result is a BfsTree: the hop distance
+**   and BFS parent of every vertex, for whole-graph analytics or to read
+**   off a single path.
+**
+** Notes:
+**   1) A step goes bottom-up once the edges leaving the frontier exceed
+**      1/ALPHA of the edges still unexplored, and back to top-down once
+**      the frontier holds fewer than 1/BETA of the vertices
+**   2) Results are deterministic: top-down steps scan the frontier in id
+**      order, bottom-up steps take the first frontier neighbor in
+**      adjacency order. Parents (and so paths) can differ from the
+**      classic queue-based search when there are ties
+**   3) The engine keeps its bitsets between searches; one engine should be
+**      used by one thread at a time
+**
+** ChangeLog:
+**     April 2025:
+**       DirectionOptimizingBFS class created
+**/
+
+#ifndef __DIRECTION_OPTIMIZING_BFS__
+#define __DIRECTION_OPTIMIZING_BFS__
+
+#include <cstdint>
+#include <stack>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+struct BfsTree {
+    typedef FrozenGraph::VertexId VertexId;
+
+    /* distance of vertices the search did not reach */
+    static const uint32_t UNREACHED = UINT32_MAX;
+
+    VertexId source;
+    std::vector<uint32_t> distance;
+    std::vector<VertexId> parent;
+
+    BfsTree() : source(FrozenGraph::NO_VERTEX) {}
+
+    bool reaches(VertexId v) const { return distance[v] != UNREACHED; }
+    std::stack<VertexId> path_to(VertexId dest) const;
+};
+
+class DirectionOptimizingBFS {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+
+    static const unsigned ALPHA = 15;
+    static const unsigned BETA  = 18;
+
+    explicit DirectionOptimizingBFS(const FrozenGraph &graph);
+
+    void search(VertexId source, BfsTree &tree,
+                VertexId stop_at = FrozenGraph::NO_VERTEX,
+                const std::vector<VertexId> &exclude = std::vector<VertexId>());
+
+    unsigned top_down_steps() const { return top_down; }
+    unsigned bottom_up_steps() const { return bottom_up; }
+
+private:
+    const FrozenGraph &graph;
+
+    std::vector<uint64_t> frontier;
+    std::vector<uint64_t> next;
+    std::vector<uint64_t> visited;
+
+    unsigned top_down;
+    unsigned bottom_up;
+
+    size_t step_top_down(BfsTree &tree, uint32_t depth, uint64_t &next_edges);
+    size_t step_bottom_up(BfsTree &tree, uint32_t depth, uint64_t &next_edges);
+};
+
+#endif /* __DIRECTION_OPTIMIZING_BFS__ */
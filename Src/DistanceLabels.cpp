@@ -0,0 +1,311 @@
+/**
+** DistanceLabels.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   An exact distance index built by pruned landmark labeling, so the
+**   distance between two artists (and a shortest path between them) is
+**   read off two short labels instead of found by a search.
+**
+** ChangeLog:
+**     April 2025:
+**       DistanceLabels class created
+**/
+
+#include <algorithm>
+#include <memory>
+#include <stack>
+#include <vector>
+
+#include "DistanceLabels.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+const uint32_t DistanceLabels::UNREACHED;
+
+/* The offsets of labels for no vertices */
+static const uint64_t EMPTY_OFFSETS[1] = { 0 };
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an index with no labels
+*
+* @preconditions: none
+* @postconditions: the index is empty until build is called
+*
+* @parameters: none
+*/
+DistanceLabels::DistanceLabels()
+    : offsets(EMPTY_OFFSETS), hubs(nullptr), distances(nullptr),
+      parents(nullptr), count(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* build
+* purpose: label every vertex of a graph by pruned breadth-first searches
+*
+* parameters: a const FrozenGraph reference, the graph; the labels stay
+*             valid for it (and its copies) only
+* returns: none
+*
+* notes: the search from the hub of rank r stops at a vertex v, without
+*        labelling or expanding it, when the labels of hubs ranked before
+*        r already give a path from the hub to v no longer than this one.
+*        The hub's own label is spread into a table indexed by rank
+*        first, so that test is one pass over v's label
+*/
+void DistanceLabels::build(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+
+    /* Hubs by degree, highest first, ties by id */
+    vector<VertexId> order(n);
+    for (VertexId v = 0; v < n; v++) order[v] = v;
+    stable_sort(order.begin(), order.end(),
+                [&graph](VertexId a, VertexId b) {
+                    return graph.degree(a) > graph.degree(b);
+                });
+
+    struct Entry {
+        uint32_t hub;
+        uint32_t distance;
+        VertexId parent;
+    };
+    vector<vector<Entry>> labels(n);
+
+    vector<uint32_t> hub_distance(n, UNREACHED);  // by rank, of this hub
+    vector<uint32_t> reached(n, UNREACHED);       // by vertex, this search
+    vector<VertexId> parent(n);
+    vector<VertexId> visited;
+    visited.reserve(n);
+
+    for (uint32_t rank = 0; rank < n; rank++) {
+        VertexId hub = order[rank];
+        for (const Entry &entry : labels[hub]) {
+            hub_distance[entry.hub] = entry.distance;
+        }
+
+        visited.clear();
+        visited.push_back(hub);
+        reached[hub] = 0;
+        parent[hub] = hub;
+        for (size_t head = 0; head < visited.size(); head++) {
+            VertexId v = visited[head];
+            uint32_t d = reached[v];
+
+            bool covered = false;
+            for (const Entry &entry : labels[v]) {
+                uint32_t via = hub_distance[entry.hub];
+                if (via != UNREACHED and via + entry.distance <= d) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) continue;
+
+            Entry entry = { rank, d, parent[v] };
+            labels[v].push_back(entry);
+            for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+                VertexId w = graph.edge_target(e);
+                if (reached[w] == UNREACHED) {
+                    reached[w] = d + 1;
+                    parent[w] = v;
+                    visited.push_back(w);
+                }
+            }
+        }
+
+        for (VertexId v : visited) reached[v] = UNREACHED;
+        for (const Entry &entry : labels[hub]) {
+            hub_distance[entry.hub] = UNREACHED;
+        }
+    }
+
+    /* Lay the labels out back to back */
+    shared_ptr<Storage> storage(new Storage);
+    storage->offsets.resize(n + 1);
+    storage->offsets[0] = 0;
+    for (VertexId v = 0; v < n; v++) {
+        storage->offsets[v + 1] = storage->offsets[v] + labels[v].size();
+    }
+    uint64_t total = storage->offsets[n];
+    storage->hubs.reserve(total);
+    storage->distances.reserve(total);
+    storage->parents.reserve(total);
+    for (VertexId v = 0; v < n; v++) {
+        for (const Entry &entry : labels[v]) {
+            storage->hubs.push_back(entry.hub);
+            storage->distances.push_back(entry.distance);
+            storage->parents.push_back(entry.parent);
+        }
+        vector<Entry>().swap(labels[v]);
+    }
+
+    adopt(storage);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* distance
+* purpose: find the exact distance between two vertices
+*
+* parameters: 1) a VertexId, one vertex of the graph the labels were built for
+*             2) a VertexId, another vertex
+* returns: a uint32_t, the number of hops on a shortest path between them,
+*          or UNREACHED if they are not connected
+*/
+uint32_t DistanceLabels::distance(VertexId s, VertexId t) const
+{
+    if (s == t) return 0;
+
+    uint64_t at_s, at_t;
+    if (not closest_hub(s, t, at_s, at_t)) return UNREACHED;
+
+    return distances[at_s] + distances[at_t];
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* path
+* purpose: rebuild a shortest path between two vertices from the labels
+*
+* parameters: 1) a VertexId, the source
+*             2) a VertexId, the destination
+* returns: a stack of VertexIds with the source on top and the destination
+*          at the bottom, or an empty stack if they are not connected
+*
+* notes: walks the parent hints from each end to the hub the two labels
+*        meet at; each step is a binary search of one label
+*/
+stack<VertexId> DistanceLabels::path(VertexId s, VertexId t) const
+{
+    stack<VertexId> path;
+    if (s == t) {
+        path.push(s);
+        return path;
+    }
+
+    uint64_t at_s, at_t;
+    if (not closest_hub(s, t, at_s, at_t)) return path;
+    uint32_t hub = hubs[at_s];
+
+    /* from the destination up to (not including) the hub */
+    VertexId v = t;
+    while (distances[at_t] > 0) {
+        path.push(v);
+        v = parents[at_t];
+        at_t = find_hub(v, hub);
+    }
+
+    /* then the hub and on down to the source */
+    vector<VertexId> source_side;
+    for (v = s; distances[at_s] > 0; at_s = find_hub(v, hub)) {
+        source_side.push_back(v);
+        v = parents[at_s];
+    }
+    source_side.push_back(v);
+    for (size_t k = source_side.size(); k-- > 0; ) {
+        path.push(source_side[k]);
+    }
+
+    return path;
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* closest_hub
+* purpose: find the hub two labels share that is nearest to both
+*
+* parameters: 1) a VertexId, the first vertex
+*             2) a VertexId, the second vertex
+*             3) a uint64_t reference, set to the hub's entry in the first
+*                label
+*             4) a uint64_t reference, set to the hub's entry in the second
+*                label
+* returns: a bool, false if the labels share no hub (the vertices are not
+*          connected), in which case the entries are not set
+*/
+bool DistanceLabels::closest_hub(VertexId s, VertexId t,
+                                 uint64_t &at_s, uint64_t &at_t) const
+{
+    uint64_t i = offsets[s], end_i = offsets[s + 1];
+    uint64_t j = offsets[t], end_j = offsets[t + 1];
+    uint32_t best = UNREACHED;
+    while (i < end_i and j < end_j) {
+        if (hubs[i] < hubs[j]) {
+            i++;
+        } else if (hubs[j] < hubs[i]) {
+            j++;
+        } else {
+            uint32_t sum = distances[i] + distances[j];
+            if (sum < best) {
+                best = sum;
+                at_s = i;
+                at_t = j;
+            }
+            i++;
+            j++;
+        }
+    }
+
+    return best != UNREACHED;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find_hub
+* purpose: find a hub's entry in a vertex's label
+*
+* parameters: 1) a VertexId, the vertex
+*             2) a uint32_t, the rank of a hub its label is known to list
+* returns: a uint64_t, the position of the entry
+*/
+uint64_t DistanceLabels::find_hub(VertexId v, uint32_t hub) const
+{
+    return lower_bound(hubs + offsets[v], hubs + offsets[v + 1], hub) - hubs;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* adopt
+* purpose: take over the arrays of labels built in memory and point the
+*          tables at them
+*
+* parameters: a const shared_ptr<Storage> reference, the filled-in arrays,
+*             which are not changed after this
+* returns: none
+*/
+void DistanceLabels::adopt(const shared_ptr<Storage> &storage)
+{
+    offsets = storage->offsets.data();
+    hubs = storage->hubs.data();
+    distances = storage->distances.data();
+    parents = storage->parents.data();
+    count = storage->offsets.size() - 1;
+    backing = storage;
+}
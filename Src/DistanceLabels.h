@@ -0,0 +1,95 @@
+/**
+** DistanceLabels.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   An exact distance index built by pruned landmark labeling. Every
+**   artist gets a label: a short list of hub artists with its distance to
+**   each. Any two artists share a hub on some shortest path between them
+**   (the 2-hop cover property), so their distance is the smallest sum of
+**   distances over the hubs their labels share, found by merging two
+**   short sorted lists instead of searching the graph.
+**
+** Notes:
+**   1) Hubs are ranked by degree, highest first, and labels are built by
+**      one breadth-first search per hub in rank order. A search stops at
+**      every artist whose distance the labels built so far already give,
+**      so later searches are tiny and labels stay short on graphs with
+**      well-connected hubs
+**   2) Each label lists its hubs by rank, ascending, so two labels are
+**      merged in one pass
+**   3) Next to each (hub, distance) entry the label keeps a parent hint:
+**      the neighbor one hop nearer the hub. The neighbor has an entry for
+**      the same hub, so following hints walks a shortest path to the hub,
+**      and path rebuilds a whole shortest path without a search
+**   4) Like FrozenGraph, the tables are flat arrays over a shared backing
+**      block: vectors for labels built in memory, or a snapshot mapping
+**      (GraphSnapshot stores them alongside the graph)
+**   5) Read-only once built, so any number of threads can query it; it
+**      knows nothing of excluded artists
+**
+** ChangeLog:
+**     April 2025:
+**       DistanceLabels class created
+**/
+
+#ifndef __DISTANCE_LABELS__
+#define __DISTANCE_LABELS__
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class DistanceLabels {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+
+    /* distance between artists that are not connected */
+    static const uint32_t UNREACHED = UINT32_MAX;
+
+    DistanceLabels();
+
+    void build(const FrozenGraph &graph);
+
+    /* labels are for a graph of this many vertices; 0 until built */
+    size_t num_vertices() const { return count; }
+    size_t num_entries() const { return offsets[count]; }
+    bool   empty() const { return count == 0; }
+
+    uint32_t distance(VertexId s, VertexId t) const;
+    std::stack<VertexId> path(VertexId s, VertexId t) const;
+
+private:
+    friend class GraphSnapshot;
+
+    /* The arrays of labels built in memory */
+    struct Storage {
+        std::vector<uint64_t> offsets;
+        std::vector<uint32_t> hubs;
+        std::vector<uint32_t> distances;
+        std::vector<VertexId> parents;
+    };
+
+    /* keeps whatever the pointers below point into alive */
+    std::shared_ptr<const void> backing;
+
+    /* the label of v is [offsets[v], offsets[v + 1]) of the arrays below:
+     * hub ranks (ascending), distances to those hubs, and parent hints */
+    const uint64_t *offsets;
+    const uint32_t *hubs;
+    const uint32_t *distances;
+    const VertexId *parents;
+    size_t count;
+
+    bool closest_hub(VertexId s, VertexId t,
+                     uint64_t &at_s, uint64_t &at_t) const;
+    uint64_t find_hub(VertexId v, uint32_t hub) const;
+    void adopt(const std::shared_ptr<Storage> &storage);
+};
+
+#endif /* __DISTANCE_LABELS__ */
@@ -0,0 +1,320 @@
+/**
+** FrozenGraph.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Represent a finished collaboration graph in compressed sparse row
+**   (CSR) form. Every artist gets a dense integer id, every song title a
+**   dense integer id, and the adjacency lists of all artists live back to
+**   back in one contiguous array. Traversals work on ids alone, so a step
+**   from one artist to the next never hashes a name or copies an Artist.
+**
+** ChangeLog:
+**     April 2025:
+**       FrozenGraph class created
+**       Moved visited marks and predecessors out to TraversalContext
+**       Tables became views over a shared backing block, so a graph can
+**       be served straight from a memory-mapped snapshot
+**       Names and titles became StringPool symbol tables
+**       Edges carry every shared song instead of only the first
+**       print_graph ends lines without flushing
+**       get_edge scans the shorter of the two rows
+**       find_edge binary-searches sorted rows
+**/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+using namespace std;
+
+const FrozenGraph::VertexId FrozenGraph::NO_VERTEX;
+const FrozenGraph::EdgeId FrozenGraph::NO_EDGE;
+
+static_assert(FrozenGraph::NO_VERTEX == StringPool::NO_SYMBOL,
+              "find_vertex passes the name table's misses straight through");
+
+/* The tables of a graph with no vertices */
+static const FrozenGraph::EdgeId EMPTY_OFFSETS[1] = { 0 };
+static const uint64_t EMPTY_STARTS[1] = { 0 };
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an empty FrozenGraph instance
+*
+* @preconditions: none
+* @postconditions: the graph has no vertices and no edges
+*
+* @parameters: none
+*/
+FrozenGraph::FrozenGraph()
+    : offsets(EMPTY_OFFSETS), ends(EMPTY_OFFSETS + 1), targets(nullptr),
+      song_offsets(EMPTY_OFFSETS), songs(nullptr), num_entries(0),
+      hidden(nullptr), sorted(true)
+{
+    names.starts = titles.starts = EMPTY_STARTS;
+    names.chars = titles.chars = "";
+    names.slots = titles.slots = nullptr;
+    names.num_slots = titles.num_slots = 0;
+    names.count = titles.count = 0;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* num_vertices
+* purpose: count the artists in the graph
+*
+* parameters: none
+* returns: a size_t, the number of vertices, counting removed artists
+*/
+size_t FrozenGraph::num_vertices() const
+{
+    return names.count;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* num_edges
+* purpose: count the collaborations in the graph
+*
+* parameters: none
+* returns: a size_t, the number of undirected edges
+*/
+size_t FrozenGraph::num_edges() const
+{
+    return num_entries / 2;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* num_songs
+* purpose: count the distinct song titles on the graph's edges
+*
+* parameters: none
+* returns: a size_t, the number of song ids
+*/
+size_t FrozenGraph::num_songs() const
+{
+    return titles.count;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find_vertex
+* purpose: look up the id of an artist by name
+*
+* parameters: a const StringRef reference, the name of the artist
+* returns: a VertexId, the id of the artist, or NO_VERTEX if no artist in
+*          the graph has that name (or the artist was removed)
+*
+* notes: one probe of the name table's hash index, which works the same
+*        on a graph in memory and on a mapped snapshot
+*/
+FrozenGraph::VertexId FrozenGraph::find_vertex(const StringRef &name) const
+{
+    VertexId v = names.find(name);
+    if (v != NO_VERTEX and is_hidden(v)) return NO_VERTEX;
+
+    return v;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* is_vertex
+* purpose: determine whether an artist is in the graph
+*
+* parameters: a const StringRef reference, the name of the artist
+* returns: a bool, true iff an artist with that name is in the graph
+*/
+bool FrozenGraph::is_vertex(const StringRef &name) const
+{
+    return find_vertex(name) != NO_VERTEX;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* get_name
+* purpose: retrieve the name of the artist with the given id
+*
+* parameters: a VertexId, which should be a vertex in the graph
+* returns: a StringRef, the name of the artist, valid while any copy of
+*          this graph exists
+*/
+StringRef FrozenGraph::get_name(VertexId v) const
+{
+    if (v >= names.count) throw out_of_range("FrozenGraph::get_name");
+    return names.get(v);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* get_song
+* purpose: retrieve the title of the song with the given id
+*
+* parameters: a SongId, as returned by edge_song
+* returns: a StringRef, the title of the song, valid while any copy of
+*          this graph exists
+*/
+StringRef FrozenGraph::get_song(SongId song) const
+{
+    if (song >= titles.count) throw out_of_range("FrozenGraph::get_song");
+    return titles.get(song);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* get_edge
+* purpose: retrieve the edge between two vertices
+*
+* parameters: 1) a VertexId, which should be a vertex in the graph
+*             2) a VertexId, which should be a vertex in the graph
+* returns:    a StringRef, the first song connecting 'a1' and 'a2', or the
+*             empty string if there is no edge connecting them
+*
+* notes: the edge is looked up in the shorter of the two rows, so a hop
+*        from a hub to an artist with few collaborators costs little even
+*        when the rows are not sorted
+*/
+StringRef FrozenGraph::get_edge(VertexId a1, VertexId a2) const
+{
+    EdgeId e = degree(a1) <= degree(a2) ? find_edge(a1, a2)
+                                        : find_edge(a2, a1);
+    if (e == NO_EDGE) return StringRef();
+
+    return titles.get(edge_song(e));
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find_edge
+* purpose: find the edge between two vertices
+*
+* parameters: 1) a VertexId, which should be a vertex in the graph
+*             2) a VertexId, which should be a vertex in the graph
+* returns:    an EdgeId, the edge from 'a1' to 'a2' in the row of 'a1', or
+*             NO_EDGE if there is no edge connecting them
+*
+* notes: binary-searches the row of 'a1' if rows are sorted, and scans it
+*        otherwise; the entry in the row of 'a2' carries the same songs,
+*        so callers may pass the vertex of lower degree first
+*/
+FrozenGraph::EdgeId FrozenGraph::find_edge(VertexId a1, VertexId a2) const
+{
+    const VertexId *first = targets + edge_begin(a1);
+    const VertexId *last = targets + edge_end(a1);
+    if (sorted) {
+        const VertexId *found = lower_bound(first, last, a2);
+        if (found != last and *found == a2) return found - targets;
+        return NO_EDGE;
+    }
+
+    for (const VertexId *target = first; target != last; target++) {
+        if (*target == a2) return target - targets;
+    }
+
+    return NO_EDGE;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* function: print_graph
+* purpose: print a representation of the information stored in the graph,
+*          in the same format as CollabGraph::print_graph
+*
+* parameters: a ostream reference, where output is sent
+* returns: none
+*/
+void FrozenGraph::print_graph(ostream &out) const
+{
+    for (VertexId v = 0; v < names.count; v++) {
+        if (is_hidden(v)) continue;
+
+        for (EdgeId e = edge_begin(v); e < edge_end(v); e++) {
+            out << "\"" << names.get(v) << "\" "
+                << "collaborated with "
+                << "\"" << names.get(targets[e]) << "\" in "
+                << "\"" << titles.get(edge_song(e)) << "\".\n";
+        }
+
+        out << "***\n";
+    }
+}
+
+
+
+
+
+/**********************************************************************
+ ******************** private function definitions ********************
+**********************************************************************/
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* adopt
+* purpose: take over the arrays of a graph built in memory and point the
+*          tables at them
+*
+* parameters: a const shared_ptr<Storage> reference, the filled-in arrays,
+*             which are not changed after this
+* returns: none
+*/
+void FrozenGraph::adopt(const shared_ptr<Storage> &storage)
+{
+    offsets = storage->offsets.data();
+    ends = storage->ends.empty() ? offsets + 1 : storage->ends.data();
+    targets = storage->targets.data();
+    song_offsets = storage->song_offsets.data();
+    songs = storage->songs.data();
+    num_entries = storage->targets.size();
+    hidden = storage->hidden.empty() ? nullptr : storage->hidden.data();
+    names = storage->names.view();
+    titles = storage->titles.view();
+    sorted = storage->sorted;
+    backing = storage;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* rows_sorted
+* purpose: check whether every row lists its neighbors in increasing id
+*          order, for find_edge
+*
+* parameters: none
+* returns: a bool, true if they all do
+*
+* notes: O(E); run once on a graph just built or loaded. A GraphEditor
+*        sorts every row when it takes a graph over, and keeps them sorted
+*/
+bool FrozenGraph::rows_sorted() const
+{
+    for (VertexId v = 0; v < names.count; v++) {
+        for (EdgeId e = edge_begin(v) + 1; e < edge_end(v); e++) {
+            if (targets[e - 1] >= targets[e]) return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,220 @@
+/**
+** FrozenGraph.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Represent a finished collaboration graph in compressed sparse row
+**   (CSR) form. Every artist gets a dense integer id, every song title a
+**   dense integer id, and the adjacency lists of all artists live back to
+**   back in one contiguous array. Traversals work on ids alone, so a step
+**   from one artist to the next never hashes a name or copies an Artist.
+**
+** Notes:
+**   1) Built by CollabGraph::freeze or GraphBuilder::freeze, or loaded by
+**      GraphSnapshot::load; only a GraphEditor can change it afterwards
+**   2) Vertex ids follow the order artists were inserted into the
+**      CollabGraph, and each adjacency row keeps the CollabGraph edge order,
+**      unless VertexOrder::relabel has renumbered the artists; each row is
+**      then sorted by neighbor id
+**   3) The graph is undirected: every edge is stored once in each row
+**   4) Edge e of vertex v is in [edge_begin(v), edge_end(v)); its
+**      neighbor is edge_target(e). An edge carries every song its two
+**      artists share, [edge_songs_begin(e), edge_songs_end(e)), and
+**      edge_song(e) is the first of them, the one paths are printed with.
+**      neighbors(v) walks the same row as (neighbor, edge) entries
+**   5) Traversal state lives in a TraversalContext, never in the graph,
+**      so a FrozenGraph can be searched by several queries at once
+**   6) Every table is a flat array reached through a plain pointer. The
+**      arrays belong to a shared backing block: vectors for a graph built
+**      in memory, a read-only file mapping for a loaded snapshot. Copies
+**      of a FrozenGraph share the block, which lives until the last copy
+**      is gone
+**   7) The name and title tables are StringPool symbol tables: a vertex
+**      id is its name's symbol and a song id its title's symbol, and
+**      find_vertex is one hash probe. Names and titles are StringRefs into
+**      the backing block
+**   8) A graph a GraphEditor has changed keeps its rows apart from their
+**      ends: a changed row is rewritten after all the others, and the old
+**      one is left unused. A rewritten row holds its neighbors in id
+**      order. Removed artists keep their ids but are hidden: find_vertex no
+**      longer finds them and they have no edges
+**   9) find_edge binary-searches a row when every row holds its
+**      neighbors in id order, as a graph built from a catalog naming each
+**      artist once does, and scans it otherwise; whether they all do is
+**      worked out once, when the graph is built or loaded, and a
+**      GraphEditor sorts every row when it takes the graph over
+**
+** ChangeLog:
+**     April 2025:
+**       FrozenGraph class created
+**       Moved visited marks and predecessors out to TraversalContext
+**       Tables became views over a shared backing block, so a graph can
+**       be served straight from a memory-mapped snapshot
+**       Names and titles became StringPool symbol tables
+**       Edges carry every shared song instead of only the first
+**       Rows can be rewritten in place by a GraphEditor, and artists
+**       hidden
+**       Added neighbors, a view of a row for range-based loops
+**       Artists can be renumbered by a VertexOrder
+**       find_edge binary-searches sorted rows
+**/
+
+#ifndef __FROZEN_GRAPH__
+#define __FROZEN_GRAPH__
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "StringPool.h"
+#include "StringRef.h"
+
+class FrozenGraph {
+
+public:
+    typedef uint32_t VertexId;
+    typedef uint32_t SongId;
+    typedef uint32_t EdgeId;
+
+    /* id returned by find_vertex for artists not in the graph */
+    static const VertexId NO_VERTEX = UINT32_MAX;
+
+    /* edge returned by find_edge for artists that are not connected */
+    static const EdgeId NO_EDGE = UINT32_MAX;
+
+    FrozenGraph();
+
+    size_t num_vertices() const;
+    size_t num_edges() const;
+    size_t num_songs() const;
+
+    VertexId find_vertex(const StringRef &name) const;
+    bool is_vertex(const StringRef &name) const;
+    StringRef get_name(VertexId v) const;
+    StringRef get_song(SongId song) const;
+    StringRef get_edge(VertexId a1, VertexId a2) const;
+    EdgeId find_edge(VertexId a1, VertexId a2) const;
+
+    EdgeId   edge_begin(VertexId v) const { return offsets[v]; }
+    EdgeId   edge_end(VertexId v)   const { return ends[v]; }
+    VertexId edge_target(EdgeId e)  const { return targets[e]; }
+    SongId   edge_song(EdgeId e)    const { return songs[song_offsets[e]]; }
+    EdgeId   degree(VertexId v)     const { return ends[v] - offsets[v]; }
+
+    /* an entry of a row: the neighbor, and the edge to it, which
+     * edge_song reads the song of only if it is wanted */
+    struct Neighbor {
+        VertexId vertex;
+        EdgeId edge;
+    };
+
+    /* a row, read in place */
+    class NeighborRange {
+    public:
+        class iterator {
+        public:
+            Neighbor operator*() const
+            {
+                Neighbor entry = { targets[edge], edge };
+                return entry;
+            }
+            iterator &operator++() { ++edge; return *this; }
+            bool operator!=(const iterator &other) const
+            {
+                return edge != other.edge;
+            }
+
+        private:
+            friend class NeighborRange;
+            iterator(const VertexId *targets, EdgeId edge)
+                : targets(targets), edge(edge) {}
+
+            const VertexId *targets;
+            EdgeId edge;
+        };
+
+        iterator begin() const { return iterator(targets, first); }
+        iterator end() const { return iterator(targets, last); }
+        size_t size() const { return last - first; }
+
+    private:
+        friend class FrozenGraph;
+        NeighborRange(const VertexId *targets, EdgeId first, EdgeId last)
+            : targets(targets), first(first), last(last) {}
+
+        const VertexId *targets;
+        EdgeId first;
+        EdgeId last;
+    };
+
+    NeighborRange neighbors(VertexId v) const
+    {
+        return NeighborRange(targets, offsets[v], ends[v]);
+    }
+
+    bool is_hidden(VertexId v) const { return hidden != nullptr and hidden[v]; }
+
+    const SongId *edge_songs_begin(EdgeId e) const
+    {
+        return songs + song_offsets[e];
+    }
+    const SongId *edge_songs_end(EdgeId e) const
+    {
+        return songs + song_offsets[e + 1];
+    }
+
+    void print_graph(std::ostream &out) const;
+
+private:
+    friend class CollabGraph;
+    friend class GraphBuilder;
+    friend class GraphEditor;
+    friend class GraphSnapshot;
+    friend class VertexOrder;
+
+    /* The arrays of a graph built in memory; 'ends' and 'hidden' stay
+     * empty until a GraphEditor needs them */
+    struct Storage {
+        std::vector<EdgeId>   offsets;
+        std::vector<EdgeId>   ends;
+        std::vector<uint8_t>  hidden;
+        std::vector<VertexId> targets;
+        std::vector<uint32_t> song_offsets;
+        std::vector<SongId>   songs;
+        StringPool            names;
+        StringPool            titles;
+        bool                  sorted = false;   /* see 'sorted' below */
+    };
+
+    /* keeps whatever the pointers below point into alive */
+    std::shared_ptr<const void> backing;
+
+    /* CSR adjacency: row v is [offsets[v], ends[v]) of 'targets'
+     * (neighbor ids), and the songs of edge e are [song_offsets[e],
+     * song_offsets[e + 1]) of 'songs' (song ids). Unless the graph has
+     * been edited, rows are back to back and 'ends' is offsets + 1 */
+    const EdgeId   *offsets;
+    const EdgeId   *ends;
+    const VertexId *targets;
+    const uint32_t *song_offsets;
+    const SongId   *songs;
+    size_t num_entries;     /* in use, two per edge */
+
+    /* nonzero for removed artists; null if there are none */
+    const uint8_t *hidden;
+
+    /* true if every row lists its neighbors in increasing id order */
+    bool sorted;
+
+    /* vertex and song tables; only names can be looked up */
+    StringPool::View names;
+    StringPool::View titles;
+
+    void adopt(const std::shared_ptr<Storage> &storage);
+    bool rows_sorted() const;
+};
+
+#endif /* __FROZEN_GRAPH__ */
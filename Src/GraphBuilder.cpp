@@ -0,0 +1,234 @@
+/**
+** GraphBuilder.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Build a FrozenGraph straight from names and song titles, without
+**   going through CollabGraph's Artist-keyed vertices.
+**
+** ChangeLog:
+**     April 2025:
+**       GraphBuilder class created
+**       Names and songs are interned in StringPools
+**       Repeated pairs add their songs to the pair's edge
+**/
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GraphBuilder.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::SongId SongId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* reserve
+* purpose: make room for a number of artists and songs up front
+*
+* parameters: 1) a size_t, how many distinct artists are coming
+*             2) a size_t, how many distinct songs are coming (optional)
+* returns: none
+*/
+void GraphBuilder::reserve(size_t num_vertices, size_t num_songs)
+{
+    names.reserve(num_vertices);
+    if (num_songs > 0) songs.reserve(num_songs);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert_vertex
+* purpose: add an artist to the graph
+*
+* parameters: a const StringRef reference, the name of the artist
+* returns: a VertexId, the artist's id; an artist inserted before keeps
+*          the id it was given then
+*
+* notes: throws a runtime_error if the name is empty, as
+*        CollabGraph::insert_vertex does
+*/
+VertexId GraphBuilder::insert_vertex(const StringRef &name)
+{
+    if (name.empty()) {
+        string message = "cannot insert an artist with an empty name";
+        throw runtime_error(message.c_str());
+    }
+
+    if (names.size() >= FrozenGraph::NO_VERTEX) {
+        string message = "collaboration graph has too many artists";
+        throw runtime_error(message.c_str());
+    }
+
+    return names.intern(name);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert_song
+* purpose: get the label of a song title to hand to insert_edge
+*
+* parameters: a const StringRef reference, the song title
+* returns: a Symbol, the song's label; the same title always gets the same
+*          label
+*
+* notes: throws a runtime_error if the title is empty, as
+*        CollabGraph::insert_edge does
+*/
+GraphBuilder::Symbol GraphBuilder::insert_song(const StringRef &song)
+{
+    if (song.empty()) {
+        string message = "the empty string is not a valid edge name";
+        throw runtime_error(message.c_str());
+    }
+
+    return songs.intern(song);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert_edge
+* purpose: connect two artists with a song
+*
+* parameters: 1) a VertexId, as returned by insert_vertex
+*             2) a VertexId, a different artist
+*             3) a Symbol, the song they share, as returned by insert_song
+* returns: none
+*
+* notes: if the two artists are already connected, the song is added to
+*        the songs of their first edge when the graph is frozen. throws a runtime_error for an edge from an
+*        artist to itself, as CollabGraph::insert_edge does
+*/
+void GraphBuilder::insert_edge(VertexId a1, VertexId a2, Symbol song)
+{
+    if (a1 == a2) {
+        string message = "cannot insert an edge between a "
+                            "vertex and itself";
+        throw runtime_error(message.c_str());
+    }
+
+    edges.push_back({a1, a2, song});
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* freeze
+* purpose: lay the graph out in compressed sparse row form
+*
+* parameters: none
+* returns: a FrozenGraph with the inserted vertices and edges (see the
+*          header for the order everything comes out in)
+*
+* notes: throws a runtime_error if the graph has more edges than a 32-bit
+*        edge index can address
+*/
+FrozenGraph GraphBuilder::freeze() const
+{
+    size_t n = names.size();
+    size_t m = edges.size();
+    if (2 * m >= FrozenGraph::NO_VERTEX) {
+        string message = "collaboration graph has too many edges to freeze";
+        throw runtime_error(message.c_str());
+    }
+
+    /* Bucket the edges by endpoint; within a row they stay in insertion
+     * order, as CollabGraph appends them */
+    vector<EdgeId> start(n + 1, 0);
+    for (const Edge &edge : edges) {
+        start[edge.a1 + 1]++;
+        start[edge.a2 + 1]++;
+    }
+    for (size_t v = 0; v < n; v++) start[v + 1] += start[v];
+
+    vector<uint32_t> row_edges(2 * m);
+    vector<EdgeId> fill(start.begin(), start.end() - 1);
+    for (size_t k = 0; k < m; k++) {
+        row_edges[fill[edges[k].a1]++] = k;
+        row_edges[fill[edges[k].a2]++] = k;
+    }
+
+    /* A repeated pair shows up as a neighbor seen twice in one row. The
+     * earlier edge is kept, as CollabGraph keeps it, and each later one
+     * is chained behind it so its song joins the kept edge's songs */
+    const uint32_t NO_EDGE = FrozenGraph::NO_EDGE;
+    vector<bool> dropped(m, false);
+    vector<uint32_t> next_song(m, NO_EDGE);
+    vector<uint32_t> last_song(m, NO_EDGE);
+    vector<VertexId> seen_from(n, FrozenGraph::NO_VERTEX);
+    vector<uint32_t> kept_edge(n, NO_EDGE);
+    for (VertexId v = 0; v < n; v++) {
+        for (EdgeId slot = start[v]; slot < start[v + 1]; slot++) {
+            uint32_t k = row_edges[slot];
+            if (dropped[k]) continue;
+            VertexId other = edges[k].a1 == v ? edges[k].a2 : edges[k].a1;
+            if (seen_from[other] == v) {
+                uint32_t kept = kept_edge[other];
+                dropped[k] = true;
+                next_song[last_song[kept]] = k;
+                last_song[kept] = k;
+            } else {
+                seen_from[other] = v;
+                kept_edge[other] = k;
+                last_song[k] = k;
+            }
+        }
+    }
+
+    FrozenGraph frozen;
+    shared_ptr<FrozenGraph::Storage> storage(new FrozenGraph::Storage);
+
+    storage->names = names;
+
+    /* Number the songs by first appearance in row order; a song repeated
+     * on one pair is listed once */
+    const SongId NO_SONG = FrozenGraph::NO_VERTEX;
+    vector<SongId> song_ids(songs.size(), NO_SONG);
+    vector<uint32_t> listed_at(songs.size(), NO_EDGE);
+    storage->offsets.reserve(n + 1);
+    storage->offsets.push_back(0);
+    storage->targets.reserve(2 * m);
+    storage->song_offsets.reserve(2 * m + 1);
+    storage->song_offsets.push_back(0);
+    storage->songs.reserve(2 * m);
+    for (VertexId v = 0; v < n; v++) {
+        for (EdgeId slot = start[v]; slot < start[v + 1]; slot++) {
+            uint32_t k = row_edges[slot];
+            if (dropped[k]) continue;
+
+            uint32_t entry = storage->targets.size();
+            for (uint32_t c = k; c != NO_EDGE; c = next_song[c]) {
+                Symbol label = edges[c].song;
+                if (listed_at[label] == entry) continue;
+                listed_at[label] = entry;
+
+                if (song_ids[label] == NO_SONG) {
+                    song_ids[label] = storage->titles.intern(songs.get(label));
+                }
+                storage->songs.push_back(song_ids[label]);
+            }
+
+            const Edge &edge = edges[k];
+            storage->targets.push_back(edge.a1 == v ? edge.a2 : edge.a1);
+            storage->song_offsets.push_back(storage->songs.size());
+        }
+        storage->offsets.push_back(storage->targets.size());
+    }
+
+    frozen.adopt(storage);
+    frozen.sorted = frozen.rows_sorted();
+    return frozen;
+}
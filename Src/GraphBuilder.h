@@ -0,0 +1,69 @@
+/**
+** GraphBuilder.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Build a FrozenGraph straight from names and song titles, without
+**   going through CollabGraph's Artist-keyed vertices. Vertices and edges
+**   are recorded as ids and StringPool symbols, and freeze lays them out in
+**   CSR form in one pass over the edge list.
+**
+** Notes:
+**   1) Produces exactly the FrozenGraph that inserting the same vertices
+**      and edges into a CollabGraph and freezing it would: vertex ids in
+**      insertion order, rows in edge insertion order, later edges
+**      between the same artists adding their songs to the first, and song
+**      ids numbered by first appearance while walking the rows in id order
+**   2) Names and titles are interned as they come in, so a StringRef
+**      handed to the builder only needs to live for the call. A name's
+**      symbol is its vertex id; insert_song hands out label symbols that
+**      freeze renumbers into song ids
+**
+** ChangeLog:
+**     April 2025:
+**       GraphBuilder class created
+**       Names and songs are interned in StringPools
+**       Repeated pairs add their songs to the pair's edge
+**       The label symbols' titles can be read back
+**/
+
+#ifndef __GRAPH_BUILDER__
+#define __GRAPH_BUILDER__
+
+#include <vector>
+
+#include "FrozenGraph.h"
+#include "StringPool.h"
+#include "StringRef.h"
+
+class GraphBuilder {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef StringPool::Symbol Symbol;
+
+    void reserve(size_t num_vertices, size_t num_songs = 0);
+
+    VertexId insert_vertex(const StringRef &name);
+    Symbol insert_song(const StringRef &song);
+    void insert_edge(VertexId a1, VertexId a2, Symbol song);
+
+    size_t num_vertices() const { return names.size(); }
+    const StringPool &song_labels() const { return songs; }
+
+    FrozenGraph freeze() const;
+
+private:
+    struct Edge {
+        VertexId a1;
+        VertexId a2;
+        Symbol song;
+    };
+
+    StringPool names;
+    StringPool songs;
+    std::vector<Edge> edges;
+};
+
+#endif /* __GRAPH_BUILDER__ */
@@ -0,0 +1,368 @@
+/**
+** GraphEditor.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Change a FrozenGraph in place, one artist or one collaboration at a
+**   time, rewriting only the rows the change touches.
+**
+** ChangeLog:
+**     April 2025:
+**       GraphEditor class created
+**/
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GraphEditor.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::SongId SongId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: GraphEditor constructor
+* @purpose: initialize an editor for a graph
+*
+* @preconditions: nothing else edits the graph while the editor is in use
+* @postconditions: the graph reads its arrays from the editor's copy, with
+*                  every row back to back and sorted by neighbor id
+*
+* @parameters: a FrozenGraph reference, the graph to edit; it must outlive
+*              the editor
+*/
+GraphEditor::GraphEditor(FrozenGraph &graph)
+    : graph(graph), storage(pack_rows(graph)), live_entries(graph.num_entries)
+{
+    if (graph.hidden != nullptr) {
+        storage->hidden.assign(graph.hidden, graph.hidden + graph.num_vertices());
+    }
+    storage->names = StringPool(graph.names);
+    storage->titles = StringPool(graph.titles);
+
+    publish();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert_vertex
+* purpose: add an artist with no collaborations to the graph
+*
+* parameters: a const StringRef reference, the name of the artist, who
+*             must not be in the graph already
+* returns: a VertexId, the artist's id: the next unused one, or the id the
+*          artist had before being removed
+*/
+VertexId GraphEditor::insert_vertex(const StringRef &name)
+{
+    own();
+
+    VertexId v = storage->names.find(name);
+    if (v != FrozenGraph::NO_VERTEX) {
+        storage->hidden[v] = 0;
+    } else {
+        v = storage->names.intern(name);
+        storage->offsets.back() = storage->targets.size();
+        storage->offsets.push_back(storage->targets.size());
+        storage->ends.push_back(storage->targets.size());
+        if (not storage->hidden.empty()) storage->hidden.push_back(0);
+    }
+
+    publish();
+    return v;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* remove_vertex
+* purpose: hide an artist, so it can no longer be found
+*
+* parameters: a VertexId, the artist; its collaborations must have been
+*             removed already
+* returns: none
+*/
+void GraphEditor::remove_vertex(VertexId v)
+{
+    own();
+
+    if (storage->hidden.empty()) storage->hidden.assign(graph.num_vertices(), 0);
+    storage->hidden[v] = 1;
+
+    publish();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert_song
+* purpose: add a song title to the graph's title table
+*
+* parameters: a const StringRef reference, the title
+* returns: a SongId, the title's id, the same as before if it is already
+*          in the table
+*/
+SongId GraphEditor::insert_song(const StringRef &title)
+{
+    own();
+
+    SongId song = storage->titles.intern(title);
+
+    publish();
+    return song;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* set_songs
+* purpose: set the songs two artists share, adding or removing their
+*          collaboration as needed
+*
+* parameters: 1) a VertexId, one artist
+*             2) a VertexId, another artist
+*             3) a const vector of SongIds reference, the songs they share,
+*                first one printed first; empty if they no longer share any
+* returns: none
+*
+* notes: throws a runtime_error if the graph would outgrow its 32-bit
+*        edge ids; the graph is unchanged then. Once the entries left
+*        behind by rewritten rows outnumber the ones in use, every row is
+*        packed back to back again, so the arrays stay within twice the
+*        size of the graph and an edit costs amortized O(degree) time
+*/
+void GraphEditor::set_songs(VertexId a, VertexId b, const vector<SongId> &songs)
+{
+    own();
+
+    size_t used = storage->targets.size() + graph.degree(a) + graph.degree(b) + 2;
+    size_t listed = storage->songs.size() + 2 * songs.size();
+    for (EdgeId e = graph.edge_begin(a); e < graph.edge_end(a); e++) {
+        listed += graph.edge_songs_end(e) - graph.edge_songs_begin(e);
+    }
+    for (EdgeId e = graph.edge_begin(b); e < graph.edge_end(b); e++) {
+        listed += graph.edge_songs_end(e) - graph.edge_songs_begin(e);
+    }
+    if (used >= FrozenGraph::NO_EDGE or listed >= UINT32_MAX) {
+        string message = "collaboration graph has too many edges to edit";
+        throw runtime_error(message.c_str());
+    }
+
+    bool existed = graph.find_edge(a, b) != FrozenGraph::NO_EDGE;
+    const vector<SongId> *replacement = songs.empty() ? nullptr : &songs;
+    rewrite_row(a, b, replacement);
+    rewrite_row(b, a, replacement);
+
+    if (existed and songs.empty()) live_entries -= 2;
+    if (not existed and not songs.empty()) live_entries += 2;
+
+    publish();
+    if (storage->targets.size() - live_entries > live_entries) compact();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* stored_entries
+* purpose: count the adjacency entries the editor's arrays hold
+*
+* parameters: none
+* returns: a size_t, the entries in use plus the ones rewritten rows left
+*          behind
+*/
+size_t GraphEditor::stored_entries() const
+{
+    return storage->targets.size();
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* own
+* purpose: copy the arrays if another FrozenGraph still shares them
+*
+* parameters: none
+* returns: none
+*
+* notes: the editor and the graph being edited hold two references
+*/
+void GraphEditor::own()
+{
+    if (storage.use_count() > 2) {
+        storage = make_shared<Storage>(*storage);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* pack_rows
+* purpose: copy the rows of a graph back to back into new arrays, each
+*          sorted by neighbor id, as rewrite_row needs them
+*
+* parameters: a const FrozenGraph reference, the graph
+* returns: a shared_ptr to a Storage, the rows and their songs; its names,
+*          titles and hidden marks are left empty
+*
+* notes: a graph whose rows are all sorted already is copied as it is; the
+*        rows of one built from a catalog that names an artist in two
+*        records are not, and are sorted here
+*/
+shared_ptr<FrozenGraph::Storage> GraphEditor::pack_rows(const FrozenGraph &graph)
+{
+    shared_ptr<Storage> packed(new Storage);
+    size_t n = graph.num_vertices();
+    packed->offsets.reserve(n + 1);
+    packed->ends.reserve(n);
+    packed->targets.reserve(graph.num_entries);
+    packed->song_offsets.reserve(graph.num_entries + 1);
+    packed->song_offsets.push_back(0);
+
+    /* (neighbor, edge) for every entry of the row being copied */
+    vector<pair<VertexId, EdgeId>> row;
+    for (VertexId v = 0; v < n; v++) {
+        row.clear();
+        for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+            row.push_back(make_pair(graph.edge_target(e), e));
+        }
+        if (not graph.sorted) sort(row.begin(), row.end());
+
+        packed->offsets.push_back(packed->targets.size());
+        for (const pair<VertexId, EdgeId> &entry : row) {
+            packed->targets.push_back(entry.first);
+            packed->songs.insert(packed->songs.end(),
+                                 graph.edge_songs_begin(entry.second),
+                                 graph.edge_songs_end(entry.second));
+            packed->song_offsets.push_back(packed->songs.size());
+        }
+        packed->ends.push_back(packed->targets.size());
+    }
+    packed->offsets.push_back(packed->targets.size());
+    packed->sorted = true;
+
+    return packed;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* compact
+* purpose: drop the entries rewritten rows left behind, packing every row
+*          back to back again
+*
+* parameters: none
+* returns: none
+*
+* notes: the arrays must not be shared (see own); names, titles and hidden
+*        marks are moved over, not copied. O(V + E)
+*/
+void GraphEditor::compact()
+{
+    shared_ptr<Storage> packed = pack_rows(graph);
+    packed->hidden.swap(storage->hidden);
+    packed->names = move(storage->names);
+    packed->titles = move(storage->titles);
+    storage = packed;
+
+    publish();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* rewrite_row
+* purpose: write a row out again after every other, with one neighbor's
+*          entry replaced
+*
+* parameters: 1) a VertexId, the vertex whose row it is
+*             2) a VertexId, the neighbor to replace
+*             3) a const vector of SongIds pointer, the songs of the new
+*                entry, or null to leave the neighbor out
+* returns: none
+*
+* notes: the row must be sorted by neighbor id, as pack_rows leaves every
+*        row; the new one is too
+*/
+void GraphEditor::rewrite_row(VertexId v, VertexId w, const vector<SongId> *songs)
+{
+    EdgeId begin = storage->offsets[v], end = storage->ends[v];
+    EdgeId start = storage->targets.size();
+
+    bool placed = false;
+    for (EdgeId e = begin; e < end; e++) {
+        VertexId u = storage->targets[e];
+        if (not placed and u >= w) {
+            if (songs != nullptr) {
+                append_entry(w, songs->data(), songs->data() + songs->size());
+            }
+            placed = true;
+            if (u == w) continue;
+        }
+
+        /* the arrays may move as they grow, so copy out of them by index */
+        uint32_t first = storage->song_offsets[e];
+        uint32_t last = storage->song_offsets[e + 1];
+        storage->targets.push_back(u);
+        for (uint32_t i = first; i < last; i++) {
+            SongId song = storage->songs[i];
+            storage->songs.push_back(song);
+        }
+        storage->song_offsets.push_back(storage->songs.size());
+    }
+    if (not placed and songs != nullptr) {
+        append_entry(w, songs->data(), songs->data() + songs->size());
+    }
+
+    storage->offsets[v] = start;
+    storage->ends[v] = storage->targets.size();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* append_entry
+* purpose: add an adjacency entry after every other
+*
+* parameters: 1) a VertexId, the neighbor
+*             2) a const SongId pointer, the first of the edge's songs
+*             3) a const SongId pointer, one past the last
+* returns: none
+*/
+void GraphEditor::append_entry(VertexId target, const SongId *first,
+                               const SongId *last)
+{
+    storage->targets.push_back(target);
+    storage->songs.insert(storage->songs.end(), first, last);
+    storage->song_offsets.push_back(storage->songs.size());
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* publish
+* purpose: point the graph at the editor's arrays after a change
+*
+* parameters: none
+* returns: none
+*/
+void GraphEditor::publish()
+{
+    graph.adopt(storage);
+    graph.num_entries = live_entries;
+}
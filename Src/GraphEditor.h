@@ -0,0 +1,79 @@
+/**
+** GraphEditor.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Change a FrozenGraph in place, one artist or one collaboration at a
+**   time, so a catalog update costs time in proportion to the rows it
+**   touches instead of a rebuild of the whole graph.
+**
+** Notes:
+**   1) The editor takes over the graph's arrays when it is created,
+**      copying them (row by row, leaving out unused space) into vectors
+**      it owns; a graph served from a mapped snapshot is brought into
+**      memory this way. Rows are sorted by neighbor id as they are
+**      copied, since edits merge into sorted rows
+**   2) A changed row is written out again after all the others and the
+**      graph pointed at the new copy; the old one is left unused. Once
+**      unused entries outnumber the ones in use, every row is packed back
+**      to back again, so a long run of edits takes about twice the space
+**      of the graph it leaves at most
+**   3) A rewritten row lists its neighbors in id order, as a graph built
+**      from the same catalog does, so searches break ties the same way.
+**      A catalog that names an artist in two records builds rows out of
+**      order; once the editor has sorted them, ties may be broken
+**      differently than before
+**   4) Removed artists keep their id and name, hidden, and get both back
+**      if they are inserted again
+**   5) If anything else still holds a copy of the graph, the next edit
+**      copies the arrays first, so the copy never sees a change
+**   6) Edits must not run while the graph is being searched
+**
+** ChangeLog:
+**     April 2025:
+**       GraphEditor class created
+**/
+
+#ifndef __GRAPH_EDITOR__
+#define __GRAPH_EDITOR__
+
+#include <memory>
+#include <vector>
+
+#include "FrozenGraph.h"
+#include "StringRef.h"
+
+class GraphEditor {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef FrozenGraph::SongId SongId;
+    typedef FrozenGraph::EdgeId EdgeId;
+
+    explicit GraphEditor(FrozenGraph &graph);
+
+    VertexId insert_vertex(const StringRef &name);
+    void remove_vertex(VertexId v);
+
+    SongId insert_song(const StringRef &title);
+    void set_songs(VertexId a, VertexId b, const std::vector<SongId> &songs);
+
+    size_t stored_entries() const;
+
+private:
+    typedef FrozenGraph::Storage Storage;
+
+    FrozenGraph &graph;
+    std::shared_ptr<Storage> storage;
+    size_t live_entries;
+
+    static std::shared_ptr<Storage> pack_rows(const FrozenGraph &graph);
+    void own();
+    void compact();
+    void rewrite_row(VertexId v, VertexId w, const std::vector<SongId> *songs);
+    void append_entry(VertexId target, const SongId *first, const SongId *last);
+    void publish();
+};
+
+#endif /* __GRAPH_EDITOR__ */
@@ -0,0 +1,414 @@
+/**
+** GraphSnapshot.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Save a FrozenGraph to a binary snapshot file and load it back by
+**   memory-mapping the file, so a loaded graph is served straight out of
+**   the page cache without being parsed or copied.
+**
+** ChangeLog:
+**     April 2025:
+**       GraphSnapshot class created
+**       Version 2: the sorted name index became the name probe table
+**       Version 3: every edge carries its list of shared songs
+**       Version 4: distance labels can be stored alongside the graph
+**       Edited graphs are compacted before they are saved
+**/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GraphBuilder.h"
+#include "GraphSnapshot.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::SongId SongId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+const uint32_t GraphSnapshot::VERSION;
+
+/*********************************************************************
+ ******************** helper function definitions ********************
+*********************************************************************/
+
+namespace {
+
+const char MAGIC[8] = { 'S', 'I', 'X', 'D', 'E', 'G', 'S', '\n' };
+
+/* written as-is; reads back differently on a machine of the other order */
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/* The sections of a snapshot, in file order */
+enum Section {
+    OFFSETS, TARGETS, SONG_OFFSETS, SONGS,
+    NAME_STARTS, NAME_CHARS, NAME_SLOTS,
+    TITLE_STARTS, TITLE_CHARS,
+    LABEL_OFFSETS, LABEL_HUBS, LABEL_DISTANCES, LABEL_PARENTS,
+    NUM_SECTIONS
+};
+
+struct SectionEntry {
+    uint64_t offset;    // from the start of the file, a multiple of 8
+    uint64_t size;      // in bytes, not counting padding
+};
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_vertices;
+    uint64_t num_entries;   // adjacency entries, two per edge
+    uint64_t num_titles;
+    uint64_t file_size;
+    uint64_t checksum;      // of every byte after the header
+    SectionEntry sections[NUM_SECTIONS];
+};
+
+inline uint64_t padded(uint64_t size)
+{
+    return (size + 7) & ~uint64_t(7);
+}
+
+/* 64-bit FNV-1a taken a word at a time, so it keeps up with the disk */
+class Checksum {
+
+public:
+    Checksum() : hash(0xcbf29ce484222325ULL) {}
+
+    /* a ragged tail is hashed as if padded with zeros to a whole word,
+     * which is how sections are padded in the file */
+    void update(const char *data, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            mix(word);
+        }
+        if (i < size) {
+            uint64_t word = 0;
+            memcpy(&word, data + i, size - i);
+            mix(word);
+        }
+    }
+
+    uint64_t value() const { return hash; }
+
+private:
+    uint64_t hash;
+
+    void mix(uint64_t word)
+    {
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+};
+
+void fail(const string &path, const string &problem)
+{
+    string message = path + ": " + problem;
+    throw runtime_error(message.c_str());
+}
+
+/* An edited graph rebuilt with its rows back to back and its removed
+ * artists left out; the rest keep their order, so rows stay sorted */
+FrozenGraph compact(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    GraphBuilder builder;
+    vector<VertexId> ids(n, FrozenGraph::NO_VERTEX);
+    for (VertexId v = 0; v < n; v++) {
+        if (not graph.is_hidden(v)) ids[v] = builder.insert_vertex(graph.get_name(v));
+    }
+
+    for (VertexId v = 0; v < n; v++) {
+        for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+            VertexId w = graph.edge_target(e);
+            if (w < v) continue;
+
+            for (const SongId *s = graph.edge_songs_begin(e);
+                 s != graph.edge_songs_end(e); s++) {
+                builder.insert_edge(ids[v], ids[w],
+                                    builder.insert_song(graph.get_song(*s)));
+            }
+        }
+    }
+
+    return builder.freeze();
+}
+
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* save
+* purpose: write a graph to a snapshot file
+*
+* parameters: 1) a const FrozenGraph reference, the graph to save
+*             2) a const string reference, the path of the snapshot; an
+*                existing file there is replaced
+*             3) a const DistanceLabels pointer, labels built for the graph
+*                to save with it, or null (or empty labels) for none
+* returns: none
+*
+* notes: the file is written next to 'path' and renamed over it once
+*        complete. throws a runtime_error if it cannot be written. A graph
+*        a GraphEditor has changed is compacted first; if artists were
+*        removed, ids shift and the labels are left out
+*/
+void GraphSnapshot::save(const FrozenGraph &graph, const string &path,
+                         const DistanceLabels *labels)
+{
+    if (graph.ends != graph.offsets + 1 or graph.hidden != nullptr) {
+        save(compact(graph), path, labels);
+        return;
+    }
+
+    uint64_t n = graph.names.count;
+    uint64_t t = graph.titles.count;
+
+    DistanceLabels no_labels;
+    if (labels == nullptr or labels->num_vertices() != n) labels = &no_labels;
+    uint64_t label_entries = labels->num_entries();
+    uint64_t label_offsets_size = labels->empty() ? 0
+                                  : (n + 1) * sizeof(uint64_t);
+
+    struct Piece { const void *data; uint64_t size; };
+    Piece pieces[NUM_SECTIONS] = {
+        { graph.offsets,          (n + 1) * sizeof(EdgeId) },
+        { graph.targets,          graph.num_entries * sizeof(VertexId) },
+        { graph.song_offsets,     (graph.num_entries + 1) * sizeof(uint32_t) },
+        { graph.songs,            graph.song_offsets[graph.num_entries] *
+                                  sizeof(SongId) },
+        { graph.names.starts,     (n + 1) * sizeof(uint64_t) },
+        { graph.names.chars,      graph.names.starts[n] },
+        { graph.names.slots,      graph.names.num_slots * sizeof(VertexId) },
+        { graph.titles.starts,    (t + 1) * sizeof(uint64_t) },
+        { graph.titles.chars,     graph.titles.starts[t] },
+        { labels->offsets,        label_offsets_size },
+        { labels->hubs,           label_entries * sizeof(uint32_t) },
+        { labels->distances,      label_entries * sizeof(uint32_t) },
+        { labels->parents,        label_entries * sizeof(VertexId) },
+    };
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.num_vertices = n;
+    header.num_entries = graph.num_entries;
+    header.num_titles = t;
+
+    static const char ZEROS[8] = { 0 };
+    Checksum checksum;
+    uint64_t offset = sizeof(Header);
+    for (int s = 0; s < NUM_SECTIONS; s++) {
+        header.sections[s].offset = offset;
+        header.sections[s].size = pieces[s].size;
+        checksum.update(static_cast<const char *>(pieces[s].data),
+                        pieces[s].size);
+        offset += padded(pieces[s].size);
+    }
+    header.file_size = offset;
+    header.checksum = checksum.value();
+
+    string temporary = path + ".tmp";
+    ofstream out(temporary.c_str(), ios::binary | ios::trunc);
+    if (not out.is_open()) fail(temporary, "cannot be opened for writing");
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int s = 0; s < NUM_SECTIONS; s++) {
+        if (pieces[s].size > 0) {
+            out.write(static_cast<const char *>(pieces[s].data),
+                      pieces[s].size);
+        }
+        out.write(ZEROS, padded(pieces[s].size) - pieces[s].size);
+    }
+
+    out.close();
+    if (out.fail()) {
+        remove(temporary.c_str());
+        fail(temporary, "could not be written");
+    }
+    if (rename(temporary.c_str(), path.c_str()) != 0) {
+        remove(temporary.c_str());
+        fail(path, "could not be replaced");
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* load
+* purpose: map a snapshot file and serve a graph out of it
+*
+* parameters: 1) a const string reference, the path of the snapshot
+*             2) a DistanceLabels pointer, or null; replaced with the labels
+*                saved with the graph, pointing into the mapping too (empty
+*                if none were saved)
+* returns: a FrozenGraph whose tables point into the mapping; the file
+*          stays mapped until the last copy of the graph (or of the labels)
+*          is destroyed
+*
+* notes: throws a runtime_error if the file cannot be mapped or is not a
+*        complete snapshot of this version. the checksum and the table
+*        bounds are checked; the entries themselves are trusted, as only
+*        save writes these files
+*/
+FrozenGraph GraphSnapshot::load(const string &path, DistanceLabels *labels)
+{
+    /* the file stays mapped for as long as the graph (or a copy) lives */
+    shared_ptr<MappedFile> file(new MappedFile(path));
+    size_t size = file->size();
+    if (size < sizeof(Header)) fail(path, "is not a graph snapshot");
+    const char *base = file->data();
+
+    Header header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        fail(path, "is not a graph snapshot");
+    }
+    if (header.byte_order != BYTE_ORDER_MARK) {
+        fail(path, "was written on a machine of the other byte order");
+    }
+    if (header.version != VERSION) {
+        fail(path, "is snapshot version " + to_string(header.version) +
+                   ", expected " + to_string(VERSION));
+    }
+    if (header.file_size != size) fail(path, "is truncated");
+
+    uint64_t n = header.num_vertices;
+    uint64_t t = header.num_titles;
+    uint64_t entries = header.num_entries;
+    if (n >= FrozenGraph::NO_VERTEX or entries >= FrozenGraph::NO_VERTEX) {
+        fail(path, "is damaged (table too large)");
+    }
+
+    uint64_t expected[NUM_SECTIONS] = {
+        (n + 1) * sizeof(EdgeId), entries * sizeof(VertexId),
+        (entries + 1) * sizeof(uint32_t), 0, (n + 1) * sizeof(uint64_t), 0,
+        0, (t + 1) * sizeof(uint64_t), 0, 0, 0, 0, 0
+    };
+    uint64_t offset = sizeof(Header);
+    for (int s = 0; s < NUM_SECTIONS; s++) {
+        const SectionEntry &section = header.sections[s];
+        bool sized = s == SONGS or s == NAME_CHARS or s == TITLE_CHARS or
+                     s == NAME_SLOTS or s >= LABEL_OFFSETS or
+                     section.size == expected[s];
+        if (section.offset != offset or not sized or
+            section.size > size - offset) {
+            fail(path, "is damaged (bad section table)");
+        }
+        offset += padded(section.size);
+    }
+    if (offset != size) fail(path, "is damaged (bad section table)");
+
+    /* the probe table needs a power-of-two size with room to spare */
+    uint64_t num_slots = header.sections[NAME_SLOTS].size / sizeof(VertexId);
+    bool slots_ok = num_slots == 0 ? n == 0 :
+                    num_slots > n and (num_slots & (num_slots - 1)) == 0 and
+                    num_slots * sizeof(VertexId) ==
+                        header.sections[NAME_SLOTS].size;
+    if (not slots_ok) fail(path, "is damaged (bad section table)");
+
+    /* labels are all there or not at all; one entry is three words */
+    const SectionEntry *label_sections = header.sections + LABEL_OFFSETS;
+    uint64_t label_entries = label_sections[1].size / sizeof(uint32_t);
+    bool has_labels = label_sections[0].size != 0;
+    bool labels_ok = has_labels
+        ? label_sections[0].size == (n + 1) * sizeof(uint64_t)
+        : label_entries == 0;
+    for (int s = 1; s < 4; s++) {
+        labels_ok = labels_ok and
+                    label_sections[s].size == label_entries * sizeof(uint32_t);
+    }
+    if (not labels_ok) fail(path, "is damaged (bad section table)");
+
+    Checksum checksum;
+    checksum.update(base + sizeof(Header), size - sizeof(Header));
+    if (checksum.value() != header.checksum) {
+        fail(path, "is damaged (checksum mismatch)");
+    }
+
+    FrozenGraph graph;
+    const SectionEntry *sections = header.sections;
+    graph.offsets = reinterpret_cast<const EdgeId *>(
+        base + sections[OFFSETS].offset);
+    graph.ends = graph.offsets + 1;
+    graph.targets = reinterpret_cast<const VertexId *>(
+        base + sections[TARGETS].offset);
+    graph.song_offsets = reinterpret_cast<const uint32_t *>(
+        base + sections[SONG_OFFSETS].offset);
+    graph.songs = reinterpret_cast<const SongId *>(
+        base + sections[SONGS].offset);
+    graph.num_entries = entries;
+    graph.names.starts = reinterpret_cast<const uint64_t *>(
+        base + sections[NAME_STARTS].offset);
+    graph.names.chars = base + sections[NAME_CHARS].offset;
+    graph.names.slots = reinterpret_cast<const VertexId *>(
+        base + sections[NAME_SLOTS].offset);
+    graph.names.num_slots = num_slots;
+    graph.names.count = n;
+    graph.titles.starts = reinterpret_cast<const uint64_t *>(
+        base + sections[TITLE_STARTS].offset);
+    graph.titles.chars = base + sections[TITLE_CHARS].offset;
+    graph.titles.slots = nullptr;
+    graph.titles.num_slots = 0;
+    graph.titles.count = t;
+
+    if (graph.offsets[0] != 0 or graph.offsets[n] != entries or
+        graph.song_offsets[0] != 0 or
+        uint64_t(graph.song_offsets[entries]) * sizeof(SongId) !=
+            sections[SONGS].size or
+        graph.names.starts[0] != 0 or
+        graph.names.starts[n] != sections[NAME_CHARS].size or
+        graph.titles.starts[0] != 0 or
+        graph.titles.starts[t] != sections[TITLE_CHARS].size) {
+        fail(path, "is damaged (bad table bounds)");
+    }
+    graph.sorted = graph.rows_sorted();
+    graph.backing = file;
+
+    if (has_labels) {
+        const uint64_t *label_offsets = reinterpret_cast<const uint64_t *>(
+            base + sections[LABEL_OFFSETS].offset);
+        if (label_offsets[0] != 0 or label_offsets[n] != label_entries) {
+            fail(path, "is damaged (bad table bounds)");
+        }
+    }
+    if (labels != nullptr) {
+        *labels = DistanceLabels();
+        if (has_labels) {
+            labels->offsets = reinterpret_cast<const uint64_t *>(
+                base + sections[LABEL_OFFSETS].offset);
+            labels->hubs = reinterpret_cast<const uint32_t *>(
+                base + sections[LABEL_HUBS].offset);
+            labels->distances = reinterpret_cast<const uint32_t *>(
+                base + sections[LABEL_DISTANCES].offset);
+            labels->parents = reinterpret_cast<const VertexId *>(
+                base + sections[LABEL_PARENTS].offset);
+            labels->count = n;
+            labels->backing = file;
+        }
+    }
+
+    return graph;
+}
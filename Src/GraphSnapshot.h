@@ -0,0 +1,59 @@
+/**
+** GraphSnapshot.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Save a FrozenGraph to a binary snapshot file and load it back by
+**   memory-mapping the file. A loaded graph reads its tables straight out
+**   of the mapping: nothing is parsed or copied, so startup costs a
+**   checksum pass instead of a rebuild, and processes that load the same
+**   snapshot share its pages through the page cache.
+**
+** Notes:
+**   1) Layout: a fixed header (magic, format version, byte-order mark,
+**      table sizes, checksum, section table), then the CSR arrays with
+**      each edge's song list, the name and title tables and the name
+**      probe table, then the distance labels if any were saved (empty
+**      sections if not), each section starting on an 8-byte boundary
+**   2) Numbers are stored in the writing machine's byte order; a file
+**      from a machine of the other order is rejected by its byte-order
+**      mark rather than misread
+**   3) The checksum covers every byte after the header and is checked on
+**      load, so a truncated or damaged file is reported instead of being
+**      searched
+**   4) save writes to a temporary file and renames it into place, so a
+**      process mapping the old snapshot never sees a half-written one
+**   5) Errors (cannot open, bad magic, wrong version, bad checksum, ...)
+**      throw a runtime_error naming the file and the problem
+**
+** ChangeLog:
+**     April 2025:
+**       GraphSnapshot class created
+**       Version 2: the sorted name index became the name probe table
+**       Version 3: every edge carries its list of shared songs
+**       Version 4: distance labels can be stored alongside the graph
+**/
+
+#ifndef __GRAPH_SNAPSHOT__
+#define __GRAPH_SNAPSHOT__
+
+#include <cstdint>
+#include <string>
+
+#include "DistanceLabels.h"
+#include "FrozenGraph.h"
+
+class GraphSnapshot {
+
+public:
+    /* bumped whenever the layout changes; older files are refused */
+    static const uint32_t VERSION = 4;
+
+    static void save(const FrozenGraph &graph, const std::string &path,
+                     const DistanceLabels *labels = nullptr);
+    static FrozenGraph load(const std::string &path,
+                            DistanceLabels *labels = nullptr);
+};
+
+#endif /* __GRAPH_SNAPSHOT__ */
@@ -0,0 +1,175 @@
+/**
+** LandmarkIndex.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Precompute the hop distance from a few landmark artists to every
+**   artist, so the distance between any two artists can be bounded
+**   without a search.
+**
+** ChangeLog:
+**     April 2025:
+**       LandmarkIndex class created
+**/
+
+#include <algorithm>
+#include <vector>
+
+#include "DirectionOptimizingBFS.h"
+#include "LandmarkIndex.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+
+const uint32_t LandmarkIndex::UNREACHED;
+
+static_assert(LandmarkIndex::UNREACHED == BfsTree::UNREACHED,
+              "landmark rows are copied straight out of BfsTrees");
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an index with no landmarks
+*
+* @preconditions: none
+* @postconditions: every lower bound is 1 (0 from a vertex to itself) and
+*                  every upper bound UNREACHED until build is called
+*
+* @parameters: none
+*/
+LandmarkIndex::LandmarkIndex()
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* build
+* purpose: pick the landmarks of a graph and record their distances
+*
+* parameters: 1) a const FrozenGraph reference, the graph; the index stays
+*                valid for it (and its copies) only
+*             2) a size_t, how many landmarks to pick (at most one per
+*                vertex)
+* returns: none
+*
+* notes: runs one breadth-first search per landmark
+*/
+void LandmarkIndex::build(const FrozenGraph &graph, size_t num_landmarks)
+{
+    size_t n = graph.num_vertices();
+    size_t k = min(num_landmarks, n);
+    landmarks.clear();
+    table.assign(n * k, UNREACHED);
+    if (k == 0) return;
+
+    /* Candidates by degree, highest first, ties by id */
+    vector<VertexId> candidates(n);
+    for (VertexId v = 0; v < n; v++) candidates[v] = v;
+    stable_sort(candidates.begin(), candidates.end(),
+                [&graph](VertexId a, VertexId b) {
+                    return graph.degree(a) > graph.degree(b);
+                });
+
+    DirectionOptimizingBFS engine(graph);
+    BfsTree tree;
+    vector<VertexId> skipped;
+    for (size_t c = 0; c < n and landmarks.size() < k; c++) {
+        VertexId candidate = candidates[c];
+        const uint32_t *row = &table[candidate * k];
+        bool crowded = false;
+        for (size_t i = 0; i < landmarks.size(); i++) {
+            if (row[i] <= 1) crowded = true;
+        }
+        if (crowded and skipped.size() < k) {
+            skipped.push_back(candidate);
+            continue;
+        }
+
+        size_t column = landmarks.size();
+        landmarks.push_back(candidate);
+        engine.search(candidate, tree);
+        for (VertexId v = 0; v < n; v++) {
+            table[v * k + column] = tree.distance[v];
+        }
+    }
+
+    for (size_t s = 0; s < skipped.size() and landmarks.size() < k; s++) {
+        size_t column = landmarks.size();
+        landmarks.push_back(skipped[s]);
+        engine.search(skipped[s], tree);
+        for (VertexId v = 0; v < n; v++) {
+            table[v * k + column] = tree.distance[v];
+        }
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* lower_bound
+* purpose: bound the distance between two vertices from below
+*
+* parameters: 1) a VertexId, one vertex of the graph the index was built for
+*             2) a VertexId, another vertex
+* returns: a uint32_t, a number of hops no shorter than the shortest path
+*          between them, or UNREACHED if a landmark shows that there is no
+*          path at all
+*/
+uint32_t LandmarkIndex::lower_bound(VertexId s, VertexId t) const
+{
+    /* two different vertices are at least one hop apart */
+    uint32_t best = s == t ? 0 : 1;
+    size_t k = landmarks.size();
+    if (k == 0) return best;
+
+    const uint32_t *from = &table[s * k];
+    const uint32_t *to = &table[t * k];
+    for (size_t i = 0; i < k; i++) {
+        if (from[i] == UNREACHED or to[i] == UNREACHED) {
+            if (from[i] != to[i]) return UNREACHED;
+            continue;
+        }
+        uint32_t gap = from[i] > to[i] ? from[i] - to[i] : to[i] - from[i];
+        best = max(best, gap);
+    }
+
+    return best;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* upper_bound
+* purpose: bound the distance between two vertices from above
+*
+* parameters: 1) a VertexId, one vertex of the graph the index was built for
+*             2) a VertexId, another vertex
+* returns: a uint32_t, the length of some path between them through a
+*          landmark, or UNREACHED if no landmark reaches both
+*/
+uint32_t LandmarkIndex::upper_bound(VertexId s, VertexId t) const
+{
+    if (s == t) return 0;
+
+    size_t k = landmarks.size();
+    if (k == 0) return UNREACHED;
+
+    const uint32_t *from = &table[s * k];
+    const uint32_t *to = &table[t * k];
+    uint32_t best = UNREACHED;
+    for (size_t i = 0; i < k; i++) {
+        if (from[i] != UNREACHED and to[i] != UNREACHED) {
+            best = min(best, from[i] + to[i]);
+        }
+    }
+
+    return best;
+}
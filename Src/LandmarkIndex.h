@@ -0,0 +1,66 @@
+/**
+** LandmarkIndex.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Precompute the hop distance from a few landmark artists to every
+**   artist, so the distance between any two artists can be bounded
+**   without a search (the ALT technique: A*, Landmarks, Triangle
+**   inequality). For a landmark L and artists s and t,
+**       |d(L, s) - d(L, t)|  <=  d(s, t)  <=  d(L, s) + d(L, t)
+**   and the best bound over all landmarks is taken on each side.
+**
+** Notes:
+**   1) Landmarks are picked by degree, highest first, skipping an artist
+**      next to a landmark already picked so the landmarks spread out;
+**      artists skipped that way fill any places left over
+**   2) Distances are stored artist by artist (all landmarks of one
+**      artist side by side), so a bound reads two short rows
+**   3) A landmark that reaches exactly one of two artists proves they
+**      are not connected; lower_bound then returns UNREACHED
+**   4) The lower bound is a consistent A* heuristic, also on the graph
+**      with some artists excluded (excluding artists only makes the
+**      true distances longer)
+**   5) Built once per graph by k breadth-first searches; read-only after
+**      that, so any number of threads can use it
+**
+** ChangeLog:
+**     April 2025:
+**       LandmarkIndex class created
+**/
+
+#ifndef __LANDMARK_INDEX__
+#define __LANDMARK_INDEX__
+
+#include <cstdint>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class LandmarkIndex {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+
+    /* a distance no landmark can vouch for */
+    static const uint32_t UNREACHED = UINT32_MAX;
+
+    LandmarkIndex();
+
+    void build(const FrozenGraph &graph, size_t num_landmarks);
+
+    size_t num_landmarks() const { return landmarks.size(); }
+    VertexId landmark(size_t i) const { return landmarks[i]; }
+
+    uint32_t lower_bound(VertexId s, VertexId t) const;
+    uint32_t upper_bound(VertexId s, VertexId t) const;
+
+private:
+    std::vector<VertexId> landmarks;
+
+    /* distance from landmark i to vertex v at [v * landmarks.size() + i] */
+    std::vector<uint32_t> table;
+};
+
+#endif /* __LANDMARK_INDEX__ */
@@ -0,0 +1,117 @@
+/**
+** LandmarkSearch.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Find a shortest collaboration path with A*, steered towards the
+**   destination by the distance bounds of a LandmarkIndex.
+**
+** ChangeLog:
+**     April 2025:
+**       landmark_search created
+**/
+
+#include <stack>
+#include <vector>
+
+#include "LandmarkSearch.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* landmark_search
+* purpose: find a shortest path between two artists with A*, using the
+*          landmark lower bound on the distance left as the heuristic
+*
+* parameters: 1) a const FrozenGraph reference, the graph to search
+*             2) a const LandmarkIndex reference, built for that graph
+*             3) a VertexId, the source artist
+*             4) a VertexId, the destination artist
+*             5) a const vector<VertexId> reference, artists the path may not
+*                pass through (the source itself is never excluded)
+*             6) a TraversalContext reference, scratch state for the search
+* returns: a stack of VertexIds with the source on top and the destination
+*          at the bottom, or an empty stack if no path exists
+*
+* notes: edges all cost one hop, so the open set is a bucket queue indexed
+*        by estimated path length. Within a bucket the artist queued last
+*        is expanded first, which favors artists nearer the destination.
+*        A queued artist reached again by a shorter route is queued again
+*        and its older entry skipped when it comes up
+*/
+stack<VertexId> landmark_search(const FrozenGraph &graph,
+                                const LandmarkIndex &landmarks,
+                                VertexId source, VertexId dest,
+                                const vector<VertexId> &exclude,
+                                TraversalContext &context)
+{
+    const uint32_t UNREACHED = LandmarkIndex::UNREACHED;
+    context.reset(graph.num_vertices());
+
+    stack<VertexId> path;
+    if (source == dest) {
+        path.push(source);
+        return path;
+    }
+
+    /* An excluded artist looks already reached at distance 0, which no
+     * route can improve on */
+    for (VertexId artist : exclude) {
+        if (artist == dest) return path;
+        if (artist == source) continue;
+        context.mark_vertex(artist);
+        context.set_distance(artist, 0);
+    }
+
+    uint32_t estimate = landmarks.lower_bound(source, dest);
+    if (estimate == UNREACHED) return path;
+
+    context.mark_vertex(source);
+    context.set_distance(source, 0);
+    vector<vector<VertexId>> buckets(estimate + 1);
+    buckets[estimate].push_back(source);
+    size_t waiting = 1;
+
+    for (uint32_t f = estimate; f < buckets.size(); f++) {
+        while (not buckets[f].empty()) {
+            VertexId current = buckets[f].back();
+            buckets[f].pop_back();
+            waiting--;
+
+            uint32_t g = context.get_distance(current);
+            if (g + landmarks.lower_bound(current, dest) != f) continue;
+            if (current == dest) return context.report_path(source, dest);
+
+            context.count_expansion(graph.degree(current), waiting);
+            for (EdgeId e = graph.edge_begin(current);
+                 e < graph.edge_end(current); e++) {
+                VertexId neighbor = graph.edge_target(e);
+                if (context.is_marked(neighbor) and
+                    context.get_distance(neighbor) <= g + 1) {
+                    continue;
+                }
+
+                uint32_t h = landmarks.lower_bound(neighbor, dest);
+                if (h == UNREACHED) continue;
+
+                context.mark_vertex(neighbor);
+                context.set_predecessor(neighbor, current);
+                context.set_distance(neighbor, g + 1);
+                if (g + 1 + h >= buckets.size()) buckets.resize(g + 2 + h);
+                buckets[g + 1 + h].push_back(neighbor);
+                waiting++;
+            }
+        }
+    }
+
+    return path;
+}
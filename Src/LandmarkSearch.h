@@ -0,0 +1,45 @@
+/**
+** LandmarkSearch.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Find a shortest collaboration path with A*, steered towards the
+**   destination by the distance bounds of a LandmarkIndex. Artists whose
+**   lower bound puts them off the way are left until last, so long
+**   searches settle far fewer artists than a breadth-first search.
+**
+** Notes:
+**   1) The landmark lower bound is consistent, so the path returned is
+**      always a shortest one; with no landmarks the search degrades to a
+**      plain breadth-first search
+**   2) When several shortest paths exist, the one returned can differ from
+**      the one the classic search would find
+**   3) Artists a landmark proves cannot reach the destination are never
+**      queued, and a destination proven unreachable is reported at once
+**   4) Excluded artists are never entered, which is how the "not" command
+**      is answered
+**
+** ChangeLog:
+**     April 2025:
+**       landmark_search created
+**/
+
+#ifndef __LANDMARK_SEARCH__
+#define __LANDMARK_SEARCH__
+
+#include <stack>
+#include <vector>
+
+#include "FrozenGraph.h"
+#include "LandmarkIndex.h"
+#include "TraversalContext.h"
+
+std::stack<FrozenGraph::VertexId>
+landmark_search(const FrozenGraph &graph, const LandmarkIndex &landmarks,
+                FrozenGraph::VertexId source,
+                FrozenGraph::VertexId dest,
+                const std::vector<FrozenGraph::VertexId> &exclude,
+                TraversalContext &context);
+
+#endif /* __LANDMARK_SEARCH__ */
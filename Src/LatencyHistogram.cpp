@@ -0,0 +1,181 @@
+/**
+** LatencyHistogram.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Count timings in log-linear buckets and read percentiles back out.
+**
+** ChangeLog:
+**     April 2025:
+**       LatencyHistogram class created
+**/
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+const unsigned LatencyHistogram::SUB_BITS;
+const uint64_t LatencyHistogram::EXACT;
+const size_t LatencyHistogram::NUM_BUCKETS;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize a histogram of no timings
+*
+* @preconditions: none
+* @postconditions: every bucket is empty
+*
+* @parameters: none
+*/
+LatencyHistogram::LatencyHistogram()
+{
+    clear();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* record
+* purpose: count one timing
+*
+* parameters: a uint64_t, the time taken, in nanoseconds
+* returns: none
+*/
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+    buckets[bucket_of(nanoseconds)].fetch_add(1, memory_order_relaxed);
+
+    uint64_t seen = largest.load(memory_order_relaxed);
+    while (nanoseconds > seen and
+           not largest.compare_exchange_weak(seen, nanoseconds,
+                                             memory_order_relaxed)) {
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* clear
+* purpose: forget every timing
+*
+* parameters: none
+* returns: none
+*/
+void LatencyHistogram::clear()
+{
+    for (size_t b = 0; b < NUM_BUCKETS; b++) {
+        buckets[b].store(0, memory_order_relaxed);
+    }
+    largest.store(0, memory_order_relaxed);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* count
+* purpose: tell how many timings have been recorded
+*
+* parameters: none
+* returns: a uint64_t, the number of timings
+*/
+uint64_t LatencyHistogram::count() const
+{
+    uint64_t total = 0;
+    for (size_t b = 0; b < NUM_BUCKETS; b++) {
+        total += buckets[b].load(memory_order_relaxed);
+    }
+
+    return total;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* percentile
+* purpose: find the timing a given fraction of the timings are no slower
+*          than
+*
+* parameters: a double, the fraction, from 0 to 1 (0.99 for p99)
+* returns: a uint64_t, the largest value of the bucket holding that timing,
+*          but no more than the largest timing; 0 if there are none
+*/
+uint64_t LatencyHistogram::percentile(double fraction) const
+{
+    uint64_t counts[NUM_BUCKETS];
+    uint64_t total = 0;
+    for (size_t b = 0; b < NUM_BUCKETS; b++) {
+        counts[b] = buckets[b].load(memory_order_relaxed);
+        total += counts[b];
+    }
+    if (total == 0) return 0;
+
+    uint64_t rank = uint64_t(ceil(fraction * total));
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < NUM_BUCKETS; b++) {
+        seen += counts[b];
+        if (seen >= rank) {
+            uint64_t top = bucket_top(b);
+            return top < max() ? top : max();
+        }
+    }
+
+    return max();
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* bucket_of
+* purpose: find the bucket a value is counted in
+*
+* parameters: a uint64_t, the value
+* returns: a size_t, the bucket: the value itself below EXACT, and above
+*          that 16 buckets per power of two, picked by the four bits after
+*          the value's leading one
+*/
+size_t LatencyHistogram::bucket_of(uint64_t value)
+{
+    if (value < EXACT) return value;
+
+    unsigned power = 63 - __builtin_clzll(value);
+    uint64_t sub = (value >> (power - SUB_BITS)) & ((1 << SUB_BITS) - 1);
+
+    return EXACT + (power - SUB_BITS - 1) * (1 << SUB_BITS) + sub;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* bucket_top
+* purpose: find the largest value a bucket counts
+*
+* parameters: a size_t, the bucket
+* returns: a uint64_t, the largest value bucket_of puts in it
+*/
+uint64_t LatencyHistogram::bucket_top(size_t bucket)
+{
+    if (bucket < EXACT) return bucket;
+
+    size_t above = bucket - EXACT;
+    unsigned power = SUB_BITS + 1 + above / (1 << SUB_BITS);
+    uint64_t sub = above % (1 << SUB_BITS);
+    uint64_t width = uint64_t(1) << (power - SUB_BITS);
+    uint64_t low = ((uint64_t(1) << SUB_BITS) + sub) * width;
+
+    return low + (width - 1);
+}
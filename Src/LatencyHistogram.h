@@ -0,0 +1,56 @@
+/**
+** LatencyHistogram.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Count how long something took, in nanoseconds, in a fixed set of
+**   buckets, so percentiles of millions of timings can be read back
+**   without keeping the timings.
+**
+** Notes:
+**   1) Buckets are log-linear, as in HdrHistogram: values below 32 get a
+**      bucket each, and every power of two above that is split into 16
+**      equal buckets, so a percentile is off by at most 1/16 (6.25%) of
+**      its value, from a nanosecond to centuries, in 976 buckets
+**   2) The largest value is kept exactly
+**   3) record only adds to atomic counters, so any number of threads may
+**      record into one histogram at once; a reader racing them sees some
+**      of their timings and not others
+**
+** ChangeLog:
+**     April 2025:
+**       LatencyHistogram class created
+**/
+
+#ifndef __LATENCY_HISTOGRAM__
+#define __LATENCY_HISTOGRAM__
+
+#include <atomic>
+#include <cstdint>
+
+class LatencyHistogram {
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t nanoseconds);
+    void clear();
+
+    uint64_t count() const;
+    uint64_t max() const { return largest.load(std::memory_order_relaxed); }
+    uint64_t percentile(double fraction) const;
+
+private:
+    static const unsigned SUB_BITS = 4;
+    static const uint64_t EXACT = uint64_t(2) << SUB_BITS;
+    static const size_t NUM_BUCKETS = EXACT + (64 - SUB_BITS - 1) * (1 << SUB_BITS);
+
+    std::atomic<uint64_t> buckets[NUM_BUCKETS];
+    std::atomic<uint64_t> largest;
+
+    static size_t bucket_of(uint64_t value);
+    static uint64_t bucket_top(size_t bucket);
+};
+
+#endif /* __LATENCY_HISTOGRAM__ */
@@ -0,0 +1,99 @@
+/**
+** LineScanner.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Split a block of memory into lines without copying them. Newlines are
+**   found sixteen bytes at a time: one vector compare gives a bit mask of
+**   the newlines in a block, and each line is then read off the mask with
+**   a count-trailing-zeros instead of a byte-by-byte search.
+**
+** Notes:
+**   1) Lines are StringRefs into the block, which must outlive them
+**   2) Lines split exactly as std::getline splits them: on '\n' only (a
+**      '\r' stays part of the line), and a last line without a newline is
+**      still a line, but nothing follows a final newline
+**   3) Uses SSE2 where the compiler provides it and a plain loop that
+**      builds the same masks elsewhere
+**
+** ChangeLog:
+**     April 2025:
+**       LineScanner class created
+**/
+
+#ifndef __LINE_SCANNER__
+#define __LINE_SCANNER__
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "StringRef.h"
+
+class LineScanner {
+
+public:
+    static const size_t BLOCK = 16;
+
+    LineScanner(const char *begin, const char *end)
+        : line_start(begin), block(begin), end(end), mask(0)
+    {
+        if (block < end) mask = newlines(block);
+    }
+
+    /* store the next line in 'line'; false once the block is used up */
+    bool next(StringRef &line)
+    {
+        while (mask == 0) {
+            block += BLOCK;
+            if (block >= end) {
+                if (line_start >= end) return false;
+                line = StringRef(line_start, end - line_start);
+                line_start = end;
+                return true;
+            }
+            mask = newlines(block);
+        }
+
+        const char *newline = block + __builtin_ctz(mask);
+        mask &= mask - 1;
+        line = StringRef(line_start, newline - line_start);
+        line_start = newline + 1;
+        return true;
+    }
+
+private:
+    const char *line_start;     // first byte of the next line
+    const char *block;          // the sixteen bytes 'mask' describes
+    const char *end;
+    uint32_t mask;              // newlines in 'block' not yet returned
+
+    /* bit i is set iff block[i] is a newline (bytes past 'end' are not) */
+    uint32_t newlines(const char *at) const
+    {
+        if (end - at < static_cast<ptrdiff_t>(BLOCK)) {
+            uint32_t bits = 0;
+            for (ptrdiff_t i = 0; i < end - at; i++) {
+                if (at[i] == '\n') bits |= uint32_t(1) << i;
+            }
+            return bits;
+        }
+
+#ifdef __SSE2__
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+#else
+        uint32_t bits = 0;
+        for (size_t i = 0; i < BLOCK; i++) {
+            if (at[i] == '\n') bits |= uint32_t(1) << i;
+        }
+        return bits;
+#endif
+    }
+};
+
+#endif /* __LINE_SCANNER__ */
@@ -0,0 +1,114 @@
+/**
+** MappedFile.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Map a whole file read-only into memory, so its bytes can be scanned
+**   or served in place instead of being read through a stream.
+**
+** ChangeLog:
+**     April 2025:
+**       MappedFile class created
+**       Refuses files that are not regular files
+**/
+
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: map a file into memory
+*
+* @preconditions: none
+* @postconditions: [data(), data() + size()) holds the file's bytes
+*
+* @parameters: a const string reference, the path of the file
+*
+* @notes: throws a runtime_error if the file cannot be opened or mapped,
+*         which includes any file that is not a regular file
+*/
+MappedFile::MappedFile(const string &path)
+    : address(""), length(0), mapped(false)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        string message = path + ": cannot be opened";
+        throw runtime_error(message.c_str());
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        string message = path + ": cannot be read";
+        throw runtime_error(message.c_str());
+    }
+    if (not S_ISREG(info.st_mode)) {
+        close(fd);
+        string message = path + ": cannot be mapped";
+        throw runtime_error(message.c_str());
+    }
+    if (info.st_size == 0) {
+        close(fd);
+        return;
+    }
+
+    void *region = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        string message = path + ": cannot be mapped";
+        throw runtime_error(message.c_str());
+    }
+
+    address = static_cast<const char *>(region);
+    length = info.st_size;
+    mapped = true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: mappable
+* @purpose: tell whether a file could be mapped
+*
+* @preconditions: none
+* @postconditions: none
+*
+* @parameters: a const string reference, the path of the file
+* @returns: a bool, true if the path names a regular file; false for a
+*           pipe, a FIFO, a directory or a device, or a path that does not
+*           exist
+*/
+bool MappedFile::mappable(const string &path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 and S_ISREG(info.st_mode);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: destructor
+* @purpose: unmap the file
+*
+* @preconditions: nothing still points into the mapping
+* @postconditions: the mapping is released
+*/
+MappedFile::~MappedFile()
+{
+    if (mapped) munmap(const_cast<char *>(address), length);
+}
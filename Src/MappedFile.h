@@ -0,0 +1,54 @@
+/**
+** MappedFile.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Map a whole file read-only into memory, so its bytes can be scanned
+**   or served in place instead of being read through a stream.
+**
+** Notes:
+**   1) The mapping is shared with the page cache: nothing is copied, and
+**      several processes mapping one file share its pages
+**   2) An empty file maps to an empty range (data() is not null)
+**   3) The constructor throws a runtime_error naming the file if it
+**      cannot be opened or mapped; the destructor unmaps it
+**   4) Only regular files can be mapped. A pipe or a FIFO has no size to
+**      map and must be read as a stream; mappable tells them apart
+**
+** ChangeLog:
+**     April 2025:
+**       MappedFile class created
+**       Refuses files that are not regular files
+**/
+
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+
+public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    static bool mappable(const std::string &path);
+
+    const char *data() const { return address; }
+    size_t size() const { return length; }
+
+    const char *begin() const { return address; }
+    const char *end() const { return address + length; }
+
+private:
+    const char *address;
+    size_t length;
+    bool mapped;
+
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+};
+
+#endif /* __MAPPED_FILE__ */
@@ -0,0 +1,198 @@
+/**
+** OutputBuffer.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Collect output in one large buffer and hand it to the real output
+**   stream in big blocks.
+**
+** ChangeLog:
+**     April 2025:
+**       OutputBuffer class created
+**       Storage grows with the output instead of being allocated up front
+**/
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+#include "OutputBuffer.h"
+
+using namespace std;
+
+const size_t OutputBuffer::DEFAULT_CAPACITY;
+const size_t OutputBuffer::INITIAL_SIZE;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: initialize an empty buffer in front of a stream
+*
+* @preconditions: the target outlives the buffer
+* @postconditions: nothing is written to the target until the buffer fills
+*                  or is flushed; no storage is allocated until the first
+*                  write
+*
+* @parameters: 1) a std::ostream reference, the real output stream
+*             2) a size_t, the buffer's largest size in bytes (at least 1)
+*/
+OutputBuffer::OutputBuffer(ostream &target, size_t capacity)
+    : target(target), capacity(capacity > 0 ? capacity : 1)
+{
+    setp(nullptr, nullptr);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: destructor
+* @purpose: hand what is still buffered to the real stream
+*
+* @notes: the real stream is not flushed; its owner decides when
+*/
+OutputBuffer::~OutputBuffer()
+{
+    drain();
+}
+
+/*********************************************************************
+ ******************* protected function definitions ******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* overflow
+* purpose: make room for a character when the buffer is full
+*
+* parameters: an int_type, the character, or eof for none
+* returns: an int_type, the character (not eof) on success, eof if the
+*          real stream would not take the buffer
+*
+* notes: the buffer grows if it can, and is handed on only at full capacity
+*/
+OutputBuffer::int_type OutputBuffer::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return drain() ? traits_type::not_eof(c) : traits_type::eof();
+    }
+    if (not grow(1)) {
+        if (not drain()) return traits_type::eof();
+        grow(1);
+    }
+
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* xsputn
+* purpose: write a block of characters
+*
+* parameters: 1) a const char pointer, the characters
+*             2) a std::streamsize, how many there are
+* returns: a std::streamsize, how many were written
+*
+* notes: a block that fits, once the buffer has grown as far as it may,
+*        is copied in; one that does not fit even in an empty buffer of
+*        full capacity is written to the real stream directly
+*/
+streamsize OutputBuffer::xsputn(const char *s, streamsize n)
+{
+    if (n <= epptr() - pptr() or grow(size_t(n))) {
+        traits_type::copy(pptr(), s, size_t(n));
+        pbump(int(n));
+        return n;
+    }
+
+    if (not drain()) return 0;
+    if (size_t(n) >= capacity) {
+        return target.rdbuf()->sputn(s, n);
+    }
+    grow(size_t(n));
+
+    traits_type::copy(pptr(), s, size_t(n));
+    pbump(int(n));
+    return n;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* sync
+* purpose: hand everything buffered to the real stream and flush it
+*
+* parameters: none
+* returns: an int, 0 on success, -1 if the real stream failed
+*/
+int OutputBuffer::sync()
+{
+    if (not drain()) return -1;
+    target.flush();
+
+    return target.good() ? 0 : -1;
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* drain
+* purpose: hand everything buffered to the real stream, without flushing it
+*
+* parameters: none
+* returns: a bool, true iff the real stream took all of it
+*
+* notes: the buffer is emptied either way
+*/
+bool OutputBuffer::drain()
+{
+    streamsize pending = pptr() - pbase();
+    streamsize taken = pending > 0 ? target.rdbuf()->sputn(pbase(), pending) : 0;
+    setp(buffer.data(), buffer.data() + buffer.size());
+
+    if (taken != pending) {
+        target.setstate(ios::badbit);
+        return false;
+    }
+    return true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* grow
+* purpose: enlarge the buffer so it has room for more characters, keeping
+*          what is buffered
+*
+* parameters: a size_t, how many more characters must fit
+* returns: a bool, true iff they fit now
+*
+* notes: the size doubles from INITIAL_SIZE, but never passes the capacity
+*/
+bool OutputBuffer::grow(size_t needed)
+{
+    size_t pending = size_t(pptr() - pbase());
+    if (needed > capacity - pending) return false;
+    if (needed <= buffer.size() - pending) return true;
+
+    size_t size = max(buffer.size(), min(INITIAL_SIZE, capacity));
+    while (size - pending < needed) {
+        size = min(size * 2, capacity);
+    }
+    buffer.resize(size);
+    setp(buffer.data(), buffer.data() + buffer.size());
+    pbump(int(pending));
+    return true;
+}
@@ -0,0 +1,66 @@
+/**
+** OutputBuffer.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Collect a command run's output in one large buffer and hand it to
+**   the real output stream in big blocks, so writing a million answers
+**   costs a few hundred write calls instead of one flush per line.
+**
+** Notes:
+**   1) A stream buffer: make a std::ostream over it and write to that
+**   2) The buffer is only handed on when it fills up, or when the stream
+**      over it is flushed (std::flush, std::endl, or ostream::flush); a
+**      flush also flushes the real stream. The destructor hands on what
+**      is left, without flushing the real stream
+**   3) A write at least as long as the capacity goes to the real stream
+**      directly, after what is already buffered
+**   4) If the real stream takes fewer bytes than it is given, the stream
+**      over the buffer goes bad, as it would writing to the real stream
+**   5) The storage starts empty and doubles, from INITIAL_SIZE up to the
+**      capacity, as output arrives, so a run that writes a few lines does
+**      not allocate (and clear) the whole capacity
+**
+** ChangeLog:
+**     April 2025:
+**       OutputBuffer class created
+**       Storage grows with the output instead of being allocated up front
+**/
+
+#ifndef __OUTPUT_BUFFER__
+#define __OUTPUT_BUFFER__
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+class OutputBuffer : public std::streambuf {
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 20;
+    static const size_t INITIAL_SIZE = 1 << 12;
+
+    explicit OutputBuffer(std::ostream &target,
+                          size_t capacity = DEFAULT_CAPACITY);
+    ~OutputBuffer();
+
+protected:
+    int_type overflow(int_type c);
+    std::streamsize xsputn(const char *s, std::streamsize n);
+    int sync();
+
+private:
+    std::ostream &target;
+    size_t capacity;
+    std::vector<char> buffer;
+
+    bool drain();
+    bool grow(size_t needed);
+
+    OutputBuffer(const OutputBuffer &);
+    OutputBuffer &operator=(const OutputBuffer &);
+};
+
+#endif /* __OUTPUT_BUFFER__ */
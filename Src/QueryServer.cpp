@@ -0,0 +1,658 @@
+/**
+** QueryServer.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Serve the command protocol to many clients at once over a Unix domain
+**   socket, multiplexing the connections with epoll and answering the
+**   queries on a pool of worker threads.
+**
+** ChangeLog:
+**     April 2025:
+**       QueryServer class created
+**/
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "QueryServer.h"
+#include "WorkerPool.h"
+
+using namespace std;
+
+namespace {
+
+/* epoll keys of the listening socket and the wake-up counter; clients
+ * are numbered from FIRST_CLIENT */
+const uint64_t LISTEN_KEY = 0;
+const uint64_t WAKE_KEY = 1;
+const uint64_t FIRST_CLIENT = 2;
+
+/* how many events one epoll_wait returns, and how much of one client's
+ * input is read per event, so no client starves the others */
+const int MAX_EVENTS = 64;
+const size_t READ_CHUNK = 1 << 16;
+
+/* written output is dropped from the front of a client's buffer once
+ * this much of it has piled up */
+const size_t COMPACT_AT = 1 << 20;
+
+}
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: make the listening socket
+*
+* @preconditions: none
+* @postconditions: clients can connect to 'path'; nothing is answered until
+*                  run is called
+*
+* @parameters: 1) a const string reference, the path of the socket file
+*             2) a size_t, the number of worker threads (at least one is
+*                used)
+*
+* @notes: throws a runtime_error naming the path if the socket cannot be
+*         made, bound or listened on; a socket file already at the path is
+*         removed first, but no other kind of file is
+*/
+QueryServer::QueryServer(const string &path, size_t num_threads)
+    : socket_path(path), num_threads(num_threads), listen_fd(-1),
+      epoll_fd(-1), wake_fd(-1), bound(false), stopping(false),
+      handlers(nullptr), next_client(FIRST_CLIENT), in_flight(0)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() or path.size() >= sizeof(address.sun_path)) {
+        string message = path + ": not a usable socket path";
+        throw runtime_error(message.c_str());
+    }
+    memcpy(address.sun_path, path.c_str(), path.size());
+
+    struct stat info;
+    if (lstat(path.c_str(), &info) == 0 and S_ISSOCK(info.st_mode)) {
+        unlink(path.c_str());
+    }
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    bound = listen_fd >= 0 and
+            bind(listen_fd, reinterpret_cast<sockaddr *>(&address),
+                 sizeof(address)) == 0;
+    if (not bound or listen(listen_fd, SOMAXCONN) != 0) {
+        string message = path + ": cannot listen (" + strerror(errno) + ")";
+        release();
+        throw runtime_error(message.c_str());
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event listen_event, wake_event;
+    listen_event.events = EPOLLIN;
+    listen_event.data.u64 = LISTEN_KEY;
+    wake_event.events = EPOLLIN;
+    wake_event.data.u64 = WAKE_KEY;
+    if (epoll_fd < 0 or wake_fd < 0 or
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event) != 0 or
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &wake_event) != 0) {
+        string message = path + ": cannot poll (" + strerror(errno) + ")";
+        release();
+        throw runtime_error(message.c_str());
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: destructor
+* @purpose: close the socket and remove its file
+*
+* @preconditions: run is not running
+* @postconditions: the socket file is gone
+*/
+QueryServer::~QueryServer()
+{
+    release();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* run
+* purpose: serve clients until stop is called
+*
+* parameters: a const Handlers reference, what to do with the commands
+* returns: none
+*
+* notes: throws a runtime_error if epoll fails; every connection is closed
+*        when run returns, and the server may be run again
+*/
+void QueryServer::run(const Handlers &handlers)
+{
+    this->handlers = &handlers;
+    pool.reset(new WorkerPool(num_threads));
+    contexts = vector<TraversalContext>(pool->size());
+
+    epoll_event events[MAX_EVENTS];
+    string failure;
+    while (not stopping.load()) {
+        int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            failure = socket_path + ": cannot poll (" + strerror(errno) + ")";
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            uint64_t key = events[i].data.u64;
+            if (key == LISTEN_KEY) {
+                accept_clients();
+                continue;
+            }
+            if (key == WAKE_KEY) {
+                uint64_t count;
+                while (read(wake_fd, &count, sizeof(count)) > 0) {
+                }
+                collect_answers();
+                continue;
+            }
+
+            auto found = clients.find(key);
+            if (found == clients.end()) continue;
+            Client &client = *found->second;
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                break_client(client);
+            } else {
+                if (events[i].events & EPOLLIN) read_client(key, client);
+                if (events[i].events & EPOLLOUT) write_client(key, client);
+            }
+            close_if_done(key, client);
+        }
+
+        dispatch();
+    }
+
+    pool->wait_idle();
+    close_all();
+    pool.reset();
+    this->handlers = nullptr;
+    stopping.store(false);
+
+    if (not failure.empty()) throw runtime_error(failure.c_str());
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* stop
+* purpose: make run return
+*
+* parameters: none
+* returns: none
+*
+* notes: only stores a flag and writes to an eventfd, so it is safe to call
+*        from a signal handler
+*/
+void QueryServer::stop()
+{
+    stopping.store(true);
+    uint64_t one = 1;
+    ssize_t written = write(wake_fd, &one, sizeof(one));
+    (void) written;
+}
+
+/*********************************************************************
+ ******************** private function definitions *******************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* accept_clients
+* purpose: take every pending connection and start reading from it
+*
+* parameters: none
+* returns: none
+*/
+void QueryServer::accept_clients()
+{
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR or errno == ECONNABORTED) continue;
+            return;
+        }
+
+        unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        client->written = 0;
+        client->first_seq = 0;
+        client->next_seq = 0;
+        client->in_flight = 0;
+        client->reading = true;
+        client->broken = false;
+        client->events = EPOLLIN;
+
+        uint64_t id = next_client++;
+        epoll_event event;
+        event.events = client->events;
+        event.data.u64 = id;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        clients[id] = move(client);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* read_client
+* purpose: read what a client has sent and queue the commands it completes
+*
+* parameters: 1) a uint64_t, the client's key
+*             2) a Client reference, the client
+* returns: none
+*
+* notes: reads at most READ_CHUNK bytes; epoll reports the client again if
+*        there is more. Lines split as std::getline splits them, and at the
+*        end of the input a last line without a newline is still a line
+*/
+void QueryServer::read_client(uint64_t id, Client &client)
+{
+    if (not client.reading) return;
+
+    char chunk[READ_CHUNK];
+    ssize_t got = recv(client.fd, chunk, sizeof(chunk), 0);
+    if (got < 0) {
+        if (errno != EINTR and errno != EAGAIN and errno != EWOULDBLOCK) {
+            break_client(client);
+        }
+        return;
+    }
+
+    if (got == 0) {
+        if (not client.input.empty()) {
+            string line;
+            line.swap(client.input);
+            take_line(id, client, line);
+        }
+        Command command;
+        if (client.reading and client.parser.finish(command)) {
+            queue_command(id, client, command);
+        }
+        client.reading = false;
+        update_events(id, client);
+        return;
+    }
+
+    client.input.append(chunk, got);
+    size_t start = 0, end;
+    while (client.reading and
+           (end = client.input.find('\n', start)) != string::npos) {
+        take_line(id, client, client.input.substr(start, end - start));
+        start = end + 1;
+    }
+    if (client.reading) {
+        client.input.erase(0, start);
+    } else {
+        client.input.clear();
+        update_events(id, client);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* take_line
+* purpose: feed one line of a client's input to its parser
+*
+* parameters: 1) a uint64_t, the client's key
+*             2) a Client reference, the client
+*             3) a const string reference, the line, without its newline
+* returns: none
+*/
+void QueryServer::take_line(uint64_t id, Client &client, const string &line)
+{
+    Command command;
+    if (client.parser.feed(line, command)) {
+        queue_command(id, client, command);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* queue_command
+* purpose: owe a client the answer to a command, and queue the command
+*
+* parameters: 1) a uint64_t, the client's key
+*             2) a Client reference, the client
+*             3) a Command reference, the command; moved from
+* returns: none
+*
+* notes: "quit" owes nothing; it ends the client's input instead
+*/
+void QueryServer::queue_command(uint64_t id, Client &client, Command &command)
+{
+    if (command.name == "quit") {
+        client.reading = false;
+        return;
+    }
+
+    Slot slot;
+    slot.done = false;
+    client.slots.push_back(slot);
+
+    Job job;
+    job.client = id;
+    job.seq = client.next_seq++;
+    job.command = move(command);
+    backlog.push_back(move(job));
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* dispatch
+* purpose: hand queued queries to the workers, and run the commands that
+*          must run alone once the workers are done with what came before
+*
+* parameters: none
+* returns: none
+*
+* notes: commands leave the backlog in the order they were received, so a
+*        command that runs alone holds back every query behind it
+*/
+void QueryServer::dispatch()
+{
+    while (not backlog.empty()) {
+        Job &job = backlog.front();
+        auto found = clients.find(job.client);
+        Client *client = found == clients.end() ? nullptr : found->second.get();
+
+        if (handlers->runs_alone(job.command)) {
+            if (in_flight > 0) return;
+            uint64_t id = job.client;
+            if (client != nullptr and not client->broken) {
+                ostringstream result;
+                handlers->alone(job.command, result);
+                string text = result.str();
+                settle(*client, job.seq, text);
+            }
+            backlog.pop_front();
+            if (client != nullptr) {
+                write_client(id, *client);
+                close_if_done(id, *client);
+            }
+            continue;
+        }
+
+        if (client == nullptr or client->broken) {
+            backlog.pop_front();
+            continue;
+        }
+
+        in_flight++;
+        client->in_flight++;
+        shared_ptr<Job> task(new Job(move(job)));
+        backlog.pop_front();
+        pool->submit([this, task](size_t worker) {
+            ostringstream result;
+            handlers->query(task->command, contexts[worker], result);
+
+            Answer answer;
+            answer.client = task->client;
+            answer.seq = task->seq;
+            answer.text = result.str();
+            {
+                lock_guard<mutex> guard(answers_lock);
+                answers.push_back(move(answer));
+            }
+            uint64_t one = 1;
+            ssize_t written = write(wake_fd, &one, sizeof(one));
+            (void) written;
+        });
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* collect_answers
+* purpose: take the answers the workers have finished and write them to
+*          their clients
+*
+* parameters: none
+* returns: none
+*/
+void QueryServer::collect_answers()
+{
+    vector<Answer> finished;
+    {
+        lock_guard<mutex> guard(answers_lock);
+        finished.swap(answers);
+    }
+
+    for (Answer &answer : finished) {
+        in_flight--;
+        auto found = clients.find(answer.client);
+        if (found == clients.end()) continue;
+
+        Client &client = *found->second;
+        client.in_flight--;
+        if (not client.broken) {
+            settle(client, answer.seq, answer.text);
+            write_client(answer.client, client);
+        }
+        close_if_done(answer.client, client);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* settle
+* purpose: fill in the answer to one of a client's commands, and move every
+*          answer no longer waiting on an earlier one to its output
+*
+* parameters: 1) a Client reference, the client
+*             2) a uint64_t, the command's number
+*             3) a string reference, the answer; swapped out
+* returns: none
+*/
+void QueryServer::settle(Client &client, uint64_t seq, string &text)
+{
+    Slot &slot = client.slots[seq - client.first_seq];
+    slot.done = true;
+    slot.text.swap(text);
+
+    while (not client.slots.empty() and client.slots.front().done) {
+        client.output += client.slots.front().text;
+        client.slots.pop_front();
+        client.first_seq++;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* write_client
+* purpose: send a client as much of its output as it will take
+*
+* parameters: 1) a uint64_t, the client's key
+*             2) a Client reference, the client
+* returns: none
+*
+* notes: epoll watches for room to write only while output is left over
+*/
+void QueryServer::write_client(uint64_t id, Client &client)
+{
+    if (client.broken) return;
+
+    while (client.written < client.output.size()) {
+        ssize_t sent = send(client.fd, client.output.data() + client.written,
+                            client.output.size() - client.written,
+                            MSG_NOSIGNAL);
+        if (sent >= 0) {
+            client.written += sent;
+        } else if (errno == EAGAIN or errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            break_client(client);
+            return;
+        }
+    }
+
+    if (client.written == client.output.size()) {
+        client.output.clear();
+        client.written = 0;
+    } else if (client.written >= COMPACT_AT) {
+        client.output.erase(0, client.written);
+        client.written = 0;
+    }
+    update_events(id, client);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* update_events
+* purpose: watch a client for input while it is read from, and for room to
+*          write while it has output waiting
+*
+* parameters: 1) a uint64_t, the client's key
+*             2) a Client reference, the client
+* returns: none
+*/
+void QueryServer::update_events(uint64_t id, Client &client)
+{
+    if (client.broken) return;
+
+    uint32_t wanted = 0;
+    if (client.reading) wanted |= EPOLLIN;
+    if (not client.output.empty()) wanted |= EPOLLOUT;
+    if (wanted == client.events) return;
+
+    epoll_event event;
+    event.events = wanted;
+    event.data.u64 = id;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, client.fd, &event) == 0) {
+        client.events = wanted;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* break_client
+* purpose: give up on a client whose connection failed
+*
+* parameters: a Client reference, the client
+* returns: none
+*
+* notes: its pending output and answers are dropped, and it is no longer
+*        polled; it is closed once none of its queries are running
+*/
+void QueryServer::break_client(Client &client)
+{
+    if (client.broken) return;
+
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+    client.broken = true;
+    client.reading = false;
+    client.events = 0;
+    client.input.clear();
+    client.output.clear();
+    client.written = 0;
+    client.slots.clear();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* close_if_done
+* purpose: close a client once nothing more will be read from or written
+*          to it
+*
+* parameters: 1) a uint64_t, the client's key
+*             2) a Client reference, the client; gone if closed
+* returns: a bool, true iff the client was closed
+*/
+bool QueryServer::close_if_done(uint64_t id, Client &client)
+{
+    bool finished = client.broken or
+                    (not client.reading and client.slots.empty() and
+                     client.output.empty());
+    if (not finished or client.in_flight > 0) return false;
+
+    if (not client.broken) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+    }
+    close(client.fd);
+    clients.erase(id);
+    return true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* close_all
+* purpose: drop every connection and everything queued for it
+*
+* parameters: none
+* returns: none
+*
+* notes: the workers must be idle
+*/
+void QueryServer::close_all()
+{
+    for (auto &entry : clients) {
+        close(entry.second->fd);
+    }
+    clients.clear();
+    backlog.clear();
+    answers.clear();
+    in_flight = 0;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* release
+* purpose: close the server's descriptors and remove the socket file, if
+*          this server made it
+*
+* parameters: none
+* returns: none
+*/
+void QueryServer::release()
+{
+    if (wake_fd >= 0) close(wake_fd);
+    if (epoll_fd >= 0) close(epoll_fd);
+    if (listen_fd >= 0) close(listen_fd);
+    if (bound) unlink(socket_path.c_str());
+
+    wake_fd = epoll_fd = listen_fd = -1;
+    bound = false;
+}
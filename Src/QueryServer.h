@@ -0,0 +1,155 @@
+/**
+** QueryServer.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Serve the command protocol to many clients at once over a Unix domain
+**   socket, so a graph loaded once answers lookups from any number of
+**   processes without each of them paying to build it.
+**
+** Notes:
+**   1) One thread multiplexes every connection with epoll: it accepts
+**      clients, reads their command lines, and writes their answers. The
+**      queries themselves run on a WorkerPool, each worker with its own
+**      TraversalContext
+**   2) Clients speak the command-file protocol, and each client gets back
+**      exactly what a run over its own commands would print, in the order
+**      it sent them, however the queries of all clients are interleaved
+**      on the workers; only "quit" differs (see 4)
+**   3) Commands for which runs_alone is true (catalog updates, stats)
+**      wait for every query received before them, from any client, and
+**      run on the serving thread before any query received after them
+**   4) A client's connection closes once its answers are written, after
+**      it sends "quit" (the rest of its input is ignored) or shuts down
+**      its side; a "not" cut off by the end of its input still runs
+**   5) stop may be called from a signal handler or another thread; run
+**      then returns once the queries being answered are done, dropping
+**      connections without writing anything more to them
+**   6) The constructor throws a runtime_error if the socket cannot be
+**      made; a stale socket file at the path is replaced. The destructor
+**      removes the socket file
+**
+** ChangeLog:
+**     April 2025:
+**       QueryServer class created
+**/
+
+#ifndef __QUERY_SERVER__
+#define __QUERY_SERVER__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommandParser.h"
+#include "TraversalContext.h"
+
+class WorkerPool;
+
+class QueryServer {
+
+public:
+    /* what the server does with the commands it receives */
+    struct Handlers {
+        /* answer a query; called on worker threads, concurrently */
+        std::function<void(const Command &, TraversalContext &,
+                           std::ostream &)> query;
+        /* whether a command must not overlap any other */
+        std::function<bool(const Command &)> runs_alone;
+        /* run such a command; called on the serving thread */
+        std::function<void(const Command &, std::ostream &)> alone;
+    };
+
+    QueryServer(const std::string &path, size_t num_threads);
+    ~QueryServer();
+
+    const std::string &path() const { return socket_path; }
+
+    void run(const Handlers &handlers);
+    void stop();
+
+private:
+    /* an answer owed to a client, written once it and those before are
+     * done */
+    struct Slot {
+        bool done;
+        std::string text;
+    };
+
+    struct Client {
+        int fd;
+        CommandParser parser;
+        std::string input;             // bytes not yet split into lines
+        std::string output;            // answers not yet written
+        size_t written;                // bytes of output already sent
+        std::deque<Slot> slots;        // answers owed, in command order
+        uint64_t first_seq;            // command number of slots.front()
+        uint64_t next_seq;             // number the next command gets
+        size_t in_flight;              // queries on the workers
+        bool reading;                  // false after quit or end of input
+        bool broken;                   // the connection failed
+        uint32_t events;               // what epoll watches it for
+    };
+
+    /* a command waiting its turn to be dispatched */
+    struct Job {
+        uint64_t client;
+        uint64_t seq;
+        Command command;
+    };
+
+    /* a query a worker has answered */
+    struct Answer {
+        uint64_t client;
+        uint64_t seq;
+        std::string text;
+    };
+
+    std::string socket_path;
+    size_t num_threads;
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+    bool bound;
+    std::atomic<bool> stopping;
+
+    const Handlers *handlers;
+    std::unique_ptr<WorkerPool> pool;
+    std::vector<TraversalContext> contexts;
+
+    std::unordered_map<uint64_t, std::unique_ptr<Client>> clients;
+    uint64_t next_client;
+    std::deque<Job> backlog;
+    size_t in_flight;
+
+    std::mutex answers_lock;
+    std::vector<Answer> answers;
+
+    void accept_clients();
+    void read_client(uint64_t id, Client &client);
+    void take_line(uint64_t id, Client &client, const std::string &line);
+    void queue_command(uint64_t id, Client &client, Command &command);
+    void dispatch();
+    void collect_answers();
+    void settle(Client &client, uint64_t seq, std::string &text);
+    void write_client(uint64_t id, Client &client);
+    void update_events(uint64_t id, Client &client);
+    void break_client(Client &client);
+    bool close_if_done(uint64_t id, Client &client);
+    void close_all();
+    void release();
+
+    QueryServer(const QueryServer &);
+    QueryServer &operator=(const QueryServer &);
+};
+
+#endif /* __QUERY_SERVER__ */
@@ -0,0 +1,234 @@
+/**
+** QueryStats.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Record command and phase latencies and traversal counts, and report
+**   their percentiles.
+**
+** ChangeLog:
+**     April 2025:
+**       QueryStats class created
+**/
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+#include "QueryStats.h"
+
+using namespace std;
+
+const size_t QueryStats::NUM_COMMANDS;
+
+const char *const QueryStats::COMMANDS[NUM_COMMANDS] = {
+    "bfs", "dfs", "not", "songs", "dist", "components", "critical",
+    "add-artist", "remove-artist", "add-song", "remove-song"
+};
+
+namespace {
+
+/* the names the phases are reported under */
+const char *const PHASE_NAMES[QueryStats::NUM_PHASES] = {
+    "lookup", "answer", "output"
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* report_line
+* purpose: write one histogram's count and percentiles
+*
+* parameters: 1) a std::ostream reference, the stream to write to
+*             2) a const char pointer, the name to write it under
+*             3) a const LatencyHistogram reference, the histogram
+* returns: none
+*
+* notes: times are written in microseconds; nothing is written for a
+*        histogram with no timings
+*/
+void report_line(ostream &out, const char *name,
+                 const LatencyHistogram &histogram)
+{
+    uint64_t count = histogram.count();
+    if (count == 0) return;
+
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << name << ": " << count << (count == 1 ? " run" : " runs")
+        << fixed << setprecision(1)
+        << ", p50 " << histogram.percentile(0.50) / 1000.0 << " us"
+        << ", p99 " << histogram.percentile(0.99) / 1000.0 << " us"
+        << ", max " << histogram.max() / 1000.0 << " us.\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* lap
+* purpose: read the time since the last lap and start a new one
+*
+* parameters: none
+* returns: a uint64_t, the nanoseconds since the stopwatch was made or
+*          last lapped
+*/
+uint64_t QueryStats::Stopwatch::lap()
+{
+    Clock::time_point now = Clock::now();
+    uint64_t elapsed =
+        chrono::duration_cast<chrono::nanoseconds>(now - lap_start).count();
+    lap_start = now;
+
+    return elapsed;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* total
+* purpose: read the time since the stopwatch was made
+*
+* parameters: none
+* returns: a uint64_t, the nanoseconds up to the last lap
+*
+* notes: ends at the last lap, so the laps of a query add up to its total
+*/
+uint64_t QueryStats::Stopwatch::total() const
+{
+    return chrono::duration_cast<chrono::nanoseconds>(lap_start - start).count();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize statistics that are not being collected
+*
+* @preconditions: none
+* @postconditions: nothing is recorded until enable(true) is called
+*
+* @parameters: none
+*/
+QueryStats::QueryStats()
+    : collecting(false), visited(0), scanned(0), queue_peak(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* record
+* purpose: count how long a command took
+*
+* parameters: 1) a const string reference, the command's name
+*             2) a uint64_t, the time it took, in nanoseconds
+* returns: none
+*/
+void QueryStats::record(const string &command, uint64_t nanoseconds)
+{
+    size_t kind = 0;
+    while (kind < NUM_COMMANDS and command != COMMANDS[kind]) kind++;
+
+    commands[kind].record(nanoseconds);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* record_phase
+* purpose: count how long one phase of a query took
+*
+* parameters: 1) a Phase, the phase
+*             2) a uint64_t, the time it took, in nanoseconds
+* returns: none
+*/
+void QueryStats::record_phase(Phase phase, uint64_t nanoseconds)
+{
+    phases[phase].record(nanoseconds);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* add_counts
+* purpose: add the work one query's searches did to the totals
+*
+* parameters: a const TraversalContext::Counts reference, the work
+* returns: none
+*/
+void QueryStats::add_counts(const TraversalContext::Counts &counts)
+{
+    visited.fetch_add(counts.visited, memory_order_relaxed);
+    scanned.fetch_add(counts.scanned, memory_order_relaxed);
+
+    uint64_t peak = queue_peak.load(memory_order_relaxed);
+    while (counts.queue_peak > peak and
+           not queue_peak.compare_exchange_weak(peak, counts.queue_peak,
+                                                memory_order_relaxed)) {
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* clear
+* purpose: forget everything recorded so far
+*
+* parameters: none
+* returns: none
+*/
+void QueryStats::clear()
+{
+    for (LatencyHistogram &histogram : commands) histogram.clear();
+    for (LatencyHistogram &histogram : phases) histogram.clear();
+    visited.store(0, memory_order_relaxed);
+    scanned.store(0, memory_order_relaxed);
+    queue_peak.store(0, memory_order_relaxed);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* report
+* purpose: write the percentiles of every histogram with timings, then the
+*          traversal totals
+*
+* parameters: a std::ostream reference, the stream to write to
+* returns: none
+*
+* notes: one line per command name in the order of COMMANDS, then "other"
+*        for names that are not commands, then one per phase
+*/
+void QueryStats::report(ostream &out) const
+{
+    bool any = false;
+    for (const LatencyHistogram &histogram : commands) {
+        any = any or histogram.count() > 0;
+    }
+    if (not any) {
+        out << "No commands have been timed.\n";
+        return;
+    }
+
+    for (size_t kind = 0; kind < NUM_COMMANDS; kind++) {
+        report_line(out, COMMANDS[kind], commands[kind]);
+    }
+    report_line(out, "other", commands[NUM_COMMANDS]);
+    for (int phase = 0; phase < NUM_PHASES; phase++) {
+        report_line(out, PHASE_NAMES[phase], phases[phase]);
+    }
+
+    out << "Searches visited " << visited.load(memory_order_relaxed)
+        << " artists and scanned " << scanned.load(memory_order_relaxed)
+        << " collaborations; the most waiting at once was "
+        << queue_peak.load(memory_order_relaxed) << ".\n";
+}
@@ -0,0 +1,89 @@
+/**
+** QueryStats.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Keep latency histograms of every kind of command and of the phases
+**   a query goes through, with totals of the work the searches did, so a
+**   slow query can be pinned on the search, the artist lookups or the
+**   writing of its answer.
+**
+** Notes:
+**   1) Every command name has its own histogram, with one shared by the
+**      names that are not commands; so do the three phases of a query:
+**      looking up its artists, answering it (searching and formatting
+**      the answer) and writing the answer out
+**   2) Traversal counts (TraversalContext::Counts) are summed, apart from
+**      the queue peak, which is the largest any one query reached
+**   3) Collecting is off until enable is called; callers check enabled()
+**      and skip reading the clock altogether while it is off
+**   4) Recording only touches atomic counters, so the threads of
+**      SixDegrees::run_batch all record into one QueryStats
+**
+** ChangeLog:
+**     April 2025:
+**       QueryStats class created
+**/
+
+#ifndef __QUERY_STATS__
+#define __QUERY_STATS__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "LatencyHistogram.h"
+#include "TraversalContext.h"
+
+class QueryStats {
+
+public:
+    /* the phases of a query */
+    enum Phase { LOOKUP, ANSWER, OUTPUT, NUM_PHASES };
+
+    /* measures the time since it was made or last lapped */
+    class Stopwatch {
+    public:
+        Stopwatch() : start(Clock::now()), lap_start(start) {}
+
+        uint64_t lap();
+        uint64_t total() const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point start;
+        Clock::time_point lap_start;
+    };
+
+    QueryStats();
+
+    void enable(bool on) { collecting = on; }
+    bool enabled() const { return collecting; }
+
+    void record(const std::string &command, uint64_t nanoseconds);
+    void record_phase(Phase phase, uint64_t nanoseconds);
+    void add_counts(const TraversalContext::Counts &counts);
+
+    void clear();
+    void report(std::ostream &out) const;
+
+private:
+    /* the command names with histograms of their own (see COMMANDS in
+     * QueryStats.cpp); any other name counts in the last histogram */
+    static const size_t NUM_COMMANDS = 11;
+    static const char *const COMMANDS[NUM_COMMANDS];
+
+    bool collecting;
+
+    LatencyHistogram commands[NUM_COMMANDS + 1];
+    LatencyHistogram phases[NUM_PHASES];
+
+    std::atomic<uint64_t> visited;
+    std::atomic<uint64_t> scanned;
+    std::atomic<uint64_t> queue_peak;
+};
+
+#endif /* __QUERY_STATS__ */
@@ -0,0 +1,274 @@
+/**
+** ResultCache.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Remember the formatted output of recent queries, within a byte
+**   budget, forgetting the least recently used answers first.
+**
+** ChangeLog:
+**     April 2025:
+**       ResultCache class created
+**/
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ResultCache.h"
+
+using namespace std;
+
+typedef ResultCache::VertexId VertexId;
+
+const size_t ResultCache::NUM_SHARDS;
+
+/*********************************************************************
+ ******************** helper function definitions ********************
+*********************************************************************/
+
+namespace {
+
+/* what a list node and a table node cost beyond the Entry itself */
+const size_t NODE_OVERHEAD = 64;
+
+/* 64-bit FNV-1a step */
+inline uint64_t mix(uint64_t hash, uint64_t word)
+{
+    return (hash ^ word) * 0x100000001b3ULL;
+}
+
+/* spread the bits of a hash over the whole word, so shards and table
+ * buckets can each take a different part of it */
+inline uint64_t finish(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Key constructor
+* purpose: describe a query, putting its exclude list in canonical order
+*
+* parameters: 1) a const string reference, the command name
+*             2) a VertexId, the source artist
+*             3) a VertexId, the destination artist
+*             4) a const vector<VertexId> reference, the excluded artists
+*                in any order, repeats allowed
+*/
+ResultCache::Key::Key(const string &command, VertexId source, VertexId dest,
+                      const vector<VertexId> &exclude)
+    : command(command), source(source), dest(dest), exclude(exclude)
+{
+    sort(this->exclude.begin(), this->exclude.end());
+    this->exclude.erase(unique(this->exclude.begin(), this->exclude.end()),
+                        this->exclude.end());
+
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : command) h = mix(h, static_cast<unsigned char>(c));
+    h = mix(h, (uint64_t(source) << 32) | dest);
+    for (VertexId v : this->exclude) h = mix(h, v);
+    hash = finish(mix(h, this->exclude.size()));
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Key equality
+* purpose: determine whether two keys describe the same query
+*
+* parameters: a const Key reference, the other key
+* returns: a bool, true iff every field matches
+*/
+bool ResultCache::Key::operator==(const Key &other) const
+{
+    return hash == other.hash and source == other.source and
+           dest == other.dest and command == other.command and
+           exclude == other.exclude;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* constructor
+* purpose: initialize an empty cache
+*
+* parameters: a size_t, the most bytes the cache may hold; 0 turns it off
+*/
+ResultCache::ResultCache(size_t budget)
+    : budget_bytes(budget), hit_count(0), miss_count(0)
+{
+    for (Shard &shard : shards) shard.bytes = 0;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* set_budget
+* purpose: change how many bytes the cache may hold
+*
+* parameters: a size_t, the new budget; 0 turns the cache off
+* returns: none
+*
+* notes: empties the cache and resets its counters. Not safe while other
+*        threads use the cache
+*/
+void ResultCache::set_budget(size_t bytes)
+{
+    budget_bytes = bytes;
+    clear();
+    hit_count = 0;
+    miss_count = 0;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* lookup
+* purpose: find the remembered answer to a query
+*
+* parameters: 1) a const Key reference, the query
+*             2) a string reference, set to the answer on a hit
+* returns: a bool, true on a hit, which also makes the entry the most
+*          recently used of its shard
+*/
+bool ResultCache::lookup(const Key &key, string &result)
+{
+    if (not enabled()) return false;
+
+    Shard &shard = shard_of(key);
+    {
+        lock_guard<mutex> guard(shard.lock);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            shard.recent.splice(shard.recent.begin(), shard.recent,
+                                found->second);
+            result = found->second->result;
+            hit_count++;
+            return true;
+        }
+    }
+
+    miss_count++;
+    return false;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert
+* purpose: remember the answer to a query
+*
+* parameters: 1) a const Key reference, the query
+*             2) a const string reference, its answer
+* returns: none
+*
+* notes: evicts the least recently used entries of the shard until the new
+*        one fits. A query already cached (another thread may have answered
+*        it first) keeps its entry
+*/
+void ResultCache::insert(const Key &key, const string &result)
+{
+    if (not enabled()) return;
+
+    /* the key is held twice, in the entry and in the table */
+    size_t key_bytes = key.command.size() +
+                       key.exclude.size() * sizeof(VertexId);
+    size_t cost = sizeof(Entry) + sizeof(Key) + NODE_OVERHEAD +
+                  2 * key_bytes + result.size();
+    size_t shard_budget = budget_bytes / NUM_SHARDS;
+    if (cost > shard_budget) return;
+
+    Shard &shard = shard_of(key);
+    lock_guard<mutex> guard(shard.lock);
+    if (shard.index.count(key) > 0) return;
+
+    while (shard.bytes + cost > shard_budget) {
+        Entry &oldest = shard.recent.back();
+        shard.bytes -= oldest.cost;
+        shard.index.erase(oldest.key);
+        shard.recent.pop_back();
+    }
+
+    Entry entry = { key, result, cost };
+    shard.recent.push_front(entry);
+    shard.index[key] = shard.recent.begin();
+    shard.bytes += cost;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* clear
+* purpose: forget every answer
+*
+* parameters: none
+* returns: none
+*
+* notes: the hit and miss counters are kept
+*/
+void ResultCache::clear()
+{
+    for (Shard &shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        shard.index.clear();
+        shard.recent.clear();
+        shard.bytes = 0;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* size
+* purpose: count the answers the cache holds
+*
+* parameters: none
+* returns: a size_t, the number of entries
+*/
+size_t ResultCache::size() const
+{
+    size_t entries = 0;
+    for (const Shard &shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        entries += shard.index.size();
+    }
+
+    return entries;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* bytes
+* purpose: measure how much of the budget is in use
+*
+* parameters: none
+* returns: a size_t, the bytes charged for the entries held
+*/
+size_t ResultCache::bytes() const
+{
+    size_t total = 0;
+    for (const Shard &shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.bytes;
+    }
+
+    return total;
+}
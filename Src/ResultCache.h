@@ -0,0 +1,110 @@
+/**
+** ResultCache.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Remember the formatted output of recent queries, so a command stream
+**   that asks the same question again is answered without a search. The
+**   cache holds at most a fixed number of bytes and forgets the least
+**   recently used answers first.
+**
+** Notes:
+**   1) A query is its command name, source and destination ids, and for
+**      "not" the set of excluded ids: sorted and deduplicated, so lists
+**      naming the same artists in another order or twice share an entry.
+**      The key hash covers the whole set, and keys are compared in full,
+**      so two different queries never share an answer
+**   2) Entries are split over several shards by key hash, each with its
+**      own lock, recency list and share of the byte budget, so the
+**      threads of SixDegrees::run_batch rarely wait on each other
+**   3) An entry is charged for its answer, both copies of its key (one
+**      in the recency list, one in the table) and a fixed overhead for
+**      the nodes; an answer too big for its shard is not kept
+**   4) Answers depend on the graph and on how it is searched; the owner
+**      must clear the cache whenever either changes
+**   5) A budget of 0 turns the cache off: nothing is kept or counted
+**
+** ChangeLog:
+**     April 2025:
+**       ResultCache class created
+**/
+
+#ifndef __RESULT_CACHE__
+#define __RESULT_CACHE__
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class ResultCache {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+
+    struct Key {
+        std::string command;
+        VertexId source;
+        VertexId dest;
+        std::vector<VertexId> exclude;      // sorted, no repeats
+        uint64_t hash;
+
+        Key(const std::string &command, VertexId source, VertexId dest,
+            const std::vector<VertexId> &exclude = std::vector<VertexId>());
+
+        bool operator==(const Key &other) const;
+    };
+
+    explicit ResultCache(size_t budget = 0);
+
+    void   set_budget(size_t bytes);
+    size_t budget() const { return budget_bytes; }
+    bool   enabled() const { return budget_bytes > 0; }
+
+    bool lookup(const Key &key, std::string &result);
+    void insert(const Key &key, const std::string &result);
+    void clear();
+
+    uint64_t hits() const { return hit_count; }
+    uint64_t misses() const { return miss_count; }
+    size_t   size() const;
+    size_t   bytes() const;
+
+private:
+    static const size_t NUM_SHARDS = 16;
+
+    struct Entry {
+        Key key;
+        std::string result;
+        size_t cost;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const { return key.hash; }
+    };
+
+    struct Shard {
+        mutable std::mutex lock;
+        std::list<Entry> recent;            // most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        size_t bytes;
+    };
+
+    size_t budget_bytes;
+    Shard shards[NUM_SHARDS];
+    std::atomic<uint64_t> hit_count;
+    std::atomic<uint64_t> miss_count;
+
+    Shard &shard_of(const Key &key)
+    {
+        return shards[(key.hash >> 32) % NUM_SHARDS];
+    }
+};
+
+#endif /* __RESULT_CACHE__ */
@@ -5,207 +5,1340 @@
 **
 ** Purpose:
 **   Implements the SixDegrees class to manage a collaboration graph of artists,
-**   process commands (bfs, dfs, not, quit), and output paths of collaborations
-**   between artists based on the provided input.
+**   process commands (bfs, dfs, not, songs, dist, components, critical,
+**   stats, flush, quit, and the catalog updates add-artist, remove-artist,
+**   add-song and remove-song), and output paths of collaborations between
+**   artists based on the provided input.
 **
-**       
+** ChangeLog:
 **     April 2025:
+**       Queries run on a frozen CSR graph, optionally on worker threads
+**       Added search engines, landmarks, distance labels, a result cache
+**       and pooled search trees
+**       Added catalog updates, components, critical and stats commands
+**       Output is buffered; queries can be served over a socket
+**       Populated graphs can be renumbered for locality
 **/
 
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <vector>
-#include <queue>
 #include <stack>
 #include <sstream>
+#include <algorithm>
+#include <unordered_map>
 
 #include "SixDegrees.h"
 #include "Artist.h"
 #include "CollabGraph.h"
+#include "BidirectionalSearch.h"
+#include "DirectionOptimizingBFS.h"
+#include "GraphBuilder.h"
+#include "LandmarkSearch.h"
+#include "GraphSnapshot.h"
+#include "LineScanner.h"
+#include "MappedFile.h"
+#include "CommandParser.h"
+#include "OutputBuffer.h"
+#include "QueryServer.h"
+#include "WorkerPool.h"
 
 using namespace std;
 
+const size_t SixDegrees::BATCH_SIZE;
+const size_t SixDegrees::DEFAULT_LANDMARKS;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: initialize a SixDegrees instance
+*
+* @preconditions: none
+* @postconditions: a new SixDegrees instance is created with an empty collaboration graph
+*
+* @parameters: none
+* @returns: none
+*/
+SixDegrees::SixDegrees()
+    : search_mode_(CLASSIC_SEARCH), num_landmarks_(0), use_labels_(false),
+      interactive_(false), vertex_order_(VertexOrder::INSERTION_ORDER) {
+    // Initialize empty CollabGraph
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_search_mode
+* @purpose: choose the engine that bfs and not use to find shortest paths
+*
+* @preconditions: none
+* @postconditions: later bfs and not commands use the given engine
+*
+* @parameters: a SearchMode, CLASSIC_SEARCH, BIDIRECTIONAL_SEARCH, DIRECTION_OPTIMIZING_SEARCH, LANDMARK_SEARCH or LABEL_SEARCH
+* @returns: none
+*
+* @notes: every engine finds a shortest path; when there are several, only
+*         CLASSIC_SEARCH is guaranteed to pick the one earlier versions did.
+*         LANDMARK_SEARCH is only as well steered as the landmarks set by
+*         set_landmarks; without any it searches breadth-first.
+*         LABEL_SEARCH needs labels (see set_labels) and otherwise, or
+*         when a label path runs through an excluded artist, falls back
+*         to BIDIRECTIONAL_SEARCH
+*/
+void SixDegrees::set_search_mode(SearchMode mode) {
+    search_mode_ = mode;
+    cache_.clear();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_landmarks
+* @purpose: choose how many landmark artists to precompute distances from
+*
+* @preconditions: none
+* @postconditions: the landmarks of the current graph are rebuilt, and are
+*                  rebuilt again each time the graph is populated or loaded
+*
+* @parameters: a size_t, the number of landmarks; 0 drops them
+* @returns: none
+*
+* @notes: costs one breadth-first search of the graph per landmark
+*/
+void SixDegrees::set_landmarks(size_t num_landmarks) {
+    num_landmarks_ = num_landmarks;
+    landmarks_.build(frozen_, num_landmarks_);
+    cache_.clear();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_labels
+* @purpose: turn the exact distance labels on or off
+*
+* @preconditions: none
+* @postconditions: with labels on, the current graph is labelled (unless it
+*                  already is) and so is every graph populated later; with
+*                  them off, any labels are dropped
+*
+* @parameters: a bool, whether to keep distance labels
+* @returns: none
+*
+* @notes: labelling costs a pruned breadth-first search per artist, most of
+*         them tiny on graphs with well-connected hubs
+*/
+void SixDegrees::set_labels(bool use_labels) {
+    use_labels_ = use_labels;
+    if (!use_labels_) {
+        labels_ = DistanceLabels();
+    } else if (labels_.empty()) {
+        labels_.build(frozen_);
+    }
+    cache_.clear();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_cache_budget
+* @purpose: size the cache of query answers
+*
+* @preconditions: no commands are running
+* @postconditions: the cache is empty, holds at most 'bytes' bytes from now
+*                  on, and its hit and miss counts start over
+*
+* @parameters: a size_t, the budget in bytes; 0 turns the cache off
+* @returns: none
+*/
+void SixDegrees::set_cache_budget(size_t bytes) {
+    cache_.set_budget(bytes);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_tree_pool
+* @purpose: size the pool of search trees kept for bfs sources
+*
+* @preconditions: no commands are running
+* @postconditions: bfs keeps the trees of up to 'num_trees' recent sources,
+*                  dropping the least recently used when the pool is full
+*
+* @parameters: a size_t, the number of trees; 0 turns the pool off
+* @returns: none
+*
+* @notes: each tree costs eight bytes per artist
+*/
+void SixDegrees::set_tree_pool(size_t num_trees) {
+    trees_.set_capacity(num_trees);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_interactive
+* @purpose: choose whether run flushes its output after every command
+*
+* @preconditions: no commands are running
+* @postconditions: later runs flush after every command if 'interactive'
+*                  is true; otherwise only when the buffer fills, on a
+*                  flush command, at the end of each batch and at the end
+*
+* @parameters: a bool, whether someone is waiting on each answer
+* @returns: none
+*/
+void SixDegrees::set_interactive(bool interactive) {
+    interactive_ = interactive;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_stats
+* @purpose: start or stop timing commands and counting search work
+*
+* @preconditions: no commands are running
+* @postconditions: everything collected so far is forgotten; from now on
+*                  every command is timed, and so are the lookup, answer and
+*                  output phases of every query, if 'collect' is true
+*
+* @parameters: a bool, whether to collect
+* @returns: none
+*
+* @notes: while off, commands never read the clock
+*/
+void SixDegrees::set_stats(bool collect) {
+    stats_.clear();
+    stats_.enable(collect);
+    context_.take_counts();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: print_stats
+* @purpose: report the latencies and search work collected by set_stats
+*
+* @preconditions: none
+* @postconditions: one line per kind of command and per phase that was
+*                  timed, with its p50, p99 and max, then the search totals
+*                  are printed; or one line saying nothing is collected
+*
+* @parameters: a std::ostream reference, the output stream for the report
+* @returns: none
+*/
+void SixDegrees::print_stats(ostream &out) const {
+    if (!stats_.enabled()) {
+        out << "Statistics are not being collected.\n";
+        return;
+    }
+    stats_.report(out);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: set_vertex_order
+* @purpose: choose how the artists of a populated graph are numbered
+*
+* @preconditions: none
+* @postconditions: every graph populated from now on is renumbered by the
+*                  given method before it is indexed; the current graph is
+*                  left as it is
+*
+* @parameters: a VertexOrder::Method, INSERTION_ORDER (the default, data
+*              file order), BFS_ORDER, RCM_ORDER or HUB_ORDER
+* @returns: none
+*
+* @notes: distances, songs and components are the same in any order, and
+*         paths as short; a search may pick another path of the same
+*         length, and commands that list artists may list them in another
+*         order, but the same way on every run
+*/
+void SixDegrees::set_vertex_order(VertexOrder::Method method) {
+    vertex_order_ = method;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: print_cache_stats
+* @purpose: report how well the cache of query answers is doing
+*
+* @preconditions: none
+* @postconditions: one line with the hit and miss counts and the cache's
+*                  size is printed
+*
+* @parameters: a std::ostream reference, the output stream for the report
+* @returns: none
+*/
+void SixDegrees::print_cache_stats(ostream &out) const {
+    out << "Result cache: " << cache_.hits() << " hits, "
+        << cache_.misses() << " misses, " << cache_.size() << " entries, "
+        << cache_.bytes() << " of " << cache_.budget() << " bytes" << endl;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: populate_graph
+* @purpose: build the collaboration graph from input data
+*
+* @preconditions: none
+* @postconditions: the collaboration graph is populated with vertices (artists) and edges (songs) based on the input data,
+*                  then frozen into the compact form that queries run on
+*
+* @parameters: a std::istream reference, the input stream containing artist names, songs, and '*' delimiters
+* @returns: none
+*
+* @notes: the stream is read into memory in one go and scanned like a mapped
+*         file (see build_graph); populate_graph_from_file skips that copy
+*/
+void SixDegrees::populate_graph(istream &data_stream) {
+    ostringstream contents;
+    contents << data_stream.rdbuf();
+    const string data = contents.str();
+
+    build_graph(data.data(), data.data() + data.size());
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: populate_graph_from_file
+* @purpose: build the collaboration graph from a data file, scanning it in place
+*
+* @preconditions: none
+* @postconditions: the graph is populated exactly as populate_graph would populate it from the same file
+*
+* @parameters: a const std::string reference, the path of the data file
+* @returns: a bool, false if the file cannot be opened or mapped; the graph
+*           is left as it was then
+*
+* @notes: a regular file is memory-mapped for the duration of the build, so
+*         names and songs are only copied once, into the frozen graph's
+*         tables. Anything else, such as a pipe, is read through a stream
+*         by populate_graph
+*/
+bool SixDegrees::populate_graph_from_file(const string &path) {
+    if (!MappedFile::mappable(path)) {
+        ifstream data_file(path.c_str());
+        if (!data_file.is_open()) {
+            return false;
+        }
+        populate_graph(data_file);
+        return true;
+    }
+
+    unique_ptr<MappedFile> file;
+    try {
+        file.reset(new MappedFile(path));
+    } catch (const runtime_error &e) {
+        return false;
+    }
+    build_graph(file->begin(), file->end());
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: populate_graph_pairwise
+* @purpose: build the collaboration graph by checking every pair of artists
+*
+* @preconditions: none
+* @postconditions: the collaboration graph is populated exactly as populate_graph would populate it
+*
+* @parameters: a std::istream reference, the input stream containing artist names, songs, and '*' delimiters
+* @returns: none
+*
+* @notes: O(N^2 * S) in the number of artists and songs per artist, as
+*         every pair intersects two sorted song sets; kept as the
+*         reference that populate_graph is compared against
+*/
+void SixDegrees::populate_graph_pairwise(istream &data_stream) {
+    vector<Artist> artists;
+
+    // Step 1: Parse input to collect artists and their songs
+    parse_artists(data_stream, artists);
+
+    // Step 2: Create edges by checking collaborations
+    for (size_t i = 0; i < artists.size(); ++i) {
+        const Artist &a1 = artists[i];
+        for (size_t j = i + 1; j < artists.size(); ++j) {
+            const Artist &a2 = artists[j];
+            if (a1 == a2) continue;
+            for (Artist::Symbol song : a1.get_collaborations(a2)) {
+                graph_.insert_edge(a1, a2, Artist::symbols().get(song).str());
+            }
+        }
+    }
+
+    vector<VertexId> new_id = freeze_graph();
+
+    // Step 3: Remember every artist's songs for catalog updates
+    StringPool titles;
+    vector<Catalog::Credit> credits;
+    for (const Artist &artist : artists) {
+        VertexId v = frozen_.find_vertex(artist.get_name());
+        for (Artist::Symbol song : artist.get_discography()) {
+            credits.push_back({ v, titles.intern(Artist::symbols().get(song)) });
+        }
+    }
+    catalog_.build(titles, frozen_.num_vertices(), credits);
+    if (!new_id.empty()) {
+        catalog_.set_record_order(new_id);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: print_graph
+* @purpose: print every artist in the collaboration graph along with its edges
+*
+* @preconditions: none
+* @postconditions: the graph is written to the output stream
+*
+* @parameters: a std::ostream reference, where output is sent
+* @returns: none
+*/
+void SixDegrees::print_graph(ostream &out) {
+    frozen_.print_graph(out);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: save_snapshot
+* @purpose: write the frozen graph to a binary snapshot file
+*
+* @preconditions: the graph has been populated or loaded
+* @postconditions: the file at 'path' holds a snapshot that load_snapshot can map
+*
+* @parameters: a const std::string reference, the path of the snapshot file
+* @returns: none
+*
+* @notes: distance labels, if there are any, are saved with the graph.
+*         throws a runtime_error if the file cannot be written
+*/
+void SixDegrees::save_snapshot(const string &path) const {
+    GraphSnapshot::save(frozen_, path, &labels_);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: load_snapshot
+* @purpose: serve queries from a snapshot file instead of populating the graph
+*
+* @preconditions: none
+* @postconditions: the frozen graph is the one in the snapshot, read straight
+*                  from a memory mapping of the file; any earlier graph is dropped
+*
+* @parameters: a const std::string reference, the path of the snapshot file
+* @returns: none
+*
+* @notes: distance labels saved with the graph are used as they are. The
+*         snapshot does not say who sings songs no two artists share, so
+*         the first catalog update works from the shared songs alone (see
+*         Catalog::derive).
+*         throws a runtime_error if the file is missing, damaged or of another version
+*/
+void SixDegrees::load_snapshot(const string &path) {
+    frozen_ = GraphSnapshot::load(path, &labels_);
+    graph_ = CollabGraph();
+    catalog_ = Catalog();
+    build_indexes();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: freeze_graph
+* @purpose: compact the graph built by populate_graph into its CSR form for querying
+*
+* @preconditions: the build-time graph holds every artist and collaboration
+* @postconditions: the frozen graph holds the same artists and edges, and the build-time graph is emptied to release its memory
+*
+* @parameters: none
+* @returns: a vector of VertexIds, the new id of every artist if the
+*           frozen graph was renumbered (see reorder_graph), or nothing
+*/
+vector<FrozenGraph::VertexId> SixDegrees::freeze_graph() {
+    frozen_ = graph_.freeze();
+    graph_ = CollabGraph();
+    vector<VertexId> new_id = reorder_graph();
+    labels_ = DistanceLabels();
+    build_indexes();
+    return new_id;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: reorder_graph
+* @purpose: renumber the artists of a freshly built frozen graph
+*
+* @preconditions: frozen_ was just built, and nothing indexes it yet
+* @postconditions: frozen_ holds the same artists and edges, numbered as
+*                  vertex_order_ says
+*
+* @parameters: none
+* @returns: a vector of VertexIds, the new id of every old one, or an
+*           empty vector if vertex_order_ keeps them
+*/
+vector<FrozenGraph::VertexId> SixDegrees::reorder_graph() {
+    vector<VertexId> new_id;
+    if (vertex_order_ != VertexOrder::INSERTION_ORDER) {
+        new_id = VertexOrder::compute(frozen_, vertex_order_);
+        frozen_ = VertexOrder::relabel(frozen_, new_id);
+    }
+    return new_id;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: build_indexes
+* @purpose: rebuild the component, block and distance indexes over a new frozen graph
+*
+* @preconditions: frozen_ holds the graph being queried; labels_ is empty
+*                 or already labels frozen_
+* @postconditions: components_, blocks_ and landmarks_ match frozen_, the latter
+*                  with num_landmarks_ landmarks
+*                  (or as many as there are artists), labels_ labels
+*                  frozen_ if labels are on, and no answers, search
+*                  trees or editor of an earlier graph are kept
+*
+* @parameters: none
+* @returns: none
+*/
+void SixDegrees::build_indexes() {
+    components_.build(frozen_);
+    blocks_.build(frozen_);
+    landmarks_.build(frozen_, num_landmarks_);
+    if (use_labels_ && labels_.empty()) {
+        labels_.build(frozen_);
+    }
+    cache_.clear();
+    trees_.clear();
+    editor_.reset();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: build_graph
+* @purpose: parse artist records out of a block of memory and build the frozen graph from them
+*
+* @preconditions: none
+* @postconditions: the frozen graph holds every named artist, with an edge between every two that share a song
+*
+* @parameters: 1) a const char pointer, the first byte of the data
+*             2) a const char pointer, one past the last byte of the data
+* @returns: none
+*
+* @notes: lines are split as std::getline splits them and are parsed as
+*         parse_artists parses them. names and songs are StringRefs into the
+*         data until the GraphBuilder interns them.
+*         edges are generated from a song -> artists index, so only artists
+*         that actually share a song are ever compared. Pairs are inserted in
+*         the same order as populate_graph_pairwise, and each edge carries
+*         every song the two artists share, in the earlier artist's
+*         discography order, so both builders produce the same graph.
+*/
+void SixDegrees::build_graph(const char *begin, const char *end) {
+    // Step 1: Split the data into artist records; record r sings
+    // songs[first_song[r]] up to songs[first_song[r + 1]]
+    vector<StringRef> names;
+    vector<StringRef> songs;
+    vector<size_t> first_song(1, 0);
+    LineScanner scanner(begin, end);
+    StringRef line, name;
+
+    while (scanner.next(line)) {
+        if (line.empty()) continue;
+
+        if (line.size() == 1 && line[0] == '*') {
+            if (!name.empty()) {
+                names.push_back(name);
+                first_song.push_back(songs.size());
+                name = StringRef();
+            }
+        } else if (name.empty()) {
+            name = line;
+        } else {
+            songs.push_back(line);
+        }
+    }
+
+    // Handle the last artist if the data doesn't end with '*'
+    if (!name.empty()) {
+        names.push_back(name);
+        first_song.push_back(songs.size());
+    }
+
+    GraphBuilder builder;
+    builder.reserve(names.size(), songs.size());
+    vector<VertexId> vertex(names.size());
+    for (size_t r = 0; r < names.size(); ++r) {
+        vertex[r] = builder.insert_vertex(names[r]);
+    }
+
+    // Step 2: Index the songs: the builder numbers each distinct title
+    // 0, 1, 2, ..., then list the records that sing it, in record order
+    // and without repeats
+    vector<uint32_t> song_key(songs.size());
+    size_t num_keys = 0;
+    for (size_t k = 0; k < songs.size(); ++k) {
+        song_key[k] = builder.insert_song(songs[k]);
+        if (song_key[k] == num_keys) num_keys++;
+    }
+
+    const size_t none = names.size();
+    vector<size_t> singers_begin(num_keys + 1, 0);
+    vector<size_t> last_singer(num_keys, none);
+    for (size_t r = 0; r < names.size(); ++r) {
+        for (size_t k = first_song[r]; k < first_song[r + 1]; ++k) {
+            if (last_singer[song_key[k]] != r) {
+                last_singer[song_key[k]] = r;
+                singers_begin[song_key[k] + 1]++;
+            }
+        }
+    }
+    for (size_t key = 0; key < num_keys; ++key) {
+        singers_begin[key + 1] += singers_begin[key];
+    }
+
+    vector<size_t> singers(singers_begin.back());
+    vector<size_t> fill(singers_begin.begin(), singers_begin.end() - 1);
+    last_singer.assign(num_keys, none);
+    for (size_t r = 0; r < names.size(); ++r) {
+        for (size_t k = first_song[r]; k < first_song[r + 1]; ++k) {
+            if (last_singer[song_key[k]] != r) {
+                last_singer[song_key[k]] = r;
+                singers[fill[song_key[k]]++] = r;
+            }
+        }
+    }
+
+    // Step 3: Create edges between artists that appear under the same song,
+    // one per shared song; the builder folds them into one edge per pair
+    vector<size_t> sung_by(num_keys, none);
+    vector<pair<size_t, size_t>> collaborators;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        // Sorting by (collaborator, position) lists each collaborator's
+        // shared songs in this artist's discography order, so the first
+        // is the one get_collaboration would have returned
+        collaborators.clear();
+        for (size_t k = first_song[i]; k < first_song[i + 1]; ++k) {
+            uint32_t key = song_key[k];
+            if (sung_by[key] == i) continue;
+            sung_by[key] = i;
+            for (size_t s = singers_begin[key]; s < singers_begin[key + 1]; ++s) {
+                size_t j = singers[s];
+                if (j > i) {
+                    collaborators.emplace_back(j, k);
+                }
+            }
+        }
+
+        sort(collaborators.begin(), collaborators.end());
+        for (const pair<size_t, size_t> &collab : collaborators) {
+            if (vertex[i] != vertex[collab.first]) {
+                builder.insert_edge(vertex[i], vertex[collab.first],
+                                    song_key[collab.second]);
+            }
+        }
+    }
+
+    // Step 4: Remember every artist's songs for catalog updates; the
+    // builder's song labels are the catalog's song ids
+    vector<Catalog::Credit> credits;
+    credits.reserve(songs.size());
+    for (size_t r = 0; r < names.size(); ++r) {
+        for (size_t k = first_song[r]; k < first_song[r + 1]; ++k) {
+            credits.push_back({ vertex[r], song_key[k] });
+        }
+    }
+    frozen_ = builder.freeze();
+    vector<VertexId> new_id = reorder_graph();
+    if (!new_id.empty()) {
+        for (Catalog::Credit &credit : credits) {
+            credit.artist = new_id[credit.artist];
+        }
+    }
+    catalog_.build(builder.song_labels(), builder.num_vertices(), credits);
+    if (!new_id.empty()) {
+        catalog_.set_record_order(new_id);
+    }
+
+    graph_ = CollabGraph();
+    labels_ = DistanceLabels();
+    build_indexes();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: parse_artists
+* @purpose: read artist records from a data stream and insert them as vertices
+*
+* @preconditions: none
+* @postconditions: every named artist is a vertex in the graph and is appended to 'artists' in file order
+*
+* @parameters: 1) a std::istream reference, the input stream containing artist names, songs, and '*' delimiters
+*             2) a std::vector<Artist> reference, receives the parsed artists
+* @returns: none
+*/
+void SixDegrees::parse_artists(istream &data_stream,
+                               vector<Artist> &artists) {
+    string line;
+    Artist current_artist;
+
+    while (getline(data_stream, line)) {
+        if (line.empty()) continue;
+
+        if (line == "*") {
+            if (!current_artist.get_name().empty()) {
+                graph_.insert_vertex(current_artist);
+                artists.push_back(current_artist);
+                current_artist = Artist();
+            }
+        } else if (current_artist.get_name().empty()) {
+            current_artist.set_name(line);
+        } else {
+            current_artist.add_song(line);
+        }
+    }
+
+    // Handle the last artist if file doesn't end with '*'
+    if (!current_artist.get_name().empty()) {
+        graph_.insert_vertex(current_artist);
+        artists.push_back(current_artist);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: run
+* @purpose: process commands from an input stream and write results to an output stream
+*
+* @preconditions: the collaboration graph should be populated
+* @postconditions: commands are processed, and results are written to the output stream
+*
+* @parameters: 1) a std::istream reference, the input stream containing commands
+*             2) a std::ostream reference, the output stream for results
+* @returns: none
+*
+* @notes: output is collected in an OutputBuffer and reaches the output
+*         stream in large blocks; it is flushed by the flush command, after
+*         every command if set_interactive was, and when the input ends.
+*         While stats are collected, each query's answer is formatted into
+*         a string first, so writing it out can be timed as a phase (quit,
+*         which writes nothing, is not)
+*/
+void SixDegrees::run(istream &input, ostream &target) {
+    OutputBuffer buffer(target);
+    ostream output(&buffer);
+    CommandParser parser;
+    Command command;
+    
+    while (parser.read(input, command)) {
+        if (runs_alone(command)) {
+            run_alone(command, output);
+        } else if (!stats_.enabled()) {
+            process_command(command, context_, output);
+        } else {
+            ostringstream result;
+            process_command(command, context_, result);
+            if (result.tellp() > 0) {
+                QueryStats::Stopwatch watch;
+                output << result.str();
+                stats_.record_phase(QueryStats::OUTPUT, watch.lap());
+            }
+        }
+        if (interactive_) {
+            output.flush();
+        }
+    }
+    output.flush();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: run_batch
+* @purpose: process commands from an input stream on several threads, writing results in command order
+*
+* @preconditions: the collaboration graph should be populated
+* @postconditions: commands are processed, and the output stream receives exactly what run would have written
+*
+* @parameters: 1) a std::istream reference, the input stream containing commands
+*             2) a std::ostream reference, the output stream for results
+*             3) a size_t, the number of worker threads
+* @returns: none
+*
+* @notes: commands are parsed ahead in batches of BATCH_SIZE. Each batch is
+*         spread over the workers, each with its own TraversalContext, and
+*         every command's output is collected separately and written once
+*         the whole batch is done, so batches never interleave. A catalog
+*         update, stats or flush command ends its batch and is run once the
+*         batch is written. Output goes through an OutputBuffer, flushed
+*         after each batch
+*/
+void SixDegrees::run_batch(istream &input, ostream &target, size_t num_threads) {
+    OutputBuffer buffer(target);
+    ostream output(&buffer);
+    WorkerPool pool(num_threads);
+    vector<TraversalContext> contexts(pool.size());
+    
+    CommandParser parser;
+    vector<Command> batch;
+    vector<string> results;
+    bool more = true;
+    
+    while (more) {
+        batch.clear();
+        Command command;
+        bool alone = false;
+        while (batch.size() < BATCH_SIZE && (more = parser.read(input, command))) {
+            if (runs_alone(command)) {
+                alone = true;
+                break;
+            }
+            batch.push_back(command);
+        }
+        
+        results.assign(batch.size(), string());
+        pool.parallel_for(batch.size(), [&](size_t i, size_t worker) {
+            ostringstream result;
+            process_command(batch[i], contexts[worker], result);
+            results[i] = result.str();
+        });
+        
+        for (const string &result : results) {
+            if (!stats_.enabled() || result.empty()) {
+                output << result;
+                continue;
+            }
+            QueryStats::Stopwatch watch;
+            output << result;
+            stats_.record_phase(QueryStats::OUTPUT, watch.lap());
+        }
+        if (alone) {
+            run_alone(command, output);
+        }
+        output.flush();
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: serve
+* @purpose: answer the commands of a query server's clients
+*
+* @preconditions: the collaboration graph should be populated
+* @postconditions: returns once the server is stopped, with every
+*                  connection closed
+*
+* @parameters: a QueryServer reference, the server, already listening
+* @returns: none
+*
+* @notes: queries run on the server's workers exactly as in run_batch;
+*         catalog updates, stats and flush run on the serving thread with
+*         no query running (see QueryServer.h). Answers are written to
+*         each client as soon as they and the ones before them are done,
+*         so flush has nothing left to do
+*/
+void SixDegrees::serve(QueryServer &server) {
+    QueryServer::Handlers handlers;
+    handlers.query = [this](const Command &command, TraversalContext &context,
+                            ostream &output) {
+        process_command(command, context, output);
+    };
+    handlers.runs_alone = &SixDegrees::runs_alone;
+    handlers.alone = [this](const Command &command, ostream &output) {
+        run_alone(command, output);
+    };
+    server.run(handlers);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: process_command
+* @purpose: execute a single command (bfs, dfs, not, songs, dist, components, critical, quit) with its artists
+*
+* @preconditions: the collaboration graph should be populated
+* @postconditions: the command is executed, and results are written to the output stream
+*
+* @parameters: 1) a const Command reference, the parsed command to execute
+*             2) a TraversalContext reference, the search state to use for traversals
+*             3) a std::ostream reference, the output stream for results
+* @returns: none
+*
+* @notes: only reads the graph, so several commands may run at once as long
+*         as each has its own TraversalContext. While stats are collected,
+*         the command is timed as a whole and by phase, and the work its
+*         searches did is added up (see QueryStats.h)
+*/
+void SixDegrees::process_command(const Command &command, 
+                            TraversalContext &context, 
+                            ostream &output) const {
+    if (command.name == "quit") {
+        return;
+    }
+    if (!stats_.enabled()) {
+        dispatch_command(command, context, output, nullptr);
+        return;
+    }
+
+    QueryStats::Stopwatch watch;
+    dispatch_command(command, context, output, &watch);
+    stats_.record_phase(QueryStats::ANSWER, watch.lap());
+    stats_.record(command.name, watch.total());
+    stats_.add_counts(context.take_counts());
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: dispatch_command
+* @purpose: look up a command's artists and answer it
+*
+* @preconditions: the collaboration graph should be populated
+* @postconditions: the command is executed, and results are written to the output stream
+*
+* @parameters: 1) a const Command reference, the parsed command to execute
+*             2) a TraversalContext reference, the search state to use for traversals
+*             3) a std::ostream reference, the output stream for results
+*             4) a QueryStats::Stopwatch pointer, lapped once the artists
+*                are looked up; nullptr when stats are not collected
+* @returns: none
+*
+* @notes: with the cache on, a query answered before is written straight
+*         from the cache; messages about unknown artists are always
+*         written afresh. The lookup phase is recorded for every command,
+*         even one naming no artist or an unknown one, so there are as
+*         many lookups as answers
+*/
+void SixDegrees::dispatch_command(const Command &command,
+                                  TraversalContext &context, ostream &output,
+                                  QueryStats::Stopwatch *watch) const {
+    if (command.name == "components" || command.name == "critical") {
+        if (watch) {
+            stats_.record_phase(QueryStats::LOOKUP, watch->lap());
+        }
+        if (command.name == "components") {
+            list_components(output);
+        } else {
+            list_critical(output);
+        }
+        return;
+    }
+    
+    // Resolve each name to its id once
+    VertexId source = resolve_artist(command.source, output);
+    VertexId dest = resolve_artist(command.dest, output);
+    
+    if (source == FrozenGraph::NO_VERTEX || dest == FrozenGraph::NO_VERTEX) {
+        // Skip further processing if artists are invalid, but still
+        // report unknown artists in the exclude list
+        for (const string &name : command.exclude) {
+            resolve_artist(name, output);
+        }
+        if (watch) {
+            stats_.record_phase(QueryStats::LOOKUP, watch->lap());
+        }
+        return;
+    }
+    
+    vector<VertexId> exclude;
+    for (const string &name : command.exclude) {
+        VertexId v = resolve_artist(name, output);
+        if (v != FrozenGraph::NO_VERTEX) {
+            exclude.push_back(v);
+        }
+    }
+    if (watch) {
+        stats_.record_phase(QueryStats::LOOKUP, watch->lap());
+    }
+    
+    if (!cache_.enabled()) {
+        answer(command, source, dest, exclude, context, output);
+        return;
+    }
+    
+    // Serve a repeated query from the cache, and remember new answers
+    ResultCache::Key key(command.name, source, dest, exclude);
+    string result;
+    if (!cache_.lookup(key, result)) {
+        ostringstream fresh;
+        answer(command, source, dest, exclude, context, fresh);
+        result = fresh.str();
+        cache_.insert(key, result);
+    }
+    output << result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: answer
+* @purpose: run a command whose artists have all been looked up
+*
+* @preconditions: source and dest are in the graph, and so is every artist in exclude
+* @postconditions: the command's result is written to the output stream
+*
+* @parameters: 1) a const Command reference, the command (for its name)
+*             2) a VertexId, the source artist
+*             3) a VertexId, the destination artist
+*             4) a const std::vector<VertexId> reference, the artists to exclude ("not" only)
+*             5) a TraversalContext reference, the search state to use for traversals
+*             6) a std::ostream reference, the output stream for results
+* @returns: none
+*
+* @notes: searches between artists of different components are answered
+*         "No path exists" straight away, as every search would conclude
+*         after exploring the source's whole component. So is a not query
+*         that excludes a cut vertex between its artists, while one that
+*         excludes no artist of the blocks between them is answered as a
+*         bfs query (see BlockCutTree.h): no shortest path goes near the
+*         excluded artists, and a classic search visits the blocks between
+*         the two in the same order with or without them, so the classic
+*         path is the same, and may come off a pooled search tree; other
+*         engines return a shortest path either way
+*/
+void SixDegrees::answer(const Command &command, VertexId source,
+                        VertexId dest, const vector<VertexId> &exclude,
+                        TraversalContext &context, ostream &output) const {
+    bool search = command.name == "bfs" || command.name == "dfs" ||
+                  command.name == "not" || command.name == "dist";
+    if (search && !components_.connected(source, dest)) {
+        print_no_path(source, dest, output);
+        return;
+    }
+
+    if (command.name == "bfs") {
+        bfs(source, dest, context, output);
+    } else if (command.name == "dfs") {
+        dfs(source, dest, context, output);
+    } else if (command.name == "not") {
+        BlockCutTree::Effect effect = BlockCutTree::MAY_SEPARATE;
+        if (!blocks_.empty() && !exclude.empty()) {
+            effect = blocks_.effect(source, dest, exclude);
+        }
+        if (effect == BlockCutTree::SEPARATES) {
+            print_no_path(source, dest, output);
+        } else if (effect == BlockCutTree::NO_EFFECT) {
+            bfs(source, dest, context, output);
+        } else {
+            not_search(source, dest, exclude, context, output);
+        }
+    } else if (command.name == "songs") {
+        list_songs(source, dest, output);
+    } else if (command.name == "dist") {
+        dist(source, dest, context, output);
+    } else {
+        output << "\"" << command.name << "\" is not a valid command.\n";
+    }
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-* @function: constructor
-* @purpose: initialize a SixDegrees instance
+* @function: resolve_artist
+* @purpose: look up the id of an artist, reporting artists that do not exist
 *
 * @preconditions: none
-* @postconditions: a new SixDegrees instance is created with an empty collaboration graph
+* @postconditions: a message is printed if the artist is not in the graph
 *
-* @parameters: none
-* @returns: none
+* @parameters: 1) a const std::string reference, the name of the artist to look up
+*             2) a std::ostream reference, the output stream for error messages
+* @returns: a VertexId, the artist's id, or FrozenGraph::NO_VERTEX if the
+*           artist is not in the graph
 */
-SixDegrees::SixDegrees() {
-    // Initialize empty CollabGraph
+SixDegrees::VertexId SixDegrees::resolve_artist(const string &name, ostream &output) const {
+    VertexId v = frozen_.find_vertex(name);
+    if (v == FrozenGraph::NO_VERTEX) {
+        output << "\"" << name << "\" was not found in the collaboration graph.\n";
+    }
+    return v;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-* @function: populate_graph
-* @purpose: build the collaboration graph from input data
+* @function: is_update
+* @purpose: tell catalog updates apart from queries
 *
 * @preconditions: none
-* @postconditions: the collaboration graph is populated with vertices (artists) and edges (songs) based on the input data
+* @postconditions: none
 *
-* @parameters: a std::istream reference, the input stream containing artist names, songs, and '*' delimiters
+* @parameters: a const Command reference, the parsed command
+* @returns: a bool, true for add-artist, remove-artist, add-song and remove-song
+*/
+bool SixDegrees::is_update(const Command &command) {
+    return command.name == "add-artist" || command.name == "remove-artist" ||
+           command.name == "add-song" || command.name == "remove-song";
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: runs_alone
+* @purpose: tell apart the commands that must not overlap any other
+*
+* @preconditions: none
+* @postconditions: none
+*
+* @parameters: a const Command reference, the parsed command
+* @returns: a bool, true for catalog updates, stats and flush, which must
+*           see every command before them finished
+*/
+bool SixDegrees::runs_alone(const Command &command) {
+    return is_update(command) || command.name == "stats" ||
+           command.name == "flush";
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: run_alone
+* @purpose: run a command runs_alone picked out
+*
+* @preconditions: no query is running
+* @postconditions: the statistics are printed, the output is flushed, or
+*                  the update is applied and timed if stats are collected
+*
+* @parameters: 1) a const Command reference, the command
+*             2) a std::ostream reference, the output stream for messages
 * @returns: none
 */
-void SixDegrees::populate_graph(istream &data_stream) {
-    string line;
-    Artist current_artist;
-    vector<Artist> artists;
-    vector<pair<Artist, vector<string>>> artist_songs;
+void SixDegrees::run_alone(const Command &command, ostream &output) {
+    if (command.name == "stats") {
+        print_stats(output);
+        return;
+    }
+    if (command.name == "flush") {
+        output.flush();
+        return;
+    }
+    if (!stats_.enabled()) {
+        update(command, output);
+        return;
+    }
 
-    // Step 1: Parse input to collect artists and their songs
-    while (getline(data_stream, line)) {
-        if (line.empty()) continue;
+    QueryStats::Stopwatch watch;
+    update(command, output);
+    watch.lap();
+    stats_.record(command.name, watch.total());
+}
 
-        if (line == "*") {
-            if (!current_artist.get_name().empty()) {
-                // Store the artist and their songs
-                graph_.insert_vertex(current_artist);
-                vector<string> songs;
-                // Songs are already added via add_song; we'll handle edges later
-                artists.push_back(current_artist);
-                artist_songs.emplace_back(current_artist, songs);
-                current_artist = Artist();
-            }
-        } else if (current_artist.get_name().empty()) {
-            current_artist.set_name(line);
-        } else {
-            current_artist.add_song(line);
-        }
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: update
+* @purpose: apply a catalog update to the graph
+*
+* @preconditions: no query is running
+* @postconditions: the graph and its components are those a rebuild from
+*                  the updated catalog would give (landmarks and labels are
+*                  dropped), and a message says what changed
+*
+* @parameters: 1) a const Command reference, the update; its source is the
+*                artist, and its destination the song title, if any
+*             2) a std::ostream reference, the output stream for messages
+* @returns: none
+*
+* @notes: costs time in proportion to the rows of the artist and its
+*         collaborators, plus the searches ComponentIndex::separate runs
+*         for each collaboration removed; the graph is never rebuilt
+*/
+void SixDegrees::update(const Command &command, ostream &output) {
+    if (command.name == "add-artist") {
+        add_artist(command.source, output);
+    } else if (command.name == "remove-artist") {
+        remove_artist(command.source, output);
+    } else if (command.name == "add-song") {
+        add_song(command.source, command.dest, output);
+    } else if (command.name == "remove-song") {
+        remove_song(command.source, command.dest, output);
     }
+}
 
-    // Handle the last artist if file doesn't end with '*'
-    if (!current_artist.get_name().empty()) {
-        graph_.insert_vertex(current_artist);
-        artists.push_back(current_artist);
-        artist_songs.emplace_back(current_artist, vector<string>());
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: add_artist
+* @purpose: add an artist who sings nothing yet (the add-artist command)
+*
+* @preconditions: no query is running
+* @postconditions: the artist can be found, with no collaborations
+*
+* @parameters: 1) a const std::string reference, the name of the artist
+*             2) a std::ostream reference, the output stream for messages
+* @returns: none
+*
+* @notes: a removed artist comes back under its old id. Cached answers are
+*         kept: none of them can involve the new artist
+*/
+void SixDegrees::add_artist(const string &name, ostream &output) {
+    if (frozen_.find_vertex(name) != FrozenGraph::NO_VERTEX) {
+        output << "\"" << name << "\" is already in the collaboration graph.\n";
+        return;
     }
 
-    // Step 2: Create edges by checking collaborations
-    for (size_t i = 0; i < artists.size(); ++i) {
-        Artist a1 = artists[i];
-        for (size_t j = i + 1; j < artists.size(); ++j) {
-            Artist a2 = artists[j];
-            string song = a1.get_collaboration(a2);
-            if (!song.empty() && a1 != a2) {
-                try {
-                    graph_.insert_edge(a1, a2, song);
-                } catch (const runtime_error &e) {
-                    throw; // Propagate as per instructions
-                }
-            }
-        }
+    VertexId v = editor().insert_vertex(name);
+    if (v == catalog_.num_artists()) {
+        catalog_.insert_artist();
+        components_.add_vertex();
+    } else {
+        components_.restore_vertex(v);
     }
+    graph_changed(false);
+
+    output << "\"" << name << "\" was added to the collaboration graph.\n";
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-* @function: run
-* @purpose: process commands from an input stream and write results to an output stream
+* @function: remove_artist
+* @purpose: remove an artist and every collaboration of theirs (the remove-artist command)
 *
-* @preconditions: the collaboration graph should be populated
-* @postconditions: commands are processed, and results are written to the output stream
+* @preconditions: no query is running
+* @postconditions: the artist can no longer be found, and sings nothing
 *
-* @parameters: 1) a std::istream reference, the input stream containing commands
-*             2) a std::ostream reference, the output stream for results
+* @parameters: 1) a const std::string reference, the name of the artist
+*             2) a std::ostream reference, the output stream for messages
 * @returns: none
 */
-void SixDegrees::run(istream &input, ostream &output) {
-    string command;
-    
-    while (getline(input, command)) {
-        if (command.empty()) continue;
-        process_command(command, input, output);
+void SixDegrees::remove_artist(const string &name, ostream &output) {
+    VertexId v = resolve_artist(name, output);
+    if (v == FrozenGraph::NO_VERTEX) return;
+
+    GraphEditor &edit = editor();
+    Catalog::Range<Catalog::SongId> current = catalog_.songs(v);
+    vector<Catalog::SongId> songs(current.begin(), current.end());
+    for (Catalog::SongId song : songs) {
+        catalog_.remove_song(v, song);
+    }
+
+    vector<VertexId> collaborators;
+    for (EdgeId e = frozen_.edge_begin(v); e < frozen_.edge_end(v); ++e) {
+        collaborators.push_back(frozen_.edge_target(e));
+    }
+    for (VertexId w : collaborators) {
+        relink(v, w);
     }
+
+    edit.remove_vertex(v);
+    components_.remove_vertex(v);
+    graph_changed(true);
+
+    output << "\"" << name << "\" was removed from the collaboration graph.\n";
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-* @function: process_command
-* @purpose: execute a single command (bfs, dfs, not, quit) with source and destination artists
+* @function: add_song
+* @purpose: record that an artist sings a song (the add-song command)
 *
-* @preconditions: the collaboration graph should be populated
-* @postconditions: the command is executed, and results are written to the output stream
+* @preconditions: no query is running
+* @postconditions: the artist collaborates with every other singer of the
+*                  song, the song listed last among their shared songs
 *
-* @parameters: 1) a const std::string reference, the command to execute
-*             2) a std::istream reference, the input stream for additional command data
-*             3) a std::ostream reference, the output stream for results
+* @parameters: 1) a const std::string reference, the name of the artist
+*             2) a const std::string reference, the song title
+*             3) a std::ostream reference, the output stream for messages
 * @returns: none
 */
-void SixDegrees::process_command(const string &command, 
-                            istream &input, 
-                            ostream &output) {
-    if (command == "quit") {
+void SixDegrees::add_song(const string &name, const string &title,
+                          ostream &output) {
+    VertexId v = resolve_artist(name, output);
+    if (v == FrozenGraph::NO_VERTEX) return;
+
+    editor();
+    Catalog::SongId song = catalog_.insert_song(title);
+    if (!catalog_.add_song(v, song)) {
+        output << "\"" << name << "\" already sings \"" << title << "\".\n";
         return;
     }
-    
-    string source_name, dest_name;
-    getline(input, source_name);
-    if (source_name.empty()) return;
-    
-    getline(input, dest_name);
-    if (dest_name.empty()) return;
-    
-    // Validate artists
-    bool source_valid = is_valid_artist(source_name, output);
-    bool dest_valid = is_valid_artist(dest_name, output);
-    
-    if (!source_valid || !dest_valid) {
-        // Skip further processing if artists are invalid
-        if (command == "not") {
-            // Consume exclude list until '*'
-            string line;
-            while (getline(input, line) && line != "*") {
-                if (!line.empty()) {
-                    is_valid_artist(line, output);
-                }
-            }
-        }
+
+    vector<VertexId> partners;
+    for (VertexId w : catalog_.singers(song)) {
+        if (w != v) partners.push_back(w);
+    }
+    for (VertexId w : partners) {
+        relink(v, w);
+    }
+    if (!partners.empty()) graph_changed(true);
+
+    output << "\"" << name << "\" now sings \"" << title << "\".\n";
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: remove_song
+* @purpose: record that an artist no longer sings a song (the remove-song command)
+*
+* @preconditions: no query is running
+* @postconditions: the song is gone from the artist's collaborations, and
+*                  collaborations left with no songs are removed
+*
+* @parameters: 1) a const std::string reference, the name of the artist
+*             2) a const std::string reference, the song title
+*             3) a std::ostream reference, the output stream for messages
+* @returns: none
+*/
+void SixDegrees::remove_song(const string &name, const string &title,
+                             ostream &output) {
+    VertexId v = resolve_artist(name, output);
+    if (v == FrozenGraph::NO_VERTEX) return;
+
+    editor();
+    Catalog::SongId song = catalog_.find_song(title);
+    if (song == Catalog::NO_SONG || !catalog_.remove_song(v, song)) {
+        output << "\"" << name << "\" does not sing \"" << title << "\".\n";
         return;
     }
-    
-    Artist source(source_name);
-    Artist dest(dest_name);
-    
-    if (command == "bfs") {
-        bfs(source, dest, output);
-    } else if (command == "dfs") {
-        dfs(source, dest, output);
-    } else if (command == "not") {
-        vector<Artist> exclude;
-        string line;
-        while (getline(input, line) && line != "*") {
-            if (!line.empty()) {
-                if (is_valid_artist(line, output)) {
-                    exclude.emplace_back(line);
-                }
-            }
-        }
-        not_search(source, dest, exclude, output);
-    } else {
-        output << "\"" << command << "\" is not a valid command." << endl;
+
+    Catalog::Range<VertexId> singers = catalog_.singers(song);
+    vector<VertexId> partners(singers.begin(), singers.end());
+    for (VertexId w : partners) {
+        relink(v, w);
+    }
+    if (!partners.empty()) graph_changed(true);
+
+    output << "\"" << name << "\" no longer sings \"" << title << "\".\n";
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: editor
+* @purpose: get ready to change the graph in place
+*
+* @preconditions: no query is running
+* @postconditions: frozen_ reads its arrays from an editor, and the catalog
+*                  covers every artist of frozen_
+*
+* @parameters: none
+* @returns: a GraphEditor reference, the editor of frozen_
+*
+* @notes: the first call copies the graph's arrays once (see GraphEditor)
+*/
+GraphEditor &SixDegrees::editor() {
+    if (catalog_.num_artists() != frozen_.num_vertices()) {
+        catalog_.derive(frozen_);
+    }
+    if (!editor_) {
+        editor_.reset(new GraphEditor(frozen_));
+    }
+    return *editor_;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: relink
+* @purpose: bring the collaboration of two artists in line with the catalog
+*
+* @preconditions: editor() has been called
+* @postconditions: the two share an edge carrying the songs they both sing,
+*                  in the order of the one whose record came first (the
+*                  lower id, unless the graph was renumbered), or no edge
+*                  if they share none; components_ follows
+*
+* @parameters: 1) a VertexId, one artist
+*             2) a VertexId, the other artist
+* @returns: none
+*/
+void SixDegrees::relink(VertexId a, VertexId b) {
+    vector<Catalog::SongId> shared = catalog_.listed_before(a, b)
+                                         ? catalog_.shared(a, b)
+                                         : catalog_.shared(b, a);
+    vector<FrozenGraph::SongId> songs;
+    songs.reserve(shared.size());
+    for (Catalog::SongId song : shared) {
+        songs.push_back(editor_->insert_song(catalog_.title(song)));
+    }
+
+    bool existed = frozen_.find_edge(a, b) != FrozenGraph::NO_EDGE;
+    editor_->set_songs(a, b, songs);
+    if (!existed && !songs.empty()) {
+        components_.unite(a, b);
+    } else if (existed && songs.empty()) {
+        components_.separate(frozen_, a, b);
     }
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-* @function: is_valid_artist
-* @purpose: determine whether an artist exists in the collaboration graph
+* @function: graph_changed
+* @purpose: drop whatever a catalog update has made stale
 *
 * @preconditions: none
-* @postconditions: none
+* @postconditions: no landmarks, labels, blocks or search trees are kept,
+*                  nor any cached answers if 'answers_changed' or if
+*                  there were landmarks or labels
 *
-* @parameters: 1) a const std::string reference, the name of the artist to check
-*             2) a std::ostream reference, the output stream for error messages
-* @returns: a bool, true if the artist is in the graph, false otherwise
+* @parameters: a bool, whether collaborations changed or an artist was
+*              removed, so earlier answers may be wrong
+* @returns: none
+*
+* @notes: landmark distances and labels cannot be patched cheaply (a
+*         collaboration added or removed moves distances all over the
+*         graph), so they wait for the next build; dist and the engines
+*         that use them search without them meanwhile. So do the blocks:
+*         not searches for every exclusion list until then, and critical
+*         finds the blocks afresh each time. Cached answers that came
+*         from the landmarks or labels (dist bounds, A* and label paths)
+*         would then differ from fresh ones, so they go with them
 */
-bool SixDegrees::is_valid_artist(const string &name, ostream &output) {
-    Artist artist(name);
-    if (!graph_.is_vertex(artist)) {
-        output << "\"" << name << "\" was not found in the collaboration graph." << endl;
-        return false;
+void SixDegrees::graph_changed(bool answers_changed) {
+    if (landmarks_.num_landmarks() > 0 || !labels_.empty()) {
+        answers_changed = true;
+    }
+    landmarks_ = LandmarkIndex();
+    labels_ = DistanceLabels();
+    blocks_ = BlockCutTree();
+    trees_.clear();
+    if (answers_changed) {
+        cache_.clear();
     }
-    return true;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -215,40 +1348,90 @@ bool SixDegrees::is_valid_artist(const string &name, ostream &output) {
 * @preconditions: both source and destination artists must be in the collaboration graph
 * @postconditions: a path from source to destination is printed if one exists
 *
-* @parameters: 1) a const Artist reference, the source artist
-*             2) a const Artist reference, the destination artist
-*             3) a std::ostream reference, the output stream for the path
+* @parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist
+*             3) a TraversalContext reference, holds the visited marks and predecessors of this search
+*             4) a std::ostream reference, the output stream for the path
 * @returns: none
 */
-void SixDegrees::bfs(const Artist &source, const Artist &dest, ostream &output) {
-    graph_.clear_metadata();
+void SixDegrees::bfs(VertexId source, VertexId dest,
+                     TraversalContext &context, ostream &output) const {
+    bool labelled = search_mode_ == LABEL_SEARCH && !labels_.empty();
+    if (trees_.enabled() && !labelled) {
+        print_search(tree_path(source, dest), source, dest, output);
+        return;
+    }
+    if (search_mode_ != CLASSIC_SEARCH) {
+        not_search(source, dest, vector<VertexId>(), context, output);
+        return;
+    }
+
+    context.reset(frozen_.num_vertices());
     
-    queue<Artist> queue;
-    queue.push(source);
-    graph_.mark_vertex(source);
+    // The context's frontier is the queue, popped at 'head'
+    vector<VertexId> &queue = context.frontier();
+    size_t head = 0;
+    queue.push_back(source);
+    context.mark_vertex(source);
     
-    while (!queue.empty()) {
-        Artist current = queue.front();
-        queue.pop();
+    while (head < queue.size()) {
+        VertexId current = queue[head++];
         
         if (current == dest) {
-            std::stack<Artist> path = graph_.report_path(source, dest);
-            print_path(path, output);
+            print_path(context.report_path(source, dest), output);
             return;
         }
         
-        vector<Artist> neighbors = graph_.get_vertex_neighbors(current);
-        for (const Artist &neighbor : neighbors) {
-            if (!graph_.is_marked(neighbor)) {
-                graph_.mark_vertex(neighbor);
-                graph_.set_predecessor(neighbor, current);
-                queue.push(neighbor);
+        context.count_expansion(frozen_.degree(current), queue.size() - head);
+        for (FrozenGraph::Neighbor neighbor : frozen_.neighbors(current)) {
+            if (!context.is_marked(neighbor.vertex)) {
+                context.mark_vertex(neighbor.vertex);
+                context.set_predecessor(neighbor.vertex, current);
+                queue.push_back(neighbor.vertex);
             }
         }
     }
     
-    output << "No path exists from \"" << source.get_name() 
-        << "\" to \"" << dest.get_name() << "\"." << endl;
+    print_no_path(source, dest, output);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: tree_path
+* @purpose: find a bfs path by walking a pooled search tree
+*
+* @preconditions: the tree pool is on
+* @postconditions: the source's tree is in the pool, unless the destination's
+*                  tree answered the query
+*
+* @parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist
+* @returns: a std::stack<VertexId>, the path with the source on top, or an
+*           empty stack if there is none
+*
+* @notes: a tree grown from the source gives exactly the classic bfs path.
+*         Outside CLASSIC_SEARCH any shortest path will do, so a tree grown
+*         from the destination is walked backwards as well
+*/
+std::stack<SixDegrees::VertexId> SixDegrees::tree_path(VertexId source,
+                                                      VertexId dest) const {
+    TreePool::Tree tree = trees_.find(source);
+    if (!tree && search_mode_ != CLASSIC_SEARCH) {
+        TreePool::Tree reverse = trees_.find(dest);
+        if (reverse) {
+            // The walk up from the source comes out with the destination
+            // on top; turn it over
+            std::stack<VertexId> backwards = reverse->path_to(source);
+            std::stack<VertexId> path;
+            for (; !backwards.empty(); backwards.pop()) {
+                path.push(backwards.top());
+            }
+            return path;
+        }
+    }
+    if (!tree) {
+        tree = trees_.grow(frozen_, source);
+    }
+    return tree->path_to(dest);
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -258,40 +1441,41 @@ void SixDegrees::bfs(const Artist &source, const Artist &dest, ostream &output)
 * @preconditions: both source and destination artists must be in the collaboration graph
 * @postconditions: a path from source to destination is printed if one exists
 *
-* @parameters: 1) a const Artist reference, the source artist
-*             2) a const Artist reference, the destination artist
-*             3) a std::ostream reference, the output stream for the path
+* @parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist
+*             3) a TraversalContext reference, holds the visited marks and predecessors of this search
+*             4) a std::ostream reference, the output stream for the path
 * @returns: none
 */
-void SixDegrees::dfs(const Artist &source, const Artist &dest, ostream &output) {
-    graph_.clear_metadata();
+void SixDegrees::dfs(VertexId source, VertexId dest,
+                     TraversalContext &context, ostream &output) const {
+    context.reset(frozen_.num_vertices());
     
-    std::stack<Artist> artist_stack;
-    artist_stack.push(source);
-    graph_.mark_vertex(source);
+    // The context's frontier is the stack, with its top at the back
+    vector<VertexId> &artist_stack = context.frontier();
+    artist_stack.push_back(source);
+    context.mark_vertex(source);
     
     while (!artist_stack.empty()) {
-        Artist current = artist_stack.top();
-        artist_stack.pop();
+        VertexId current = artist_stack.back();
+        artist_stack.pop_back();
         
         if (current == dest) {
-            std::stack<Artist> path = graph_.report_path(source, dest);
-            print_path(path, output);
+            print_path(context.report_path(source, dest), output);
             return;
         }
         
-        vector<Artist> neighbors = graph_.get_vertex_neighbors(current);
-        for (const Artist &neighbor : neighbors) {
-            if (!graph_.is_marked(neighbor)) {
-                graph_.mark_vertex(neighbor);
-                graph_.set_predecessor(neighbor, current);
-                artist_stack.push(neighbor);
+        context.count_expansion(frozen_.degree(current), artist_stack.size());
+        for (FrozenGraph::Neighbor neighbor : frozen_.neighbors(current)) {
+            if (!context.is_marked(neighbor.vertex)) {
+                context.mark_vertex(neighbor.vertex);
+                context.set_predecessor(neighbor.vertex, current);
+                artist_stack.push_back(neighbor.vertex);
             }
         }
     }
     
-    output << "No path exists from \"" << source.get_name() 
-        << "\" to \"" << dest.get_name() << "\"." << endl;
+    print_no_path(source, dest, output);
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -301,52 +1485,176 @@ void SixDegrees::dfs(const Artist &source, const Artist &dest, ostream &output)
 * @preconditions: both source and destination artists must be in the collaboration graph
 * @postconditions: a path from source to destination, avoiding excluded artists, is printed if one exists
 *
-* @parameters: 1) a const Artist reference, the source artist
-*             2) a const Artist reference, the destination artist
-*             3) a std::vector<Artist> reference, the list of artists to exclude
-*             4) a std::ostream reference, the output stream for the path
+* @parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist
+*             3) a const std::vector<VertexId> reference, the artists to exclude
+*             4) a TraversalContext reference, holds the visited marks and predecessors of this search
+*             5) a std::ostream reference, the output stream for the path
 * @returns: none
 */
-void SixDegrees::not_search(const Artist &source, 
-                        const Artist &dest, 
-                        vector<Artist> &exclude, 
-                        ostream &output) {
-    graph_.clear_metadata();
+void SixDegrees::not_search(VertexId source, 
+                        VertexId dest, 
+                        const vector<VertexId> &exclude, 
+                        TraversalContext &context,
+                        ostream &output) const {
+    if (search_mode_ == LABEL_SEARCH && !labels_.empty()) {
+        // A label path is shortest in the whole graph, so it is shortest
+        // around the excluded artists too, if it avoids them all
+        stack<VertexId> path = labels_.path(source, dest);
+        bool avoids = true;
+        if (!path.empty()) {
+            stack<VertexId> rest = path;
+            for (rest.pop(); avoids && !rest.empty(); rest.pop()) {
+                avoids = find(exclude.begin(), exclude.end(), rest.top()) ==
+                         exclude.end();
+            }
+        }
+        if (avoids) {
+            print_search(path, source, dest, output);
+            return;
+        }
+    }
+    if (search_mode_ == BIDIRECTIONAL_SEARCH || search_mode_ == LABEL_SEARCH) {
+        print_search(bidirectional_search(frozen_, source, dest, exclude,
+                                          context),
+                     source, dest, output);
+        return;
+    }
+    if (search_mode_ == LANDMARK_SEARCH) {
+        print_search(landmark_search(frozen_, landmarks_, source, dest,
+                                     exclude, context),
+                     source, dest, output);
+        return;
+    }
+    if (search_mode_ == DIRECTION_OPTIMIZING_SEARCH) {
+        DirectionOptimizingBFS engine(frozen_);
+        BfsTree tree;
+        engine.search(source, tree, dest, exclude);
+        print_search(tree.path_to(dest), source, dest, output);
+        return;
+    }
+
+    context.reset(frozen_.num_vertices());
     
     // Mark excluded artists as visited to skip them
-    for (const Artist &artist : exclude) {
-        if (graph_.is_vertex(artist)) {
-            graph_.mark_vertex(artist);
-        }
+    for (VertexId artist : exclude) {
+        context.mark_vertex(artist);
     }
     
     // Perform BFS
-    queue<Artist> queue;
-    queue.push(source);
-    graph_.mark_vertex(source);
+    // The context's frontier is the queue, popped at 'head'
+    vector<VertexId> &queue = context.frontier();
+    size_t head = 0;
+    queue.push_back(source);
+    context.mark_vertex(source);
     
-    while (!queue.empty()) {
-        Artist current = queue.front();
-        queue.pop();
+    while (head < queue.size()) {
+        VertexId current = queue[head++];
         
         if (current == dest) {
-            std::stack<Artist> path = graph_.report_path(source, dest);
-            print_path(path, output);
+            print_path(context.report_path(source, dest), output);
             return;
         }
         
-        vector<Artist> neighbors = graph_.get_vertex_neighbors(current);
-        for (const Artist &neighbor : neighbors) {
-            if (!graph_.is_marked(neighbor)) {
-                graph_.mark_vertex(neighbor);
-                graph_.set_predecessor(neighbor, current);
-                queue.push(neighbor);
+        context.count_expansion(frozen_.degree(current), queue.size() - head);
+        for (FrozenGraph::Neighbor neighbor : frozen_.neighbors(current)) {
+            if (!context.is_marked(neighbor.vertex)) {
+                context.mark_vertex(neighbor.vertex);
+                context.set_predecessor(neighbor.vertex, current);
+                queue.push_back(neighbor.vertex);
             }
         }
     }
     
-    output << "No path exists from \"" << source.get_name() 
-        << "\" to \"" << dest.get_name() << "\"." << endl;
+    print_no_path(source, dest, output);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: list_songs
+* @purpose: list every song two artists collaborated on directly
+*
+* @preconditions: both artists must be in the collaboration graph
+* @postconditions: one line per shared song is printed, in the order the edge lists them, or a message if there are none
+*
+* @parameters: 1) a VertexId, the first artist
+*             2) a VertexId, the second artist
+*             3) a std::ostream reference, the output stream for the songs
+* @returns: none
+*
+* @notes: the edge is looked up from whichever artist has fewer collaborators
+*/
+void SixDegrees::list_songs(VertexId source, VertexId dest,
+                            ostream &output) const {
+    EdgeId e = frozen_.degree(source) <= frozen_.degree(dest)
+                   ? frozen_.find_edge(source, dest)
+                   : frozen_.find_edge(dest, source);
+    if (e == FrozenGraph::NO_EDGE) {
+        output << "\"" << frozen_.get_name(source) << "\" and \""
+            << frozen_.get_name(dest) << "\" have not collaborated.\n";
+        return;
+    }
+
+    for (const FrozenGraph::SongId *song = frozen_.edge_songs_begin(e);
+         song != frozen_.edge_songs_end(e); ++song) {
+        output << "\"" << frozen_.get_name(source) << "\" collaborated with "
+            << "\"" << frozen_.get_name(dest) << "\" in "
+            << "\"" << frozen_.get_song(*song) << "\".\n";
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: dist
+* @purpose: report how many collaborations apart two artists are
+*
+* @preconditions: both artists must be in the collaboration graph
+* @postconditions: the distance, or the bounds the landmarks put on it, is printed, or a "No path exists" message if the artists are not connected
+*
+* @parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist
+*             3) a TraversalContext reference, scratch state if a search is needed
+*             4) a std::ostream reference, the output stream for the result
+* @returns: none
+*
+* @notes: with distance labels the answer is exact and costs one merge of
+*         two labels. with landmarks it costs two table lookups; when no
+*         landmark reaches either artist (or there are none) it takes a
+*         bidirectional search instead and is exact
+*/
+void SixDegrees::dist(VertexId source, VertexId dest,
+                      TraversalContext &context, ostream &output) const {
+    const uint32_t UNREACHED = LandmarkIndex::UNREACHED;
+    static_assert(DistanceLabels::UNREACHED == LandmarkIndex::UNREACHED,
+                  "both indexes mark missing paths alike");
+    uint32_t lower, upper;
+    if (!labels_.empty()) {
+        lower = upper = labels_.distance(source, dest);
+    } else {
+        lower = landmarks_.lower_bound(source, dest);
+        upper = landmarks_.upper_bound(source, dest);
+    }
+    if (lower != UNREACHED and upper == UNREACHED) {
+        // No landmark reaches either artist: they lie in a part of the
+        // graph the landmarks know nothing about, so search it
+        stack<VertexId> path = bidirectional_search(frozen_, source, dest,
+                                                    vector<VertexId>(),
+                                                    context);
+        lower = upper = path.empty() ? UNREACHED : path.size() - 1;
+    }
+
+    if (lower == UNREACHED) {
+        print_no_path(source, dest, output);
+        return;
+    }
+
+    output << "\"" << frozen_.get_name(source) << "\" and \""
+        << frozen_.get_name(dest) << "\" are ";
+    if (lower == upper) {
+        output << lower;
+    } else {
+        output << lower << " to " << upper;
+    }
+    output << (upper == 1 ? " collaboration" : " collaborations")
+        << " apart.\n";
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -356,32 +1664,142 @@ void SixDegrees::not_search(const Artist &source,
 * @preconditions: the path stack should be valid, with predecessors set by a traversal
 * @postconditions: the path is printed to the output stream in destination-to-source order
 *
-* @parameters: 1) a std::stack<Artist> value, the path from source to destination
+* @parameters: 1) a std::stack<VertexId> value, the path from source to destination
 *             2) a std::ostream reference, the output stream for the path
 * @returns: none
 */
-void SixDegrees::print_path(std::stack<Artist> path, ostream &output) {
+void SixDegrees::print_path(std::stack<VertexId> path, ostream &output) const {
     if (path.empty()) {
-        output << "No path exists." << endl;
+        output << "No path exists.\n";
         return;
     }
     
-    vector<Artist> artists;
+    vector<VertexId> artists;
     while (!path.empty()) {
         artists.push_back(path.top());
         path.pop();
     }
     
     if (artists.size() < 2) {
-        output << "No path exists." << endl;
+        output << "No path exists.\n";
         return;
     }
     
     // Reverse to print from source to dest
     for (size_t i = artists.size() - 1; i > 0; --i) {
-        string song = graph_.get_edge(artists[i], artists[i-1]);
-        output << "\"" << artists[i].get_name() << "\" collaborated with "
-            << "\"" << artists[i-1].get_name() << "\" in "
-            << "\"" << song << "\"." << endl;
+        StringRef song = frozen_.get_edge(artists[i], artists[i-1]);
+        output << "\"" << frozen_.get_name(artists[i]) << "\" collaborated with "
+            << "\"" << frozen_.get_name(artists[i-1]) << "\" in "
+            << "\"" << song << "\".\n";
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: list_components
+* @purpose: report the sizes of the connected components of the graph
+*
+* @preconditions: none
+* @postconditions: a summary line is printed, then one line per distinct
+*                  component size, largest first, with how many components
+*                  have that size
+*
+* @parameters: a std::ostream reference, the output stream for the report
+* @returns: none
+*/
+void SixDegrees::list_components(ostream &output) const {
+    size_t artists = components_.num_vertices();
+    size_t count = components_.num_components();
+    output << artists << (artists == 1 ? " artist" : " artists") << " in "
+        << count << (count == 1 ? " component." : " components.") << '\n';
+
+    vector<size_t> sizes = components_.sizes();
+    for (size_t i = 0; i < sizes.size(); ) {
+        size_t j = i;
+        while (j < sizes.size() && sizes[j] == sizes[i]) ++j;
+        output << j - i << (j - i == 1 ? " component of " : " components of ")
+            << sizes[i] << (sizes[i] == 1 ? " artist." : " artists.") << '\n';
+        i = j;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: list_critical
+* @purpose: list the artists and collaborations whose loss would leave some
+*           other artists with no path between them
+*
+* @preconditions: none
+* @postconditions: a summary line is printed, then every cut vertex, in id
+*                  order, then every bridge, ordered by its artists' ids
+*                  and printed as a path step is
+*
+* @parameters: a std::ostream reference, the output stream for the report
+* @returns: none
+*
+* @notes: after a catalog update the blocks are found again for each
+*         critical command, in time proportional to the graph
+*/
+void SixDegrees::list_critical(ostream &output) const {
+    BlockCutTree fresh;
+    const BlockCutTree *blocks = &blocks_;
+    if (blocks_.num_vertices() != frozen_.num_vertices()) {
+        fresh.build(frozen_);
+        blocks = &fresh;
+    }
+
+    const vector<VertexId> &cuts = blocks->cut_vertices();
+    const vector<pair<VertexId, VertexId>> &bridges = blocks->bridges();
+    output << cuts.size()
+        << (cuts.size() == 1 ? " critical artist, " : " critical artists, ")
+        << bridges.size()
+        << (bridges.size() == 1 ? " critical collaboration." : " critical collaborations.")
+        << '\n';
+
+    for (VertexId v : cuts) {
+        output << "\"" << frozen_.get_name(v) << "\"\n";
+    }
+    for (const pair<VertexId, VertexId> &bridge : bridges) {
+        output << "\"" << frozen_.get_name(bridge.first) << "\" collaborated with "
+            << "\"" << frozen_.get_name(bridge.second) << "\" in "
+            << "\"" << frozen_.get_edge(bridge.first, bridge.second) << "\".\n";
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: print_no_path
+* @purpose: report that a traversal could not reach the destination
+*
+* @preconditions: none
+* @postconditions: a "No path exists" message is printed to the output stream
+*
+* @parameters: 1) a VertexId, the source artist
+*             2) a VertexId, the destination artist
+*             3) a std::ostream reference, the output stream for the message
+* @returns: none
+*/
+void SixDegrees::print_no_path(VertexId source, VertexId dest,
+                               ostream &output) const {
+    output << "No path exists from \"" << frozen_.get_name(source) 
+        << "\" to \"" << frozen_.get_name(dest) << "\".\n";
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: print_search
+* @purpose: output the result of a search engine that returns its path
+*
+* @preconditions: none
+* @postconditions: the path is printed, or a "No path exists" message if the path is empty
+*
+* @parameters: 1) a std::stack<VertexId> value, the path with the source on top (empty if none was found)
+*             2) a VertexId, the source artist
+*             3) a VertexId, the destination artist
+*             4) a std::ostream reference, the output stream for the path
+* @returns: none
+*/
+void SixDegrees::print_search(std::stack<VertexId> path, VertexId source,
+                              VertexId dest, ostream &output) const {
+    if (path.empty()) {
+        print_no_path(source, dest, output);
+    } else {
+        print_path(path, output);
     }
 }
\ No newline at end of file
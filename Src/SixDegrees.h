@@ -5,11 +5,19 @@
 **
 ** Purpose:
 **   Implements the SixDegrees class to manage a collaboration graph of artists,
-**   process commands (bfs, dfs, not, quit), and output paths of collaborations
-**   between artists based on the provided input.
-**      
-**      change log
+**   process commands (bfs, dfs, not, songs, dist, components, critical,
+**   stats, flush, quit, and the catalog updates add-artist, remove-artist,
+**   add-song and remove-song), and output paths of collaborations between
+**   artists based on the provided input.
+**
+** ChangeLog:
 **     April 2025:
+**       Queries run on a frozen CSR graph, optionally on worker threads
+**       Added search engines, landmarks, distance labels, a result cache
+**       and pooled search trees
+**       Added catalog updates, components, critical and stats commands
+**       Output is buffered; queries can be served over a socket
+**       Populated graphs can be renumbered for locality
 **/
 
 #ifndef __SIX_DEGREES__
@@ -17,44 +25,286 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 #include <queue>
 #include <stack>
+#include <unordered_map>
 
+#include "BlockCutTree.h"
+#include "Catalog.h"
 #include "CollabGraph.h"
+#include "CommandParser.h"
+#include "ComponentIndex.h"
+#include "DistanceLabels.h"
+#include "FrozenGraph.h"
+#include "GraphEditor.h"
+#include "LandmarkIndex.h"
+#include "QueryStats.h"
+#include "ResultCache.h"
+#include "TreePool.h"
+#include "TraversalContext.h"
+#include "VertexOrder.h"
+
+class QueryServer;
 
 class SixDegrees {
 public:
+    // How bfs and not look for a shortest path
+    enum SearchMode {
+        CLASSIC_SEARCH,              // one-sided breadth-first search
+        BIDIRECTIONAL_SEARCH,        // frontiers grown from both ends
+        DIRECTION_OPTIMIZING_SEARCH, // top-down/bottom-up bitset sweeps
+        LANDMARK_SEARCH,             // A* steered by landmark distances
+        LABEL_SEARCH                 // paths read off the distance labels
+    };
+
+    // Landmarks LANDMARK_SEARCH uses when none were asked for
+    static const size_t DEFAULT_LANDMARKS = 16;
+
     SixDegrees();
+
+    // Choose the shortest-path engine behind bfs and not (classic by default)
+    void set_search_mode(SearchMode mode);
+
+    // Precompute distances from this many landmark artists (0 for none),
+    // for the dist command and LANDMARK_SEARCH; kept up to date whenever
+    // the graph is rebuilt or loaded
+    void set_landmarks(size_t num_landmarks);
+
+    // Build exact distance labels (see DistanceLabels) for the dist command
+    // and LABEL_SEARCH, also whenever the graph is rebuilt; a snapshot
+    // saved with labels brings its own
+    void set_labels(bool use_labels);
+
+    // Remember the answers to recent queries in at most this many bytes
+    // (0, the default, for no cache); repeated queries then skip their
+    // search. The cache is emptied whenever the graph, its indexes or the
+    // search mode change
+    void set_cache_budget(size_t bytes);
+    void print_cache_stats(std::ostream &out) const;
+
+    // Keep the whole search tree of up to this many recent bfs sources
+    // (0, the default, for none), so later bfs queries from them walk a
+    // tree instead of searching; dropped whenever the graph changes
+    void set_tree_pool(size_t num_trees);
+
+    // Flush the output after every command, for a person or program
+    // waiting on each answer; off by default, when output is only flushed
+    // at the end of the run, of each batch, and on a flush command
+    void set_interactive(bool interactive);
+
+    // Time every command, and each phase of every query, and count the
+    // work the searches do (off by default); the stats command and
+    // print_stats report percentiles of what was collected
+    void set_stats(bool collect);
+    void print_stats(std::ostream &out) const;
+
+    // Renumber the artists of every graph populated from now on (see
+    // VertexOrder), so those a search visits together sit together in
+    // memory; answers stay the same but for ties, such as which of two
+    // equally short paths is printed. A loaded snapshot keeps the
+    // numbering it was saved with
+    void set_vertex_order(VertexOrder::Method method);
     
-    // Populate the graph from a data file
+    // Populate the graph from a data file, then freeze it for querying
     void populate_graph(std::istream &data_stream);
+
+    // Same, but from the file at 'path', memory-mapped and parsed in place
+    // if it is a regular file; false if it cannot be opened or mapped
+    bool populate_graph_from_file(const std::string &path);
+
+    // Populate the graph by comparing every pair of artists; kept as the
+    // reference builder that populate_graph is checked and timed against
+    void populate_graph_pairwise(std::istream &data_stream);
+
+    // Print every vertex and its edges (see CollabGraph::print_graph)
+    void print_graph(std::ostream &out);
+
+    // Write the graph to a binary snapshot, or serve it from one (the file
+    // is memory-mapped, so loading skips parsing entirely)
+    void save_snapshot(const std::string &path) const;
+    void load_snapshot(const std::string &path);
     
-    // Run the command loop, reading from input and writing to output
+    // Run the command loop, reading from input and writing to output.
+    // Catalog updates change the graph in place, touching only the
+    // artists they name and their collaborators; they drop the landmarks
+    // and labels, which come back when the graph is next rebuilt or
+    // loaded (or set_landmarks/set_labels is called again). Output is
+    // buffered, and flushed as set_interactive describes
     void run(std::istream &input, std::ostream &output);
+
+    // Run the same commands on a pool of threads; output is identical to
+    // run. A catalog update waits for the queries before it and is
+    // applied before any query after it starts
+    void run_batch(std::istream &input, std::ostream &output,
+                   size_t num_threads);
+
+    // Answer the commands of every client of a QueryServer until it is
+    // stopped; each client gets what run would write for its commands.
+    // Catalog updates and stats wait for the queries before them, from
+    // any client
+    void serve(QueryServer &server);
     
 private:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef FrozenGraph::EdgeId EdgeId;
+
+    // Graph under construction while populating; frozen_ answers queries
     CollabGraph graph_;
+    FrozenGraph frozen_;
+
+    // Visited marks and predecessors reused by each traversal
+    TraversalContext context_;
+
+    SearchMode search_mode_;
+
+    // The connected component of every artist, rebuilt with frozen_ and
+    // kept up to date by catalog updates
+    ComponentIndex components_;
+
+    // The blocks and cut vertices of frozen_, rebuilt with it; dropped by
+    // catalog updates
+    BlockCutTree blocks_;
+
+    // Which artists sing which songs, for catalog updates; built with
+    // frozen_, or derived from it on the first update after a load
+    Catalog catalog_;
+
+    // Changes frozen_ in place; made on the first catalog update
+    std::unique_ptr<GraphEditor> editor_;
+
+    // Distances from landmark artists, rebuilt with frozen_
+    size_t num_landmarks_;
+    LandmarkIndex landmarks_;
+
+    // Exact distance labels of frozen_, if asked for or loaded with it
+    bool use_labels_;
+    DistanceLabels labels_;
+
+    // Answers of recent queries; filled by the const query functions,
+    // and safe to share between threads
+    mutable ResultCache cache_;
+
+    // Search trees of recent bfs sources; shared between threads too
+    mutable TreePool trees_;
+
+    // Latencies and search counts, if collecting; shared between threads
+    mutable QueryStats stats_;
+
+    // Whether run flushes its output after every command
+    bool interactive_;
+
+    // How populated graphs are renumbered before they are queried
+    VertexOrder::Method vertex_order_;
+
+    // Compact graph_ into frozen_ and release graph_; returns the new ids
+    // if frozen_ was renumbered
+    std::vector<VertexId> freeze_graph();
+
+    // Renumber frozen_ as vertex_order_ says; returns the new id of every
+    // old one, or nothing if the ids were kept
+    std::vector<VertexId> reorder_graph();
+
+    // Rebuild the components, blocks and landmarks of frozen_, and its
+    // labels if they are wanted and missing
+    void build_indexes();
+
+    // Parse artist records out of a block of memory and build frozen_
+    // from them, without going through graph_
+    void build_graph(const char *begin, const char *end);
+
+    // Read artist records (name, songs, '*') into the graph's vertex set
+    void parse_artists(std::istream &data_stream,
+                       std::vector<Artist> &artists);
     
-    // Process individual commands
-    void process_command(const std::string &command, 
-                        std::istream &input, 
-                        std::ostream &output);
+    // Commands parsed ahead of time by run_batch before running them
+    static const size_t BATCH_SIZE = 4096;
+
+    // Process individual commands, timing them if stats_ is collecting
+    void process_command(const Command &command, 
+                        TraversalContext &context, 
+                        std::ostream &output) const;
+    void dispatch_command(const Command &command, TraversalContext &context,
+                          std::ostream &output,
+                          QueryStats::Stopwatch *watch) const;
+
+    // Whether a command updates the catalog rather than querying it
+    static bool is_update(const Command &command);
+
+    // Whether a command must wait for every command before it and finish
+    // before any after it starts (updates, stats and flush), and run one
+    static bool runs_alone(const Command &command);
+    void run_alone(const Command &command, std::ostream &output);
+
+    // Apply a catalog update (add-artist, remove-artist, add-song,
+    // remove-song) to frozen_ and everything built on it
+    void update(const Command &command, std::ostream &output);
+    void add_artist(const std::string &name, std::ostream &output);
+    void remove_artist(const std::string &name, std::ostream &output);
+    void add_song(const std::string &name, const std::string &title,
+                  std::ostream &output);
+    void remove_song(const std::string &name, const std::string &title,
+                     std::ostream &output);
+
+    // Make frozen_ editable, and the catalog match it
+    GraphEditor &editor();
+
+    // Give two artists' collaboration the songs the catalog says they
+    // share, adding or removing it, and mending the components, as needed
+    void relink(VertexId a, VertexId b);
+
+    // Drop what no longer fits a graph with more artists or different
+    // collaborations; cached answers only go if 'answers_changed'
+    void graph_changed(bool answers_changed);
+
+    // Answer a command whose artists are all resolved
+    void answer(const Command &command, VertexId source, VertexId dest,
+                const std::vector<VertexId> &exclude,
+                TraversalContext &context, std::ostream &output) const;
+    
+    // Traversal algorithms; the graph is read-only, all search state is
+    // kept in the TraversalContext
+    void bfs(VertexId source, VertexId dest,
+             TraversalContext &context, std::ostream &output) const;
+    void dfs(VertexId source, VertexId dest,
+             TraversalContext &context, std::ostream &output) const;
+    void not_search(VertexId source, 
+                    VertexId dest, 
+                    const std::vector<VertexId> &exclude, 
+                    TraversalContext &context,
+                    std::ostream &output) const;
+
+    // Read a bfs path off a pooled search tree, growing one if needed
+    std::stack<VertexId> tree_path(VertexId source, VertexId dest) const;
+
+    // List every song two artists share (the songs command)
+    void list_songs(VertexId source, VertexId dest,
+                    std::ostream &output) const;
+
+    // Find (or bound) how many collaborations apart two artists are (the
+    // dist command)
+    void dist(VertexId source, VertexId dest,
+              TraversalContext &context, std::ostream &output) const;
     
-    // Traversal algorithms
-    void bfs(const Artist &source, const Artist &dest, std::ostream &output);
-    void dfs(const Artist &source, const Artist &dest, std::ostream &output);
-    void not_search(const Artist &source, 
-                    const Artist &dest, 
-                    std::vector<Artist> &exclude, 
-                    std::ostream &output);
+    // Report how many artists each connected component holds (the
+    // components command)
+    void list_components(std::ostream &output) const;
+
+    // List the artists and collaborations whose loss would disconnect
+    // other artists (the critical command)
+    void list_critical(std::ostream &output) const;
     
     // Output path formatting
-    void print_path(std::stack<Artist> path, std::ostream &output);
+    void print_path(std::stack<VertexId> path, std::ostream &output) const;
+    void print_no_path(VertexId source, VertexId dest,
+                       std::ostream &output) const;
+    void print_search(std::stack<VertexId> path, VertexId source,
+                      VertexId dest, std::ostream &output) const;
     
-    // Check if artist exists and handle errors
-    bool is_valid_artist(const std::string &name, std::ostream &output);
+    // Look up an artist's id, reporting artists that do not exist
+    VertexId resolve_artist(const std::string &name, std::ostream &output) const;
 };
 
 #endif /* __SIX_DEGREES__ */
\ No newline at end of file
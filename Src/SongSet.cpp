@@ -0,0 +1,254 @@
+/**
+** SongSet.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A set of song ids kept as a sorted array, so the songs two artists
+**   share are found by intersecting two sorted arrays instead of testing
+**   every song of one against every song of the other.
+**
+** ChangeLog:
+**     April 2025:
+**       SongSet class created
+**/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "SongSet.h"
+
+using namespace std;
+
+typedef SongSet::SongId SongId;
+
+/*********************************************************************
+ ******************** helper function definitions ********************
+*********************************************************************/
+
+namespace {
+
+/* past this size ratio, galloping through the larger array beats
+ * merging with it */
+const size_t GALLOP_RATIO = 32;
+
+/* sets up to this size are intersected without allocating */
+const size_t SMALL_SET = 64;
+
+/* first position in [from, size) whose id is not below 'song', found by
+ * doubling the step from 'from' and then bisecting the last step */
+size_t gallop(const SongId *ids, size_t from, size_t size, SongId song)
+{
+    size_t step = 1;
+    size_t low = from, high = from;
+    while (high < size and ids[high] < song) {
+        low = high + 1;
+        high = from + step;
+        step *= 2;
+    }
+    if (high > size) high = size;
+
+    return lower_bound(ids + low, ids + high, song) - ids;
+}
+
+/* intersect a small array with one much larger by galloping through the
+ * larger one; positions always refer to 'a', whichever side is small */
+size_t intersect_galloping(const SongId *a, size_t size_a,
+                           const SongId *b, size_t size_b,
+                           uint32_t *positions)
+{
+    size_t count = 0;
+    if (size_a <= size_b) {
+        size_t j = 0;
+        for (size_t i = 0; i < size_a and j < size_b; i++) {
+            j = gallop(b, j, size_b, a[i]);
+            if (j < size_b and b[j] == a[i]) positions[count++] = i;
+        }
+    } else {
+        size_t i = 0;
+        for (size_t j = 0; j < size_b and i < size_a; j++) {
+            i = gallop(a, i, size_a, b[j]);
+            if (i < size_a and a[i] == b[j]) positions[count++] = i;
+        }
+    }
+
+    return count;
+}
+
+/* intersect two arrays of similar size a block of four ids at a time */
+size_t intersect_merging(const SongId *a, size_t size_a,
+                         const SongId *b, size_t size_b,
+                         uint32_t *positions)
+{
+    size_t count = 0;
+    size_t i = 0, j = 0;
+
+#ifdef __SSE2__
+    /* Compare a block of a against all four rotations of a block of b;
+     * each id of a equals at most one id of b, so no match is counted
+     * twice. Then step past whichever block ends lower (or both) */
+    while (i + 4 <= size_a and j + 4 <= size_b) {
+        __m128i block_a = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(a + i));
+        __m128i block_b = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(b + j));
+
+        __m128i equal = _mm_cmpeq_epi32(block_a, block_b);
+        equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block_a,
+                    _mm_shuffle_epi32(block_b, _MM_SHUFFLE(0, 3, 2, 1))));
+        equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block_a,
+                    _mm_shuffle_epi32(block_b, _MM_SHUFFLE(1, 0, 3, 2))));
+        equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block_a,
+                    _mm_shuffle_epi32(block_b, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        for (size_t k = 0; mask != 0; k++, mask >>= 1) {
+            if (mask & 1) positions[count++] = i + k;
+        }
+
+        SongId last_a = a[i + 3], last_b = b[j + 3];
+        if (last_a <= last_b) i += 4;
+        if (last_b <= last_a) j += 4;
+    }
+#endif
+
+    while (i < size_a and j < size_b) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            positions[count++] = i;
+            i++;
+            j++;
+        }
+    }
+
+    return count;
+}
+
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* insert
+* purpose: add a song to the set
+*
+* parameters: a SongId, the song
+* returns: a bool, true iff the song was not in the set before
+*/
+bool SongSet::insert(SongId song)
+{
+    uint32_t rank = ids.size();
+    if (ids.empty() or ids.back() < song) {
+        ids.push_back(song);
+        ranks.push_back(rank);
+        return true;
+    }
+
+    vector<SongId>::iterator at = lower_bound(ids.begin(), ids.end(), song);
+    if (*at == song) return false;
+
+    ranks.insert(ranks.begin() + (at - ids.begin()), rank);
+    ids.insert(at, song);
+    return true;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* contains
+* purpose: determine whether a song is in the set
+*
+* parameters: a SongId, the song
+* returns: a bool, true iff the song is in the set
+*/
+bool SongSet::contains(SongId song) const
+{
+    return binary_search(ids.begin(), ids.end(), song);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* intersect
+* purpose: find the songs this set shares with another
+*
+* parameters: 1) a const SongSet reference, the other set
+*             2) a vector<SongId> reference, replaced with the shared songs
+*                in the order they were first inserted into this set
+* returns: none
+*/
+void SongSet::intersect(const SongSet &other, vector<SongId> &common) const
+{
+    common.clear();
+    if (ids.empty() or other.ids.empty() or ids.back() < other.ids.front() or
+        other.ids.back() < ids.front()) {
+        return;
+    }
+
+    /* most artists have few songs; only prolific ones need the heap */
+    uint32_t small[SMALL_SET];
+    vector<uint32_t> large;
+    uint32_t *positions = small;
+    if (min(ids.size(), other.ids.size()) > SMALL_SET) {
+        large.resize(min(ids.size(), other.ids.size()));
+        positions = large.data();
+    }
+    size_t count = intersect_sorted(ids.data(), ids.size(),
+                                    other.ids.data(), other.ids.size(),
+                                    positions);
+    if (count == 0) return;
+
+    vector<pair<uint32_t, SongId>> by_rank(count);
+    for (size_t k = 0; k < count; k++) {
+        by_rank[k] = make_pair(ranks[positions[k]], ids[positions[k]]);
+    }
+    sort(by_rank.begin(), by_rank.end());
+
+    common.reserve(count);
+    for (const pair<uint32_t, SongId> &song : by_rank) {
+        common.push_back(song.second);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* intersect_sorted
+* purpose: find the ids two ascending arrays have in common
+*
+* parameters: 1) a const SongId pointer and a size_t, the first array,
+*                ascending and without repeats
+*             2) a const SongId pointer and a size_t, the second array,
+*                ascending and without repeats
+*             3) a uint32_t pointer, room for min(size_a, size_b)
+*                positions; receives the position in the first array of
+*                each shared id, ascending
+* returns: a size_t, the number of shared ids
+*/
+size_t SongSet::intersect_sorted(const SongId *a, size_t size_a,
+                                 const SongId *b, size_t size_b,
+                                 uint32_t *positions)
+{
+    if (size_a == 0 or size_b == 0) return 0;
+
+    if (size_a > GALLOP_RATIO * size_b or size_b > GALLOP_RATIO * size_a) {
+        return intersect_galloping(a, size_a, b, size_b, positions);
+    }
+
+    return intersect_merging(a, size_a, b, size_b, positions);
+}
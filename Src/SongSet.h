@@ -0,0 +1,56 @@
+/**
+** SongSet.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A set of song ids kept as a sorted array, so the songs two artists
+**   share are found by intersecting two sorted arrays instead of testing
+**   every song of one against every song of the other.
+**
+** Notes:
+**   1) Ids are any 32-bit song ids (StringPool symbols in Artist)
+**   2) Next to each id the set remembers the order ids were first
+**      inserted in, so shared songs can be listed in discography order
+**   3) intersect_sorted picks its kernel by the sizes of the inputs: a
+**      block merge comparing four ids against four with SSE2 (a plain
+**      merge where SSE2 is missing) for similar sizes, and a galloping
+**      search of the larger array when one is over 32 times the other
+**   4) An id inserted larger than every id so far (a song nobody has
+**      sung before gets the next symbol) is appended in O(1)
+**
+** ChangeLog:
+**     April 2025:
+**       SongSet class created
+**/
+
+#ifndef __SONG_SET__
+#define __SONG_SET__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SongSet {
+
+public:
+    typedef uint32_t SongId;
+
+    bool insert(SongId song);
+    bool contains(SongId song) const;
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    void intersect(const SongSet &other, std::vector<SongId> &common) const;
+
+    static size_t intersect_sorted(const SongId *a, size_t size_a,
+                                   const SongId *b, size_t size_b,
+                                   uint32_t *positions);
+
+private:
+    std::vector<SongId> ids;        // ascending
+    std::vector<uint32_t> ranks;    // ranks[i]: insertion order of ids[i]
+};
+
+#endif /* __SONG_SET__ */
@@ -0,0 +1,205 @@
+/**
+** StringPool.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A symbol table: every distinct string is stored once, back to back in
+**   one character arena, and is known by a dense 32-bit symbol id from
+**   then on.
+**
+** ChangeLog:
+**     April 2025:
+**       StringPool class created
+**/
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "StringPool.h"
+
+using namespace std;
+
+typedef StringPool::Symbol Symbol;
+
+const Symbol StringPool::NO_SYMBOL;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find (View)
+* purpose: look up the symbol of a string
+*
+* parameters: a const StringRef reference, the string to look up
+* returns: a Symbol, the string's symbol, or NO_SYMBOL if it is not in the
+*          table (or the table was stored without a probe table)
+*/
+Symbol StringPool::View::find(const StringRef &str) const
+{
+    if (num_slots == 0) return NO_SYMBOL;
+
+    size_t mask = num_slots - 1;
+    for (size_t i = StringRefHash()(str) & mask; ; i = (i + 1) & mask) {
+        Symbol s = slots[i];
+        if (s == NO_SYMBOL or get(s) == str) return s;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an empty StringPool
+*
+* @preconditions: none
+* @postconditions: the pool holds no strings
+*
+* @parameters: none
+*/
+StringPool::StringPool()
+    : starts(1, 0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: View constructor
+* @purpose: initialize a StringPool holding the strings of a View
+*
+* @preconditions: none
+* @postconditions: the pool holds the view's strings under the same symbols
+*
+* @parameters: a const View reference, the table to copy; it need not have
+*              a probe table, which is rebuilt if missing
+*/
+StringPool::StringPool(const View &view)
+    : chars(view.chars, view.starts[view.count]),
+      starts(view.starts, view.starts + view.count + 1),
+      slots(view.slots, view.slots + view.num_slots)
+{
+    if (slots.empty() and size() > 0) {
+        size_t num_slots = 16;
+        while (num_slots < 2 * (size() + 1)) num_slots *= 2;
+        rehash(num_slots);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* intern
+* purpose: add a string to the pool unless it is already there
+*
+* parameters: a const StringRef reference, the string (which may point
+*             anywhere, including into this pool)
+* returns: a Symbol, the string's symbol
+*
+* notes: throws a runtime_error once the pool runs out of 32-bit symbols
+*/
+Symbol StringPool::intern(const StringRef &str)
+{
+    if (2 * (size() + 1) > slots.size()) {
+        rehash(slots.empty() ? 16 : 2 * slots.size());
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t i = StringRefHash()(str) & mask;
+    for (; slots[i] != NO_SYMBOL; i = (i + 1) & mask) {
+        if (get(slots[i]) == str) return slots[i];
+    }
+
+    if (size() >= NO_SYMBOL) {
+        string message = "string pool has run out of symbols";
+        throw runtime_error(message.c_str());
+    }
+
+    /* 'str' may point into the arena, which append can move */
+    less<const char *> before;
+    const char *arena = chars.data();
+    Symbol symbol = size();
+    if (not before(str.data(), arena) and
+        before(str.data(), arena + chars.size())) {
+        chars.append(chars, str.data() - arena, str.size());
+    } else {
+        chars.append(str.data(), str.size());
+    }
+    starts.push_back(chars.size());
+    slots[i] = symbol;
+
+    return symbol;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* reserve
+* purpose: make room for a number of strings without rehashing
+*
+* parameters: a size_t, how many strings the pool will hold
+* returns: none
+*/
+void StringPool::reserve(size_t count)
+{
+    starts.reserve(count + 1);
+
+    size_t num_slots = slots.empty() ? 16 : slots.size();
+    while (num_slots < 2 * count) num_slots *= 2;
+    if (num_slots > slots.size()) rehash(num_slots);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* view
+* purpose: get the read-only tables of the pool
+*
+* parameters: none
+* returns: a View of the pool, valid until the next intern
+*/
+StringPool::View StringPool::view() const
+{
+    View view;
+    view.starts = starts.data();
+    view.chars = chars.data();
+    view.slots = slots.data();
+    view.num_slots = slots.size();
+    view.count = size();
+    return view;
+}
+
+
+
+
+
+/**********************************************************************
+ ******************** private function definitions ********************
+**********************************************************************/
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* rehash
+* purpose: rebuild the probe table with a new number of slots
+*
+* parameters: a size_t, the new number of slots, a power of two larger
+*             than twice the number of strings
+* returns: none
+*/
+void StringPool::rehash(size_t num_slots)
+{
+    slots.assign(num_slots, NO_SYMBOL);
+
+    size_t mask = num_slots - 1;
+    for (Symbol s = 0; s < size(); s++) {
+        size_t i = StringRefHash()(get(s)) & mask;
+        while (slots[i] != NO_SYMBOL) i = (i + 1) & mask;
+        slots[i] = s;
+    }
+}
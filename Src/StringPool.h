@@ -0,0 +1,83 @@
+/**
+** StringPool.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A symbol table: every distinct string is stored once, back to back in
+**   one character arena, and is known by a dense 32-bit symbol id from
+**   then on. Comparing two interned strings is comparing two integers.
+**
+** Notes:
+**   1) Symbols are handed out in first-intern order: 0, 1, 2, ...
+**   2) Lookups go through an open-addressing table of symbols (linear
+**      probing, kept at most half full), hashed with StringRefHash
+**   3) A StringRef returned by get() points into the arena and is only
+**      valid until the next intern
+**   4) View is the read-only part of a pool (arena, string starts and the
+**      probe table), which is all get and find need; FrozenGraph keeps its
+**      name and title tables as Views, whether they sit in a pool or in a
+**      mapped snapshot
+**   5) Not safe to intern from several threads at once
+**   6) A pool can be made from a View, copying its tables, to go on
+**      interning into a table that was only read so far
+**
+** ChangeLog:
+**     April 2025:
+**       StringPool class created
+**       Pools can be copied out of a View
+**/
+
+#ifndef __STRING_POOL__
+#define __STRING_POOL__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "StringRef.h"
+
+class StringPool {
+
+public:
+    typedef uint32_t Symbol;
+
+    /* symbol returned by find for strings that were never interned */
+    static const Symbol NO_SYMBOL = UINT32_MAX;
+
+    struct View {
+        const uint64_t *starts;     // string s is chars[starts[s], starts[s + 1])
+        const char *chars;
+        const Symbol *slots;        // probe table, NO_SYMBOL where empty
+        size_t num_slots;           // a power of two, or 0 if no lookups
+        size_t count;
+
+        StringRef get(Symbol s) const
+        {
+            return StringRef(chars + starts[s], starts[s + 1] - starts[s]);
+        }
+
+        Symbol find(const StringRef &str) const;
+    };
+
+    StringPool();
+    explicit StringPool(const View &view);
+
+    Symbol intern(const StringRef &str);
+    Symbol find(const StringRef &str) const { return view().find(str); }
+    StringRef get(Symbol s) const { return view().get(s); }
+
+    size_t size() const { return starts.size() - 1; }
+    void reserve(size_t count);
+
+    View view() const;
+
+private:
+    std::string chars;
+    std::vector<uint64_t> starts;
+    std::vector<Symbol> slots;
+
+    void rehash(size_t num_slots);
+};
+
+#endif /* __STRING_POOL__ */
@@ -0,0 +1,105 @@
+/**
+** StringRef.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A non-owning view of a run of characters (pointer and length), used
+**   for names and song titles that live in a larger block of memory such
+**   as a graph's string table or a memory-mapped file, so they can be
+**   compared and printed without copying them into a std::string.
+**
+** Notes:
+**   1) A StringRef never owns its characters; whatever holds them must
+**      outlive it
+**   2) Comparisons are byte-wise, like std::string's
+**   3) StringRefHash lets a StringRef key an unordered container
+**
+** ChangeLog:
+**     April 2025:
+**       StringRef class created
+**/
+
+#ifndef __STRING_REF__
+#define __STRING_REF__
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+class StringRef {
+
+public:
+    StringRef() : chars(""), length(0) {}
+    StringRef(const char *chars, size_t length)
+        : chars(chars), length(length) {}
+    StringRef(const char *str) : chars(str), length(strlen(str)) {}
+    StringRef(const std::string &str)
+        : chars(str.data()), length(str.size()) {}
+
+    const char *data() const { return chars; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    char operator[](size_t i) const { return chars[i]; }
+
+    std::string str() const { return std::string(chars, length); }
+
+    int compare(const StringRef &other) const
+    {
+        size_t shorter = length < other.length ? length : other.length;
+        int result = shorter == 0 ? 0 : memcmp(chars, other.chars, shorter);
+        if (result != 0) return result;
+        if (length == other.length) return 0;
+        return length < other.length ? -1 : 1;
+    }
+
+    friend bool operator==(const StringRef &a, const StringRef &b)
+    {
+        return a.length == b.length and
+               (a.length == 0 or memcmp(a.chars, b.chars, a.length) == 0);
+    }
+    friend bool operator!=(const StringRef &a, const StringRef &b)
+    {
+        return not (a == b);
+    }
+    friend bool operator<(const StringRef &a, const StringRef &b)
+    {
+        return a.compare(b) < 0;
+    }
+    friend std::ostream &operator<<(std::ostream &out, const StringRef &s)
+    {
+        return out.write(s.chars, s.length);
+    }
+
+private:
+    const char *chars;
+    size_t length;
+};
+
+/* 64-bit FNV-1a a word at a time, with a final mix so that every input
+ * bit reaches the low bits buckets are picked from */
+struct StringRefHash {
+    size_t operator()(const StringRef &s) const
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        const char *p = s.data();
+        size_t n = s.size();
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t word;
+            memcpy(&word, p, 8);
+            hash = (hash ^ word) * 0x100000001b3ULL;
+        }
+        if (n > 0) {
+            uint64_t word = 0;
+            memcpy(&word, p, n);
+            hash = (hash ^ word) * 0x100000001b3ULL;
+        }
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+};
+
+#endif /* __STRING_REF__ */
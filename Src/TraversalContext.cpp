@@ -0,0 +1,150 @@
+/**
+** TraversalContext.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Hold the per-query state of a graph traversal (which vertices have
+**   been visited, and the predecessor of each) outside of the graph, so
+**   a FrozenGraph stays read-only while it is being searched and several
+**   searches can share it.
+**
+** ChangeLog:
+**     April 2025:
+**       TraversalContext class created
+**       Added traversal counters
+**       Added a reusable frontier buffer
+**/
+
+#include <stack>
+#include <vector>
+
+#include "TraversalContext.h"
+
+using namespace std;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: nullary constructor
+* @purpose: initialize an empty TraversalContext instance
+*
+* @preconditions: none
+* @postconditions: reset must be called before the context is used
+*
+* @parameters: none
+*/
+TraversalContext::TraversalContext()
+    : epoch(0)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* reset
+* purpose: prepare the context for a new traversal of a graph
+*
+* parameters: a size_t, the number of vertices in the graph to traverse
+* returns: none
+*
+* postconditions: no vertex is marked and no vertex has a predecessor, and
+*                 the frontier is empty
+*
+* notes: only the epoch changes, unless the graph has grown since the
+*        last traversal or the epoch counter wraps around, in which case
+*        the stamps are cleared in O(V)
+*/
+void TraversalContext::reset(size_t num_vertices)
+{
+    if (stamps.size() < num_vertices) {
+        stamps.resize(num_vertices, 0);
+        predecessor.resize(num_vertices, FrozenGraph::NO_VERTEX);
+        distance.resize(num_vertices, 0);
+    }
+
+    pending.clear();
+
+    epoch++;
+    if (epoch == 0) {
+        stamps.assign(stamps.size(), 0);
+        epoch = 1;
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* report_path
+* purpose: accumulate the path from 'source' to 'dest' using the
+*          predecessors set by the current traversal
+*
+* parameters: 1) a VertexId, the source vertex
+*             2) a VertexId, the destination vertex
+* returns:    a stack of VertexIds where the top-most element is the source
+*             and the bottom-most element is the destination, or an empty
+*             stack if the predecessors do not lead back to the source
+*/
+stack<TraversalContext::VertexId>
+TraversalContext::report_path(VertexId source, VertexId dest) const
+{
+    stack<VertexId> path;
+
+    VertexId current = dest;
+    path.push(current);
+
+    while (current != source) {
+        current = get_predecessor(current);
+        if (current == FrozenGraph::NO_VERTEX) return stack<VertexId>();
+        path.push(current);
+    }
+
+    return path;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* backward
+* purpose: retrieve the context that holds the destination side of a
+*          bidirectional search
+*
+* parameters: none
+* returns: a TraversalContext reference, created on first use and owned by
+*          this context; its marks and predecessors are independent of
+*          this context's, and it must be reset on its own
+*/
+TraversalContext &TraversalContext::backward()
+{
+    if (not partner) partner.reset(new TraversalContext());
+    return *partner;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* take_counts
+* purpose: read and clear the work counted since the last call
+*
+* parameters: none
+* returns: a Counts, this context's counts together with its backward()
+*          context's; the two queue peaks are added, which bounds how many
+*          vertices both sides' frontiers held at once
+*/
+TraversalContext::Counts TraversalContext::take_counts()
+{
+    Counts taken = counts;
+    counts = Counts();
+    if (partner) {
+        Counts other = partner->take_counts();
+        taken.visited += other.visited;
+        taken.scanned += other.scanned;
+        taken.queue_peak += other.queue_peak;
+    }
+
+    return taken;
+}
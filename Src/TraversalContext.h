@@ -0,0 +1,121 @@
+/**
+** TraversalContext.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Hold the per-query state of a graph traversal (which vertices have
+**   been visited, and the predecessor of each) outside of the graph, so
+**   a FrozenGraph stays read-only while it is being searched and several
+**   searches can share it.
+**
+** Notes:
+**   1) Visited marks are epoch stamps: a vertex is marked iff its stamp
+**      equals the current epoch, so reset() is O(1) instead of O(V)
+**   2) Marking a vertex clears its predecessor, so predecessors left over
+**      from an earlier query are never reported
+**   3) A context is meant to be reused across queries, but only by one
+**      traversal at a time
+**   4) Searches that grow from both the source and the destination keep
+**      the destination side in backward(), a second context owned by
+**      this one and reset separately
+**   5) Searches that can reach a vertex again by a shorter route (A*)
+**      keep its hop count with set_distance, and re-mark the vertex to
+**      replace its predecessor; the distance of an unmarked vertex is
+**      meaningless
+**   6) Searches report each vertex they expand with count_expansion, so
+**      the work a query did can be read back with take_counts; counting
+**      is a few adds per expanded vertex, never per edge
+**   7) frontier() is a vector a search may use as its queue or stack. It
+**      is emptied by reset but keeps its storage, so once a context has
+**      served a search as large, the next one allocates nothing
+**
+** ChangeLog:
+**     April 2025:
+**       TraversalContext class created
+**       Added per-vertex distances for goal-directed searches
+**       Added traversal counters
+**       Added a reusable frontier buffer
+**/
+
+#ifndef __TRAVERSAL_CONTEXT__
+#define __TRAVERSAL_CONTEXT__
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class TraversalContext {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+
+    /* work done by the searches using a context */
+    struct Counts {
+        uint64_t visited;    // vertices expanded
+        uint64_t scanned;    // adjacency entries looked at
+        uint64_t queue_peak; // most vertices waiting at once
+
+        Counts() : visited(0), scanned(0), queue_peak(0) {}
+    };
+
+    TraversalContext();
+
+    void reset(size_t num_vertices);
+
+    void mark_vertex(VertexId v)
+    {
+        stamps[v] = epoch;
+        predecessor[v] = FrozenGraph::NO_VERTEX;
+    }
+
+    bool is_marked(VertexId v) const { return stamps[v] == epoch; }
+
+    void set_predecessor(VertexId to, VertexId from)
+    {
+        if (predecessor[to] == FrozenGraph::NO_VERTEX) predecessor[to] = from;
+    }
+
+    VertexId get_predecessor(VertexId v) const
+    {
+        return is_marked(v) ? predecessor[v] : FrozenGraph::NO_VERTEX;
+    }
+
+    void set_distance(VertexId v, uint32_t hops) { distance[v] = hops; }
+    uint32_t get_distance(VertexId v) const { return distance[v]; }
+
+    std::stack<VertexId> report_path(VertexId source, VertexId dest) const;
+
+    std::vector<VertexId> &frontier() { return pending; }
+
+    TraversalContext &backward();
+
+    void count_expansion(size_t edges, size_t waiting)
+    {
+        counts.visited++;
+        counts.scanned += edges;
+        if (waiting > counts.queue_peak) counts.queue_peak = waiting;
+    }
+
+    Counts take_counts();
+
+private:
+    uint32_t epoch;
+    std::vector<uint32_t> stamps;
+    std::vector<VertexId> predecessor;
+    std::vector<uint32_t> distance;
+
+    /* storage for the queue or stack of the current search */
+    std::vector<VertexId> pending;
+
+    /* what has been counted since the last take_counts */
+    Counts counts;
+
+    /* second context for searches that grow from both ends */
+    std::unique_ptr<TraversalContext> partner;
+};
+
+#endif /* __TRAVERSAL_CONTEXT__ */
@@ -0,0 +1,175 @@
+/**
+** TreePool.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Keep the whole breadth-first search tree of a few recently used
+**   source artists, so further queries from the same source are answered
+**   by walking a tree instead of searching again.
+**
+** ChangeLog:
+**     April 2025:
+**       TreePool class created
+**/
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "TreePool.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* constructor
+* purpose: initialize an empty pool
+*
+* parameters: a size_t, the most trees the pool may hold; 0 turns it off
+*/
+TreePool::TreePool(size_t capacity)
+    : max_trees(capacity)
+{
+
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* set_capacity
+* purpose: change how many trees the pool may hold
+*
+* parameters: a size_t, the new capacity; 0 turns the pool off
+* returns: none
+*
+* notes: drops the least recently used trees that no longer fit
+*/
+void TreePool::set_capacity(size_t capacity)
+{
+    lock_guard<mutex> guard(lock);
+    max_trees = capacity;
+    if (trees.size() > max_trees) trees.resize(max_trees);
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* find
+* purpose: look up the tree of a source
+*
+* parameters: a VertexId, the source
+* returns: a Tree, the source's tree, or null if the pool has none; a tree
+*          found becomes the most recently used
+*/
+TreePool::Tree TreePool::find(VertexId source)
+{
+    lock_guard<mutex> guard(lock);
+    for (size_t i = 0; i < trees.size(); i++) {
+        if (trees[i].first == source) {
+            pair<VertexId, Tree> found = trees[i];
+            trees.erase(trees.begin() + i);
+            trees.insert(trees.begin(), found);
+            return found.second;
+        }
+    }
+
+    return Tree();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* grow
+* purpose: search the whole graph from a source and keep the tree
+*
+* parameters: 1) a const FrozenGraph reference, the graph the pool serves
+*             2) a VertexId, the source
+* returns: a Tree, the source's tree
+*
+* notes: the search runs without the pool locked. If another thread added
+*        the same source meanwhile, its tree is kept and returned instead;
+*        with the pool off the tree is returned but not kept
+*/
+TreePool::Tree TreePool::grow(const FrozenGraph &graph, VertexId source)
+{
+    shared_ptr<BfsTree> tree(new BfsTree);
+    queue_search(graph, source, *tree);
+    if (not enabled()) return tree;
+
+    lock_guard<mutex> guard(lock);
+    for (const pair<VertexId, Tree> &kept : trees) {
+        if (kept.first == source) return kept.second;
+    }
+    if (trees.size() == max_trees) trees.pop_back();
+    trees.insert(trees.begin(), make_pair(source, Tree(tree)));
+
+    return tree;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* clear
+* purpose: drop every tree
+*
+* parameters: none
+* returns: none
+*/
+void TreePool::clear()
+{
+    lock_guard<mutex> guard(lock);
+    trees.clear();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* queue_search
+* purpose: grow the breadth-first search tree of a source over the whole
+*          graph, in the order the classic search visits artists
+*
+* parameters: 1) a const FrozenGraph reference, the graph
+*             2) a VertexId, the source
+*             3) a BfsTree reference, replaced with the source's tree
+* returns: none
+*
+* notes: artists leave a FIFO queue in the order they entered it and scan
+*        their edges in row order, and a parent is set when an artist is
+*        first reached, as in SixDegrees::bfs
+*/
+void TreePool::queue_search(const FrozenGraph &graph, VertexId source,
+                            BfsTree &tree)
+{
+    size_t n = graph.num_vertices();
+    tree.source = source;
+    tree.distance.assign(n, BfsTree::UNREACHED);
+    tree.parent.assign(n, FrozenGraph::NO_VERTEX);
+
+    /* the distance array doubles as the visited marks, and the queue is
+     * just the artists in the order they were reached */
+    vector<VertexId> queue;
+    queue.reserve(n);
+    queue.push_back(source);
+    tree.distance[source] = 0;
+    for (size_t head = 0; head < queue.size(); head++) {
+        VertexId v = queue[head];
+        uint32_t next = tree.distance[v] + 1;
+        for (EdgeId e = graph.edge_begin(v); e < graph.edge_end(v); e++) {
+            VertexId w = graph.edge_target(e);
+            if (tree.distance[w] == BfsTree::UNREACHED) {
+                tree.distance[w] = next;
+                tree.parent[w] = v;
+                queue.push_back(w);
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/**
+** TreePool.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Keep the whole breadth-first search tree of a few recently used
+**   source artists, so further queries from the same source are answered
+**   by walking the tree's parents from the destination back up, in time
+**   proportional to the path's length instead of another search.
+**
+** Notes:
+**   1) Trees are grown in queue order, exactly as SixDegrees::bfs
+**      searches: every artist's parent is the one the classic search
+**      would record, so a path read off a tree is the path bfs prints
+**   2) The graph is undirected, so a tree also holds a shortest path *to*
+**      its source; read backwards it may differ from the classic path
+**      when there are ties, which callers that need the classic path
+**      must not use
+**   3) The pool holds at most 'capacity' trees (each costs eight bytes
+**      per artist) and drops the least recently used one to make room
+**   4) Trees are handed out as shared pointers, so a tree dropped from
+**      the pool stays valid for whoever is still reading it; the pool is
+**      locked only to look up or add a tree, never while one is grown
+**   5) Trees belong to one graph; the owner must clear the pool when the
+**      graph changes
+**
+** ChangeLog:
+**     April 2025:
+**       TreePool class created
+**/
+
+#ifndef __TREE_POOL__
+#define __TREE_POOL__
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "DirectionOptimizingBFS.h"
+#include "FrozenGraph.h"
+
+class TreePool {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+    typedef std::shared_ptr<const BfsTree> Tree;
+
+    explicit TreePool(size_t capacity = 0);
+
+    void   set_capacity(size_t trees);
+    size_t capacity() const { return max_trees; }
+    bool   enabled() const { return max_trees > 0; }
+
+    Tree find(VertexId source);
+    Tree grow(const FrozenGraph &graph, VertexId source);
+    void clear();
+
+    static void queue_search(const FrozenGraph &graph, VertexId source,
+                             BfsTree &tree);
+
+private:
+    size_t max_trees;
+
+    /* most recently used first */
+    std::vector<std::pair<VertexId, Tree>> trees;
+    std::mutex lock;
+};
+
+#endif /* __TREE_POOL__ */
@@ -0,0 +1,248 @@
+/**
+** VertexOrder.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Renumber the vertices of a FrozenGraph in breadth-first, reverse
+**   Cuthill-McKee or hub-first order, and lay the graph out again under
+**   the new ids.
+**
+** ChangeLog:
+**     April 2025:
+**       VertexOrder class created
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "VertexOrder.h"
+
+using namespace std;
+
+typedef FrozenGraph::VertexId VertexId;
+typedef FrozenGraph::SongId SongId;
+typedef FrozenGraph::EdgeId EdgeId;
+
+/*********************************************************************
+ ******************** helper function definitions ********************
+*********************************************************************/
+
+namespace {
+
+/* Orders vertices by degree, then by id */
+struct ByDegree {
+    const FrozenGraph &graph;
+
+    bool operator()(VertexId a, VertexId b) const
+    {
+        EdgeId da = graph.degree(a), db = graph.degree(b);
+        return da != db ? da < db : a < b;
+    }
+};
+
+/* Append to 'order' the component of 'start', breadth-first; with
+ * 'by_degree', each vertex's new neighbors are appended by increasing
+ * degree instead of in row order */
+void search_from(const FrozenGraph &graph, VertexId start, bool by_degree,
+                 vector<uint8_t> &placed, vector<VertexId> &order)
+{
+    ByDegree less = { graph };
+    placed[start] = 1;
+    order.push_back(start);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+        size_t first = order.size();
+        for (FrozenGraph::Neighbor next : graph.neighbors(order[head])) {
+            if (placed[next.vertex]) continue;
+            placed[next.vertex] = 1;
+            order.push_back(next.vertex);
+        }
+        if (by_degree) sort(order.begin() + first, order.end(), less);
+    }
+}
+
+/* Every component breadth-first, each from its lowest id */
+vector<VertexId> bfs_order(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    vector<uint8_t> placed(n, 0);
+    vector<VertexId> order;
+    order.reserve(n);
+    for (VertexId v = 0; v < n; v++) {
+        if (not placed[v]) search_from(graph, v, false, placed, order);
+    }
+    return order;
+}
+
+/* Every component Cuthill-McKee, each from its vertex of least degree,
+ * then reversed */
+vector<VertexId> rcm_order(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    vector<VertexId> starts(n);
+    for (VertexId v = 0; v < n; v++) starts[v] = v;
+    ByDegree less = { graph };
+    sort(starts.begin(), starts.end(), less);
+
+    vector<uint8_t> placed(n, 0);
+    vector<VertexId> order;
+    order.reserve(n);
+    for (VertexId v : starts) {
+        if (not placed[v]) search_from(graph, v, true, placed, order);
+    }
+    reverse(order.begin(), order.end());
+    return order;
+}
+
+/* Vertices of more than average degree by decreasing degree, then the
+ * rest as they were */
+vector<VertexId> hub_order(const FrozenGraph &graph)
+{
+    size_t n = graph.num_vertices();
+    vector<VertexId> order, rest;
+    for (VertexId v = 0; v < n; v++) {
+        /* degree > entries / n, without the division */
+        if (uint64_t(graph.degree(v)) * n > 2 * graph.num_edges()) {
+            order.push_back(v);
+        } else {
+            rest.push_back(v);
+        }
+    }
+
+    sort(order.begin(), order.end(), [&graph](VertexId a, VertexId b) {
+        EdgeId da = graph.degree(a), db = graph.degree(b);
+        return da != db ? da > db : a < b;
+    });
+    order.insert(order.end(), rest.begin(), rest.end());
+    return order;
+}
+
+}
+
+
+
+
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* compute
+* purpose: choose new ids for the vertices of a graph
+*
+* parameters: 1) a const FrozenGraph reference, the graph
+*             2) a Method, the order to number the vertices in
+* returns: a vector of VertexIds, the new id of every old one
+*
+* notes: O(V + E) for BFS_ORDER, plus the sorting of every vertex's
+*        neighbors for RCM_ORDER and of the hubs for HUB_ORDER.
+*        INSERTION_ORDER keeps every id
+*/
+vector<VertexId> VertexOrder::compute(const FrozenGraph &graph, Method method)
+{
+    size_t n = graph.num_vertices();
+    vector<VertexId> order;
+    if (method == BFS_ORDER) {
+        order = bfs_order(graph);
+    } else if (method == RCM_ORDER) {
+        order = rcm_order(graph);
+    } else if (method == HUB_ORDER) {
+        order = hub_order(graph);
+    } else {
+        order.resize(n);
+        for (VertexId v = 0; v < n; v++) order[v] = v;
+    }
+
+    vector<VertexId> new_id(n);
+    for (VertexId v = 0; v < n; v++) new_id[order[v]] = v;
+    return new_id;
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* relabel
+* purpose: lay a graph out again with its vertices renumbered
+*
+* parameters: 1) a const FrozenGraph reference, the graph
+*             2) a const vector<VertexId> reference, the new id of every
+*                vertex, as compute returns it
+* returns: a FrozenGraph, the same artists and edges under the new ids
+*
+* notes: rows are written in new id order, each with its neighbors
+*        sorted by new id, as GraphEditor and FrozenGraph::find_edge
+*        expect; each edge keeps its songs, in their old order. O(E log d)
+*        for sorting rows of up to d neighbors, plus interning every name
+*        again
+*/
+FrozenGraph VertexOrder::relabel(const FrozenGraph &graph,
+                                 const vector<VertexId> &new_id)
+{
+    size_t n = graph.num_vertices();
+    vector<VertexId> order(n);
+    for (VertexId v = 0; v < n; v++) order[new_id[v]] = v;
+
+    FrozenGraph relabelled;
+    shared_ptr<FrozenGraph::Storage> storage(new FrozenGraph::Storage);
+
+    storage->names.reserve(n);
+    for (VertexId v : order) storage->names.intern(graph.get_name(v));
+    storage->titles = StringPool(graph.titles);
+    if (graph.hidden != nullptr) {
+        storage->hidden.resize(n);
+        for (VertexId v = 0; v < n; v++) {
+            storage->hidden[v] = graph.hidden[order[v]];
+        }
+    }
+
+    /* An edited graph may have unused rows and songs; these are counts of
+     * the ones in use */
+    size_t num_songs = 0;
+    for (VertexId v = 0; v < n; v++) {
+        EdgeId first = graph.edge_begin(v), last = graph.edge_end(v);
+        if (first < last) {
+            num_songs += graph.song_offsets[last] - graph.song_offsets[first];
+        }
+    }
+
+    storage->offsets.resize(n + 1);
+    storage->targets.resize(graph.num_entries);
+    storage->song_offsets.resize(graph.num_entries + 1);
+    storage->songs.resize(num_songs);
+    EdgeId *offsets = storage->offsets.data();
+    VertexId *targets = storage->targets.data();
+    uint32_t *song_offsets = storage->song_offsets.data();
+    SongId *songs = storage->songs.data();
+
+    /* (new target, old edge) for every entry of the row being written */
+    vector<pair<VertexId, EdgeId>> row;
+    EdgeId entry = 0;
+    uint32_t song = 0;
+    offsets[0] = song_offsets[0] = 0;
+    for (VertexId v = 0; v < n; v++) {
+        VertexId old = order[v];
+        row.clear();
+        for (EdgeId e = graph.edge_begin(old); e < graph.edge_end(old); e++) {
+            row.push_back(make_pair(new_id[graph.edge_target(e)], e));
+        }
+        sort(row.begin(), row.end());
+        for (const pair<VertexId, EdgeId> &next : row) {
+            targets[entry] = next.first;
+            for (const SongId *s = graph.edge_songs_begin(next.second);
+                 s != graph.edge_songs_end(next.second); s++) {
+                songs[song++] = *s;
+            }
+            song_offsets[++entry] = song;
+        }
+        offsets[v + 1] = entry;
+    }
+
+    storage->sorted = true;
+    relabelled.adopt(storage);
+    return relabelled;
+}
@@ -0,0 +1,68 @@
+/**
+** VertexOrder.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   Renumber the vertices of a FrozenGraph so that artists a traversal
+**   reaches one after another sit close together in its arrays. Vertex
+**   ids otherwise follow the order artists appear in the data file, so a
+**   search over a large graph jumps all over its offsets, targets and
+**   visited marks, and most steps miss the cache.
+**
+** Notes:
+**   1) compute chooses the new ids; relabel lays the graph out again under
+**      them. new_id[v] is the new id of old vertex v, and every vertex
+**      gets exactly one
+**   2) BFS_ORDER numbers each connected component breadth-first from its
+**      lowest id, so neighbors get nearby ids. RCM_ORDER is the reverse
+**      Cuthill-McKee order: each component is searched from a vertex of
+**      least degree, a vertex's neighbors are numbered by increasing
+**      degree, and the whole order is then reversed, which keeps every
+**      edge's two ids close (a small bandwidth). HUB_ORDER moves the hubs,
+**      vertices of more than average degree, to the front by decreasing
+**      degree, and leaves the others in their old order, so the rows most
+**      searches pass through share a few pages
+**   3) Every order breaks ties by old id, so the same graph is always
+**      numbered the same way
+**   4) relabel sorts each row's neighbors by their new ids, as rows are
+**      sorted in a graph just built, and keeps each edge's songs in their
+**      old order under the same song ids. Shortest paths keep their
+**      lengths, and distances, songs and components do not change, but a
+**      search may meet neighbors in another order and so pick another
+**      path among those of the same length; it always picks the same one
+**      for the same graph and order
+**   5) relabel is meant for a graph just built: rows an editor moved are
+**      laid out back to back again, and hidden artists stay hidden
+**
+** ChangeLog:
+**     April 2025:
+**       VertexOrder class created
+**/
+
+#ifndef __VERTEX_ORDER__
+#define __VERTEX_ORDER__
+
+#include <vector>
+
+#include "FrozenGraph.h"
+
+class VertexOrder {
+
+public:
+    typedef FrozenGraph::VertexId VertexId;
+
+    enum Method {
+        INSERTION_ORDER,
+        BFS_ORDER,
+        RCM_ORDER,
+        HUB_ORDER
+    };
+
+    static std::vector<VertexId> compute(const FrozenGraph &graph,
+                                         Method method);
+    static FrozenGraph relabel(const FrozenGraph &graph,
+                               const std::vector<VertexId> &new_id);
+};
+
+#endif /* __VERTEX_ORDER__ */
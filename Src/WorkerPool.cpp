@@ -0,0 +1,189 @@
+/**
+** WorkerPool.cpp
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A fixed set of worker threads that run queued tasks. Each task is
+**   told which worker runs it, so callers can keep per-worker scratch
+**   state (such as a TraversalContext) without any locking.
+**
+** ChangeLog:
+**     April 2025:
+**       WorkerPool class created
+**/
+
+#include <atomic>
+#include <memory>
+
+#include "WorkerPool.h"
+
+using namespace std;
+
+/*********************************************************************
+ ******************** public function definitions ********************
+*********************************************************************/
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: constructor
+* @purpose: start a pool of worker threads
+*
+* @preconditions: none
+* @postconditions: 'num_workers' threads (at least one) wait for tasks
+*
+* @parameters: a size_t, the number of worker threads
+*/
+WorkerPool::WorkerPool(size_t num_workers)
+    : busy(0), stopping(false)
+{
+    if (num_workers == 0) num_workers = 1;
+
+    for (size_t i = 0; i < num_workers; i++) {
+        workers.push_back(thread(&WorkerPool::work, this, i));
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* @function: destructor
+* @purpose: finish all queued tasks and stop the worker threads
+*
+* @preconditions: none
+* @postconditions: every worker thread has been joined
+*/
+WorkerPool::~WorkerPool()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* size
+* purpose: count the worker threads
+*
+* parameters: none
+* returns: a size_t, the number of workers; worker indices passed to tasks
+*          are in [0, size())
+*/
+size_t WorkerPool::size() const
+{
+    return workers.size();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* submit
+* purpose: queue a task to run on the next free worker
+*
+* parameters: a const Task reference, called with the index of the worker
+*             that runs it
+* returns: none
+*/
+void WorkerPool::submit(const Task &task)
+{
+    {
+        lock_guard<mutex> guard(lock);
+        tasks.push_back(task);
+    }
+    work_ready.notify_one();
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* wait_idle
+* purpose: block until every submitted task has finished
+*
+* parameters: none
+* returns: none
+*/
+void WorkerPool::wait_idle()
+{
+    unique_lock<mutex> guard(lock);
+    while (not tasks.empty() or busy > 0) {
+        all_idle.wait(guard);
+    }
+}
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* parallel_for
+* purpose: run 'body' once for every index in [0, count), spread across
+*          the workers, and wait for all of them
+*
+* parameters: 1) a size_t, the number of indices
+*             2) a function called with (index, worker)
+* returns: none
+*
+* notes: workers claim indices one at a time from a shared counter, so a
+*        few slow indices do not leave the other workers idle
+*/
+void WorkerPool::parallel_for(size_t count,
+                              const function<void(size_t, size_t)> &body)
+{
+    shared_ptr<atomic<size_t>> next = make_shared<atomic<size_t>>(0);
+
+    size_t num_tasks = workers.size() < count ? workers.size() : count;
+    for (size_t t = 0; t < num_tasks; t++) {
+        submit([next, count, &body](size_t worker) {
+            for (size_t i = (*next)++; i < count; i = (*next)++) {
+                body(i, worker);
+            }
+        });
+    }
+
+    wait_idle();
+}
+
+
+
+
+
+/**********************************************************************
+ ******************** private function definitions ********************
+**********************************************************************/
+
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* work
+* purpose: the loop each worker thread runs, taking tasks off the queue
+*
+* parameters: a size_t, the index of this worker
+* returns: none, once the pool is stopping and the queue is empty
+*/
+void WorkerPool::work(size_t worker)
+{
+    unique_lock<mutex> guard(lock);
+
+    while (true) {
+        while (tasks.empty() and not stopping) {
+            work_ready.wait(guard);
+        }
+        if (tasks.empty()) return;
+
+        Task task = tasks.front();
+        tasks.pop_front();
+        busy++;
+
+        guard.unlock();
+        task(worker);
+        guard.lock();
+
+        busy--;
+        if (tasks.empty() and busy == 0) all_idle.notify_all();
+    }
+}
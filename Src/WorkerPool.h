@@ -0,0 +1,65 @@
+/**
+** WorkerPool.h
+**
+** Project Two: Six Degrees of Collaboration
+**
+** Purpose:
+**   A fixed set of worker threads that run queued tasks. Each task is
+**   told which worker runs it, so callers can keep per-worker scratch
+**   state (such as a TraversalContext) without any locking.
+**
+** Notes:
+**   1) Tasks run in no particular order; callers that need ordered
+**      results should write them into slots indexed by task
+**   2) The destructor finishes every queued task before joining
+**
+** ChangeLog:
+**     April 2025:
+**       WorkerPool class created
+**/
+
+#ifndef __WORKER_POOL__
+#define __WORKER_POOL__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+
+public:
+    typedef std::function<void(size_t worker)> Task;
+
+    explicit WorkerPool(size_t num_workers);
+    ~WorkerPool();
+
+    size_t size() const;
+
+    void submit(const Task &task);
+    void wait_idle();
+
+    void parallel_for(size_t count,
+                      const std::function<void(size_t index,
+                                               size_t worker)> &body);
+
+private:
+    WorkerPool(const WorkerPool &);
+    WorkerPool &operator=(const WorkerPool &);
+
+    std::vector<std::thread> workers;
+    std::deque<Task> tasks;
+    size_t busy;
+    bool stopping;
+
+    std::mutex lock;
+    std::condition_variable work_ready;
+    std::condition_variable all_idle;
+
+    void work(size_t worker);
+};
+
+#endif /* __WORKER_POOL__ */
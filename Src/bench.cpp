@@ -0,0 +1,252 @@
+/**
+ ** bench.cpp
+ **
+ ** Project Two: Six Degrees of Collaboration
+ **
+ ** Purpose:
+ **   Benchmark the Six Degrees program on synthetic catalogs (see
+ **   CatalogGenerator) of growing size: time populate_graph, then bfs,
+ **   dfs and not queries between random artists, and print the results
+ **   as CSV, so a change can be compared against a saved run.
+ **
+ **   Options:
+ **     --sizes N,N,...  catalog sizes in artists (default
+ **                      1000,10000,100000,1000000)
+ **     --queries Q      queries of each kind per size (default 100)
+ **     --seed S         seed for the catalogs and the queries (default 1)
+ **     --baseline F     compare each mean with the one in F, the CSV of an
+ **                      earlier run, and print the ratios to stderr
+ **     --reorder O      renumber the artists of every catalog in "bfs",
+ **                      "rcm" or "hubs" order (see VertexOrder), to compare
+ **                      against a run without it
+ **     --write-catalog N F  write an N-artist catalog to F and stop
+ **
+ **   Output: one CSV line per size and phase, with a header line:
+ **     artists,songs,credits,phase,runs,mean_us,p50_us,p99_us,max_us
+ **   populate_graph is run several times on small catalogs, so every
+ **   size takes comparable time; queries whose artists are not connected
+ **   are timed too, as users send them
+ **/
+
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdlib>
+ #include <fstream>
+ #include <iostream>
+ #include <map>
+ #include <random>
+ #include <sstream>
+ #include <string>
+ #include <utility>
+ #include <vector>
+
+ #include "CatalogGenerator.h"
+ #include "SixDegrees.h"
+
+ using namespace std;
+
+ typedef chrono::steady_clock Clock;
+
+ /* Print how to invoke the program */
+ static int usage() {
+     cerr << "Usage: ./bench [--sizes N,N,...] [--queries Q] [--seed S] "
+          << "[--baseline file] [--reorder bfs|rcm|hubs]" << endl
+          << "       ./bench [--seed S] --write-catalog N file" << endl;
+     return 1;
+ }
+
+ /* Microseconds since 'start' */
+ static double elapsed_us(Clock::time_point start) {
+     return chrono::duration<double, micro>(Clock::now() - start).count();
+ }
+
+ /* Write one result line from the times of every run of a phase */
+ static void report(ostream &out, const CatalogGenerator &catalog,
+                    const string &phase, vector<double> times) {
+     sort(times.begin(), times.end());
+     double sum = 0;
+     for (double t : times) sum += t;
+     size_t last = times.size() - 1;
+     out << catalog.num_artists() << "," << catalog.num_songs() << ","
+         << catalog.num_credits() << "," << phase << "," << times.size()
+         << "," << sum / times.size() << "," << times[last * 50 / 100]
+         << "," << times[last * 99 / 100] << "," << times[last] << endl;
+ }
+
+ /* Read the mean of every (artists, phase) out of an earlier run's CSV */
+ static map<pair<string, string>, double> read_baseline(istream &in) {
+     map<pair<string, string>, double> means;
+     string line;
+     getline(in, line);
+     while (getline(in, line)) {
+         vector<string> fields;
+         stringstream row(line);
+         string field;
+         while (getline(row, field, ',')) fields.push_back(field);
+         if (fields.size() < 6) continue;
+         means[make_pair(fields[0], fields[3])] = atof(fields[5].c_str());
+     }
+     return means;
+ }
+
+ /* Time every phase on one catalog size */
+ static void bench_size(ostream &out, size_t num_artists, size_t num_queries,
+                        unsigned seed, VertexOrder::Method order) {
+     CatalogGenerator catalog(num_artists, seed);
+     ostringstream text;
+     catalog.write(text);
+     string data = text.str();
+     text.str("");
+
+     vector<double> times;
+     size_t runs = max<size_t>(1, min<size_t>(20, 100000 / num_artists));
+     SixDegrees six_degrees;
+     for (size_t run = 0; run < runs; run++) {
+         istringstream data_stream(data);
+         SixDegrees fresh;
+         fresh.set_vertex_order(order);
+         Clock::time_point start = Clock::now();
+         fresh.populate_graph(data_stream);
+         times.push_back(elapsed_us(start));
+     }
+     report(out, catalog, "populate_graph", times);
+     {
+         istringstream data_stream(data);
+         six_degrees.set_vertex_order(order);
+         six_degrees.populate_graph(data_stream);
+     }
+     data.clear();
+     data.shrink_to_fit();
+
+     /* Every kind of query runs between the same pairs of artists */
+     mt19937 rng(seed);
+     vector<string> queries[3];
+     const char *phases[3] = { "bfs", "dfs", "not" };
+     for (size_t q = 0; q < num_queries; q++) {
+         string source = "Artist " + to_string(rng() % num_artists);
+         string dest = "Artist " + to_string(rng() % num_artists);
+         string excluded = "Artist " + to_string(rng() % num_artists);
+         queries[0].push_back("bfs\n" + source + "\n" + dest + "\n");
+         queries[1].push_back("dfs\n" + source + "\n" + dest + "\n");
+         queries[2].push_back("not\n" + source + "\n" + dest + "\n" +
+                              excluded + "\n*\n");
+     }
+
+     ostringstream answers;
+     for (int kind = 0; kind < 3; kind++) {
+         times.clear();
+         for (const string &query : queries[kind]) {
+             istringstream command(query);
+             answers.str("");
+             Clock::time_point start = Clock::now();
+             six_degrees.run(command, answers);
+             times.push_back(elapsed_us(start));
+         }
+         report(out, catalog, phases[kind], times);
+     }
+ }
+
+ int main(int argc, char *argv[]) {
+     vector<size_t> sizes = { 1000, 10000, 100000, 1000000 };
+     size_t num_queries = 100;
+     unsigned seed = 1;
+     string baseline_path, catalog_path;
+     size_t catalog_size = 0;
+     VertexOrder::Method order = VertexOrder::INSERTION_ORDER;
+
+     for (int i = 1; i < argc; i++) {
+         string arg = argv[i];
+         if (arg == "--sizes") {
+             if (i + 1 >= argc) return usage();
+             sizes.clear();
+             stringstream list(argv[++i]);
+             string size;
+             while (getline(list, size, ',')) {
+                 long artists = atol(size.c_str());
+                 if (artists < 1) return usage();
+                 sizes.push_back(artists);
+             }
+         } else if (arg == "--queries") {
+             if (i + 1 >= argc) return usage();
+             int count = atoi(argv[++i]);
+             if (count < 1) return usage();
+             num_queries = count;
+         } else if (arg == "--seed") {
+             if (i + 1 >= argc) return usage();
+             seed = strtoul(argv[++i], nullptr, 10);
+         } else if (arg == "--baseline") {
+             if (i + 1 >= argc) return usage();
+             baseline_path = argv[++i];
+         } else if (arg == "--reorder") {
+             if (i + 1 >= argc) return usage();
+             string name = argv[++i];
+             if (name == "bfs") {
+                 order = VertexOrder::BFS_ORDER;
+             } else if (name == "rcm") {
+                 order = VertexOrder::RCM_ORDER;
+             } else if (name == "hubs") {
+                 order = VertexOrder::HUB_ORDER;
+             } else {
+                 return usage();
+             }
+         } else if (arg == "--write-catalog") {
+             if (i + 2 >= argc) return usage();
+             long artists = atol(argv[++i]);
+             if (artists < 1) return usage();
+             catalog_size = artists;
+             catalog_path = argv[++i];
+         } else {
+             return usage();
+         }
+     }
+
+     if (!catalog_path.empty()) {
+         ofstream catalog_file(catalog_path, ios::binary);
+         if (!catalog_file.is_open()) {
+             cerr << catalog_path << " cannot be opened." << endl;
+             return 1;
+         }
+         CatalogGenerator(catalog_size, seed).write(catalog_file);
+         return 0;
+     }
+
+     map<pair<string, string>, double> baseline;
+     if (!baseline_path.empty()) {
+         ifstream baseline_file(baseline_path);
+         if (!baseline_file.is_open()) {
+             cerr << baseline_path << " cannot be opened." << endl;
+             return 1;
+         }
+         baseline = read_baseline(baseline_file);
+     }
+
+     // Keep the CSV to compare against the baseline afterwards
+     ostringstream results;
+     cout << "artists,songs,credits,phase,runs,mean_us,p50_us,p99_us,max_us"
+          << endl;
+     for (size_t num_artists : sizes) {
+         ostringstream lines;
+         bench_size(lines, num_artists, num_queries, seed, order);
+         cout << lines.str() << flush;
+         results << lines.str();
+     }
+
+     if (!baseline.empty()) {
+         cerr << "artists phase mean_us baseline_us ratio" << endl;
+         istringstream lines(results.str());
+         string line;
+         while (getline(lines, line)) {
+             vector<string> fields;
+             stringstream row(line);
+             string field;
+             while (getline(row, field, ',')) fields.push_back(field);
+             auto before = baseline.find(make_pair(fields[0], fields[3]));
+             if (before == baseline.end() || before->second <= 0) continue;
+             double mean = atof(fields[5].c_str());
+             cerr << fields[0] << " " << fields[3] << " " << mean << " "
+                  << before->second << " " << mean / before->second << endl;
+         }
+     }
+
+     return 0;
+ }
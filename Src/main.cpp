@@ -7,61 +7,322 @@
  **   Entry point for the Six Degrees program. Handles command-line arguments,
  **   initializes the SixDegrees class, populates the collaboration graph,
  **   and processes commands as specified.
+ **
+ **   Options:
+ **     --threads N   run the commands on N worker threads (output order
+ **                   and content are the same as the sequential run)
+ **     --search M    shortest-path engine for bfs and not: "classic"
+ **                   (default), "bidirectional", "direction-optimizing"
+ **                   "astar" (A* steered by landmarks) or "labels"
+ **                   (paths read off distance labels, built if missing)
+ **     --landmarks K precompute distances from K landmark artists, for the
+ **                   dist command and --search astar (which uses 16 when
+ **                   this is not given)
+ **     --labels      build exact distance labels for the dist command
+ **                   (saved with --save-snapshot, loaded with
+ **                   --load-snapshot)
+ **     --cache MB    remember the answers to repeated queries in a cache of
+ **                   at most MB megabytes
+ **     --trees N     keep the whole search tree of the N most recent bfs
+ **                   sources, so further queries from them skip the search
+ **     --cache-stats print the cache's hit and miss counts to stderr when
+ **                   the commands are done
+ **     --interactive flush the output after every command (the default
+ **                   when commands are typed at a terminal); otherwise it
+ **                   is flushed in large blocks and on a "flush" command
+ **     --stats       time every command and count the work its searches
+ **                   do, for the stats command
+ **     --stats-on-exit  same, and print the statistics to stderr when the
+ **                   commands are done
+ **     --save-snapshot F  after reading the data file, write the graph to
+ **                   the binary snapshot F
+ **     --load-snapshot F  serve the graph from snapshot F instead of a data
+ **                   file; the positional arguments are then just
+ **                   [commandFile] [outputFile]
+ **     --serve P     instead of reading commands, answer clients that
+ **                   connect to the Unix domain socket P, on the --threads
+ **                   workers (one per core by default), until interrupted;
+ **                   no command or output file is then given
+ **     --reorder O   renumber the artists after reading the data file, so
+ **                   searches touch less memory: "bfs" (breadth-first
+ **                   order), "rcm" (reverse Cuthill-McKee) or "hubs" (most
+ **                   collaborators first); paths are as short as before, but
+ **                   one of the same length may be picked instead
  **/
 
  #include <iostream>
  #include <fstream>
  #include <string>
+ #include <vector>
+ #include <cerrno>
+ #include <cstdint>
+ #include <cstdlib>
+ #include <csignal>
+ #include <stdexcept>
+ #include <thread>
+ 
+ #include <unistd.h>
  
+ #include "QueryServer.h"
  #include "SixDegrees.h"
  
  using namespace std;
  
+ /* The server --serve runs, for the signal handler to stop */
+ static QueryServer *serving = nullptr;
+ 
+ /* Print how to invoke the program */
+ static int usage() {
+     cerr << "Usage: ./SixDegrees [--threads N] "
+          << "[--search classic|bidirectional|direction-optimizing|astar|"
+          << "labels] [--landmarks K] [--labels] [--cache MB] "
+          << "[--cache-stats] [--trees N] [--interactive] [--stats] "
+          << "[--stats-on-exit] [--save-snapshot file] "
+          << "[--reorder bfs|rcm|hubs] "
+          << "dataFile [commandFile] [outputFile]" << endl
+          << "       ./SixDegrees [--threads N] [--search mode] "
+          << "[--landmarks K] [--labels] [--cache MB] [--cache-stats] "
+          << "[--trees N] [--interactive] [--stats] [--stats-on-exit] "
+          << "--load-snapshot file [commandFile] [outputFile]" << endl
+          << "       ./SixDegrees [options] --serve socket "
+          << "(dataFile | --load-snapshot file)" << endl;
+     return 1;
+ }
+ 
+ /* Read a whole decimal count of at most 'max' into 'value'; false if the
+  * text is anything else */
+ static bool parse_count(const char *text, size_t max, size_t &value) {
+     if (*text < '0' || *text > '9') {
+         return false;
+     }
+     char *end;
+     errno = 0;
+     unsigned long long count = strtoull(text, &end, 10);
+     if (*end != '\0' || errno == ERANGE || count > max) {
+         return false;
+     }
+     value = count;
+     return true;
+ }
+ 
+ /* Stop serving on SIGINT or SIGTERM */
+ static void stop_serving(int) {
+     if (serving != nullptr) {
+         serving->stop();
+     }
+ }
+ 
+ /* Answer clients on a socket until a signal stops the server */
+ static int serve_clients(SixDegrees &six_degrees, const string &path,
+                          size_t threads) {
+     if (threads == 0) {
+         threads = thread::hardware_concurrency();
+     }
+     
+     try {
+         QueryServer server(path, threads);
+         serving = &server;
+         struct sigaction action;
+         action.sa_handler = stop_serving;
+         sigemptyset(&action.sa_mask);
+         action.sa_flags = 0;
+         sigaction(SIGINT, &action, nullptr);
+         sigaction(SIGTERM, &action, nullptr);
+         
+         cerr << "Serving on " << path << endl;
+         six_degrees.serve(server);
+         serving = nullptr;
+     } catch (const runtime_error &e) {
+         serving = nullptr;
+         cerr << e.what() << endl;
+         return 1;
+     }
+     return 0;
+ }
+ 
  int main(int argc, char *argv[]) {
+     // Separate "--option value" flags from the positional file arguments
+     vector<string> args;
+     size_t threads = 0;
+     size_t landmarks = 0;
+     bool landmarks_given = false;
+     bool astar = false;
+     bool labels = false;
+     bool cache_stats = false;
+     bool stats_on_exit = false;
+     bool interactive = false;
+     string save_path, load_path, serve_path;
+     SixDegrees six_degrees;
+     
+     for (int i = 1; i < argc; i++) {
+         string arg = argv[i];
+         if (arg == "--threads") {
+             if (i + 1 >= argc) return usage();
+             if (!parse_count(argv[++i], SIZE_MAX, threads) || threads == 0) {
+                 return usage();
+             }
+         } else if (arg == "--search") {
+             if (i + 1 >= argc) return usage();
+             string mode = argv[++i];
+             astar = (mode == "astar");
+             labels = labels || (mode == "labels");
+             if (mode == "classic") {
+                 six_degrees.set_search_mode(SixDegrees::CLASSIC_SEARCH);
+             } else if (mode == "bidirectional") {
+                 six_degrees.set_search_mode(SixDegrees::BIDIRECTIONAL_SEARCH);
+             } else if (mode == "direction-optimizing") {
+                 six_degrees.set_search_mode(
+                     SixDegrees::DIRECTION_OPTIMIZING_SEARCH);
+             } else if (mode == "astar") {
+                 six_degrees.set_search_mode(SixDegrees::LANDMARK_SEARCH);
+             } else if (mode == "labels") {
+                 six_degrees.set_search_mode(SixDegrees::LABEL_SEARCH);
+             } else {
+                 return usage();
+             }
+         } else if (arg == "--landmarks") {
+             if (i + 1 >= argc) return usage();
+             if (!parse_count(argv[++i], SIZE_MAX, landmarks)) {
+                 return usage();
+             }
+             landmarks_given = true;
+         } else if (arg == "--labels") {
+             labels = true;
+         } else if (arg == "--cache") {
+             if (i + 1 >= argc) return usage();
+             size_t megabytes;
+             if (!parse_count(argv[++i], SIZE_MAX >> 20, megabytes)) {
+                 return usage();
+             }
+             six_degrees.set_cache_budget(megabytes << 20);
+         } else if (arg == "--cache-stats") {
+             cache_stats = true;
+         } else if (arg == "--interactive") {
+             interactive = true;
+         } else if (arg == "--stats" || arg == "--stats-on-exit") {
+             six_degrees.set_stats(true);
+             stats_on_exit = stats_on_exit || arg == "--stats-on-exit";
+         } else if (arg == "--trees") {
+             if (i + 1 >= argc) return usage();
+             size_t num_trees;
+             if (!parse_count(argv[++i], SIZE_MAX, num_trees)) {
+                 return usage();
+             }
+             six_degrees.set_tree_pool(num_trees);
+         } else if (arg == "--serve") {
+             if (i + 1 >= argc) return usage();
+             serve_path = argv[++i];
+         } else if (arg == "--reorder") {
+             if (i + 1 >= argc) return usage();
+             string order = argv[++i];
+             if (order == "bfs") {
+                 six_degrees.set_vertex_order(VertexOrder::BFS_ORDER);
+             } else if (order == "rcm") {
+                 six_degrees.set_vertex_order(VertexOrder::RCM_ORDER);
+             } else if (order == "hubs") {
+                 six_degrees.set_vertex_order(VertexOrder::HUB_ORDER);
+             } else {
+                 return usage();
+             }
+         } else if (arg == "--save-snapshot" || arg == "--load-snapshot") {
+             if (i + 1 >= argc) return usage();
+             (arg == "--save-snapshot" ? save_path : load_path) = argv[++i];
+         } else if (arg.compare(0, 2, "--") == 0) {
+             return usage();
+         } else {
+             args.push_back(arg);
+         }
+     }
+     
+     // Indexes are built along with the graph; A* wants landmarks by default
+     if (!landmarks_given && astar) {
+         landmarks = SixDegrees::DEFAULT_LANDMARKS;
+     }
+     if (landmarks > 0) {
+         six_degrees.set_landmarks(landmarks);
+     }
+     six_degrees.set_labels(labels);
+     
+     // A snapshot takes the place of the data file
+     if (!load_path.empty()) {
+         args.insert(args.begin(), "");
+     }
+     
      // Validate number of command-line arguments
-     if (argc < 2 || argc > 4) {
-         cerr << "Usage: ./SixDegrees dataFile [commandFile] [outputFile]" << endl;
-         return 1;
+     if (args.size() < 1 || args.size() > (serve_path.empty() ? 3 : 1)) {
+         return usage();
      }
      
-     // Open data file
-     ifstream data_file(argv[1]);
-     if (!data_file.is_open()) {
-         cerr << argv[1] << " cannot be opened." << endl;
-         return 1;
+     if (!load_path.empty()) {
+         // Map the snapshot
+         try {
+             six_degrees.load_snapshot(load_path);
+         } catch (const runtime_error &e) {
+             cerr << e.what() << endl;
+             return 1;
+         }
+     } else {
+         // Populate graph, parsing the file in place if it can be mapped;
+         // one that cannot be opened or mapped is not read at all
+         bool populated;
+         try {
+             populated = six_degrees.populate_graph_from_file(args[0]);
+         } catch (const runtime_error &e) {
+             throw; // Do not catch as per instructions
+         }
+         if (!populated) {
+             cerr << args[0] << " cannot be opened." << endl;
+             return 1;
+         }
      }
      
-     SixDegrees six_degrees;
+     // Write the snapshot, if one was asked for
+     if (!save_path.empty()) {
+         try {
+             six_degrees.save_snapshot(save_path);
+         } catch (const runtime_error &e) {
+             cerr << e.what() << endl;
+             return 1;
+         }
+     }
      
-     // Populate graph
-     try {
-         six_degrees.populate_graph(data_file);
-     } catch (const runtime_error &e) {
-         throw; // Do not catch as per instructions
+     // Serve clients over a socket instead of reading commands
+     if (!serve_path.empty()) {
+         int status = serve_clients(six_degrees, serve_path, threads);
+         if (cache_stats) {
+             six_degrees.print_cache_stats(cerr);
+         }
+         if (stats_on_exit) {
+             six_degrees.print_stats(cerr);
+         }
+         return status;
      }
-     data_file.close();
      
      // Determine input source
      ifstream command_file;
      istream *input = &cin;
      
-     if (argc >= 3) {
-         command_file.open(argv[2]);
+     if (args.size() >= 2) {
+         command_file.open(args[1]);
          if (!command_file.is_open()) {
-             cerr << argv[2] << " cannot be opened." << endl;
+             cerr << args[1] << " cannot be opened." << endl;
              return 1;
          }
          input = &command_file;
      }
      
+     // Answer typed commands one by one, rather than in blocks
+     six_degrees.set_interactive(interactive ||
+                                 (input == &cin && isatty(STDIN_FILENO)));
+     
      // Determine output destination
      ofstream output_file;
      ostream *output = &cout;
      
-     if (argc == 4) {
-         output_file.open(argv[3]);
+     if (args.size() == 3) {
+         output_file.open(args[2]);
          if (!output_file.is_open()) {
-             cerr << argv[3] << " cannot be opened." << endl;
+             cerr << args[2] << " cannot be opened." << endl;
              if (command_file.is_open()) {
                  command_file.close();
              }
@@ -70,8 +331,19 @@
          output = &output_file;
      }
      
-     // Run command loop
-     six_degrees.run(*input, *output);
+     // Run command loop, on a thread pool if one was asked for
+     if (threads > 0) {
+         six_degrees.run_batch(*input, *output, threads);
+     } else {
+         six_degrees.run(*input, *output);
+     }
+     
+     if (cache_stats) {
+         six_degrees.print_cache_stats(cerr);
+     }
+     if (stats_on_exit) {
+         six_degrees.print_stats(cerr);
+     }
      
      // Clean up
      if (command_file.is_open()) {
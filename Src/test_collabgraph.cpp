@@ -12,13 +12,152 @@
  **/
 
  #include <iostream>
+ #include <algorithm>
  #include <cassert>
+ #include <cmath>
+ #include <cstdio>
+ #include <fstream>
+ #include <iterator>
+ #include <map>
+ #include <queue>
+ #include <random>
+ #include <sstream>
+ #include <stdexcept>
  #include <stack>
+ #include <string>
  #include <vector>
  
+ #include "Arena.h"
+ #include "BlockCutTree.h"
  #include "CollabGraph.h"
+ #include "ComponentIndex.h"
+ #include "FrozenGraph.h"
+ #include "TraversalContext.h"
+ #include "DirectionOptimizingBFS.h"
+ #include "DistanceLabels.h"
+ #include "GraphBuilder.h"
+ #include "GraphEditor.h"
+ #include "GraphSnapshot.h"
+ #include "LandmarkIndex.h"
+ #include "LandmarkSearch.h"
+ #include "LatencyHistogram.h"
+ #include "SongSet.h"
+ #include "StringPool.h"
+ #include "VertexOrder.h"
  #include "Artist.h"
  
+ // Helper function to build a random graph of 'n' artists, where a few hubs
+ // collaborate widely so that searches switch to bottom-up steps
+ FrozenGraph random_graph(int n, int edges, unsigned seed) {
+     std::mt19937 rng(seed);
+     CollabGraph g;
+     std::vector<Artist> artists;
+     for (int i = 0; i < n; i++) {
+         artists.push_back(Artist("Artist " + std::to_string(i)));
+         g.insert_vertex(artists.back());
+     }
+     for (int i = 0; i < edges; i++) {
+         int a = (i % 3 == 0) ? rng() % 8 : rng() % n;
+         int b = rng() % n;
+         if (a != b) g.insert_edge(artists[a], artists[b], std::to_string(i));
+     }
+     return g.freeze();
+ }
+ 
+ // Helper function to list the songs of every edge, row by row
+ std::string song_lists(const FrozenGraph &f) {
+     std::ostringstream out;
+     for (FrozenGraph::VertexId v = 0; v < f.num_vertices(); v++) {
+         for (FrozenGraph::EdgeId e = f.edge_begin(v); e < f.edge_end(v); e++) {
+             out << f.get_name(v) << " / " << f.get_name(f.edge_target(e)) << ":";
+             for (const FrozenGraph::SongId *song = f.edge_songs_begin(e);
+                  song != f.edge_songs_end(e); song++) {
+                 out << " [" << f.get_song(*song) << "]";
+             }
+             out << "\n";
+         }
+     }
+     return out.str();
+ }
+ 
+ // The collaborations of an edited graph, keyed by the lower id first,
+ // and the names of its artists ("" once removed)
+ typedef std::map<std::pair<FrozenGraph::VertexId, FrozenGraph::VertexId>,
+                  std::vector<std::string>> EdgeMap;
+
+ // Helper function to build the graph an edited one should match, with
+ // removed artists left out and every row in id order
+ FrozenGraph build_edges(const std::vector<std::string> &names,
+                         const EdgeMap &edges) {
+     GraphBuilder builder;
+     std::vector<FrozenGraph::VertexId> ids(names.size());
+     for (size_t v = 0; v < names.size(); v++) {
+         if (!names[v].empty()) ids[v] = builder.insert_vertex(names[v]);
+     }
+     for (const auto &edge : edges) {
+         for (const std::string &song : edge.second) {
+             builder.insert_edge(ids[edge.first.first], ids[edge.first.second],
+                                 builder.insert_song(song));
+         }
+     }
+     return builder.freeze();
+ }
+
+ // Helper function to compute hop distances with a plain queue-based BFS
+ std::vector<uint32_t> queue_distances(const FrozenGraph &f,
+                                       FrozenGraph::VertexId source) {
+     std::vector<uint32_t> distance(f.num_vertices(), BfsTree::UNREACHED);
+     std::queue<FrozenGraph::VertexId> queue;
+     distance[source] = 0;
+     queue.push(source);
+     while (!queue.empty()) {
+         FrozenGraph::VertexId v = queue.front();
+         queue.pop();
+         for (FrozenGraph::EdgeId e = f.edge_begin(v); e < f.edge_end(v); e++) {
+             FrozenGraph::VertexId w = f.edge_target(e);
+             if (distance[w] == BfsTree::UNREACHED) {
+                 distance[w] = distance[v] + 1;
+                 queue.push(w);
+             }
+         }
+     }
+     return distance;
+ }
+ 
+ // Helper function to find the path a classic queue-based BFS records,
+ // skipping the excluded vertices; empty if there is none
+ std::vector<FrozenGraph::VertexId> queue_path(
+     const FrozenGraph &f, FrozenGraph::VertexId source,
+     FrozenGraph::VertexId dest,
+     const std::vector<FrozenGraph::VertexId> &exclude) {
+     std::vector<FrozenGraph::VertexId> parent(f.num_vertices(),
+                                               FrozenGraph::NO_VERTEX);
+     std::vector<bool> seen(f.num_vertices(), false);
+     for (FrozenGraph::VertexId x : exclude) seen[x] = true;
+     std::queue<FrozenGraph::VertexId> queue;
+     seen[source] = true;
+     queue.push(source);
+     while (!queue.empty()) {
+         FrozenGraph::VertexId v = queue.front();
+         queue.pop();
+         if (v == dest) {
+             std::vector<FrozenGraph::VertexId> path;
+             for (; v != source; v = parent[v]) path.push_back(v);
+             path.push_back(source);
+             return path;
+         }
+         for (FrozenGraph::EdgeId e = f.edge_begin(v); e < f.edge_end(v); e++) {
+             FrozenGraph::VertexId w = f.edge_target(e);
+             if (!seen[w]) {
+                 seen[w] = true;
+                 parent[w] = v;
+                 queue.push(w);
+             }
+         }
+     }
+     return std::vector<FrozenGraph::VertexId>();
+ }
+ 
  int main() {
      CollabGraph g;
  
@@ -71,6 +210,857 @@
      path.pop();
      assert(path.top() == a3);
  
+     // Test 6: Freeze into CSR form, keeping insertion order for ids/rows
+     FrozenGraph f = g.freeze();
+     assert(f.num_vertices() == 3);
+     assert(f.num_edges() == 2);
+     FrozenGraph::VertexId v1 = f.find_vertex("Ariana Grande");
+     FrozenGraph::VertexId v2 = f.find_vertex("Nicki Minaj");
+     FrozenGraph::VertexId v3 = f.find_vertex("Alicia Keys");
+     assert(v1 == 0 && v2 == 1 && v3 == 2);
+     assert(f.find_vertex("Unknown") == FrozenGraph::NO_VERTEX);
+     assert(f.edge_end(v2) - f.edge_begin(v2) == 2);
+     assert(f.edge_target(f.edge_begin(v2)) == v1);
+     assert(f.edge_target(f.edge_begin(v2) + 1) == v3);
+     assert(f.get_song(f.edge_song(f.edge_begin(v1))) == "Bang Bang");
+     assert(f.get_edge(v3, v2) == "Girl On Fire (Inferno Version)");
+     assert(f.get_edge(v1, v3) == "");
+ 
+     // Test 7: Report path from a traversal context over the frozen graph
+     TraversalContext context;
+     context.reset(f.num_vertices());
+     context.mark_vertex(v1);
+     context.mark_vertex(v2);
+     context.mark_vertex(v3);
+     context.set_predecessor(v2, v1);
+     context.set_predecessor(v3, v2);
+     assert(context.is_marked(v2));
+     std::stack<FrozenGraph::VertexId> ids = context.report_path(v1, v3);
+     assert(ids.size() == 3 && ids.top() == v1);
+ 
+     // Test 8: Resetting the context forgets marks and predecessors
+     context.reset(f.num_vertices());
+     assert(!context.is_marked(v2));
+     assert(context.get_predecessor(v3) == FrozenGraph::NO_VERTEX);
+     assert(context.report_path(v1, v3).empty());
+     context.mark_vertex(v3);
+     assert(context.get_predecessor(v3) == FrozenGraph::NO_VERTEX);
+ 
+     // Test 9: Direction-optimizing sweeps match plain BFS distances, use
+     // bottom-up steps on a hub-heavy graph, and give consistent parents
+     FrozenGraph big = random_graph(3000, 9000, 3);
+     DirectionOptimizingBFS engine(big);
+     BfsTree tree;
+     for (FrozenGraph::VertexId source = 0; source < 3000; source += 299) {
+         engine.search(source, tree);
+         assert(tree.distance == queue_distances(big, source));
+         for (FrozenGraph::VertexId v = 0; v < big.num_vertices(); v++) {
+             if (!tree.reaches(v) || v == source) continue;
+             assert(tree.distance[tree.parent[v]] + 1 == tree.distance[v]);
+             assert(big.get_edge(tree.parent[v], v) != "");
+         }
+     }
+     assert(engine.bottom_up_steps() > 0);
+ 
+     // Test 10: Stopping early and excluding vertices
+     engine.search(0, tree, 1);
+     std::stack<FrozenGraph::VertexId> route = tree.path_to(1);
+     assert(route.size() == queue_distances(big, 0)[1] + 1);
+     assert(route.top() == 0);
+     DirectionOptimizingBFS small_engine(f);
+     small_engine.search(v1, tree, v3, std::vector<FrozenGraph::VertexId>(1, v2));
+     assert(!tree.reaches(v3) && tree.path_to(v3).empty());
+     small_engine.search(v1, tree, v3);
+     assert(tree.path_to(v3).size() == 3);
+ 
+     // Test 11: A snapshot maps back to the same graph, names included, and
+     // stays usable after the graph it came from is gone
+     std::string snap = "test_collabgraph.snapshot";
+     std::ostringstream before, after;
+     big.print_graph(before);
+     GraphSnapshot::save(big, snap);
+     FrozenGraph loaded;
+     {
+         FrozenGraph mapped = GraphSnapshot::load(snap);
+         loaded = mapped;
+     }
+     loaded.print_graph(after);
+     assert(before.str() == after.str());
+     assert(song_lists(loaded) == song_lists(big));
+     assert(loaded.num_songs() == big.num_songs());
+     for (FrozenGraph::VertexId v = 0; v < big.num_vertices(); v++) {
+         assert(loaded.find_vertex(big.get_name(v)) == v);
+     }
+     assert(loaded.find_vertex("Artist 3000") == FrozenGraph::NO_VERTEX);
+     GraphSnapshot::save(FrozenGraph(), snap);
+     assert(GraphSnapshot::load(snap).num_vertices() == 0);
+
+     // Test 12: Damaged snapshots are refused, not searched
+     GraphSnapshot::save(f, snap);
+     std::fstream file(snap.c_str(),
+                       std::ios::in | std::ios::out | std::ios::binary);
+     file.seekp(-3, std::ios::end);
+     file.put('#');
+     file.close();
+     bool refused = false;
+     try {
+         GraphSnapshot::load(snap);
+     } catch (const std::runtime_error &e) {
+         refused = true;
+     }
+     assert(refused);
+     std::ofstream(snap.c_str()) << "Ariana Grande\n*\n";
+     refused = false;
+     try {
+         GraphSnapshot::load(snap);
+     } catch (const std::runtime_error &e) {
+         refused = true;
+     }
+     assert(refused);
+     std::remove(snap.c_str());
+
+     // Test 13: GraphBuilder freezes to exactly what CollabGraph freezes to,
+     // including repeated artists and repeated pairs (the first edge wins)
+     std::mt19937 rng(5);
+     CollabGraph reference;
+     GraphBuilder builder;
+     std::vector<std::string> names, songs;
+     std::vector<FrozenGraph::VertexId> vertex_ids;
+     for (int i = 0; i < 600; i++) {
+         names.push_back("Artist " + std::to_string(rng() % 400));
+         reference.insert_vertex(Artist(names.back()));
+         vertex_ids.push_back(builder.insert_vertex(names.back()));
+     }
+     assert(builder.num_vertices() == reference.freeze().num_vertices());
+     for (int i = 0; i < 3000; i++) {
+         int a = rng() % names.size(), b = rng() % names.size();
+         if (names[a] == names[b]) continue;
+         songs.push_back("Song " + std::to_string(rng() % 1000));
+         reference.insert_edge(Artist(names[a]), Artist(names[b]), songs.back());
+         builder.insert_edge(vertex_ids[a], vertex_ids[b],
+                             builder.insert_song(songs.back()));
+     }
+     std::ostringstream expected_graph, built_graph;
+     reference.freeze().print_graph(expected_graph);
+     FrozenGraph built = builder.freeze();
+     built.print_graph(built_graph);
+     assert(expected_graph.str() == built_graph.str());
+     assert(built.num_songs() == reference.freeze().num_songs());
+     assert(song_lists(built) == song_lists(reference.freeze()));
+
+     // Test 14: StringPool hands out dense symbols, finds what it interned
+     // (including strings that point into its own arena) and Artists
+     // compare by symbol
+     StringPool pool;
+     for (int i = 0; i < 1000; i++) {
+         assert(pool.intern("name " + std::to_string(i)) == StringPool::Symbol(i));
+     }
+     assert(pool.size() == 1000);
+     assert(pool.intern("name 17") == 17);
+     assert(pool.find("name 999") == 999);
+     assert(pool.find("name 1000") == StringPool::NO_SYMBOL);
+     assert(pool.get(42) == "name 42");
+     StringRef inside = pool.get(5);
+     assert(pool.intern(StringRef(inside.data(), 4)) == 1000);
+     assert(pool.get(1000) == "name");
+     assert(Artist("name 3") == Artist(std::string("name ") + "3"));
+     assert(Artist("name 3").get_name_id() == Artist("name 3").get_name_id());
+     assert(not (Artist("name 3") == Artist("name 4")));
+     Artist singer("name 3");
+     singer.add_song("Shared Song");
+     assert(singer.in_song("Shared Song") and not singer.in_song("Other"));
+
+     // Test 15: Sorted song sets intersect exactly as std::set_intersection
+     // does, with the block merge and with galloping
+     for (int round = 0; round < 200; round++) {
+         std::vector<uint32_t> a, b;
+         size_t size_a = rng() % 300, size_b = round % 4 == 0 ? rng() % 8
+                                                              : rng() % 300;
+         for (size_t i = 0; i < size_a; i++) a.push_back(rng() % 1000);
+         for (size_t i = 0; i < size_b; i++) b.push_back(rng() % 1000);
+         if (round % 2 == 1) std::swap(a, b);
+         std::sort(a.begin(), a.end());
+         a.erase(std::unique(a.begin(), a.end()), a.end());
+         std::sort(b.begin(), b.end());
+         b.erase(std::unique(b.begin(), b.end()), b.end());
+         std::vector<uint32_t> expected_common;
+         std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                               std::back_inserter(expected_common));
+         std::vector<uint32_t> positions(std::min(a.size(), b.size()) + 1);
+         size_t count = SongSet::intersect_sorted(a.data(), a.size(), b.data(),
+                                                  b.size(), positions.data());
+         assert(count == expected_common.size());
+         for (size_t k = 0; k < count; k++) {
+             assert(a[positions[k]] == expected_common[k]);
+         }
+     }
+
+     // ...and artists list shared songs in discography order, once each,
+     // while a repeated edge adds its song to the pair's edge
+     Artist first("Duo A"), second("Duo B");
+     const char *first_songs[] = { "Zeta", "Alpha", "Mu", "Alpha", "Solo" };
+     const char *second_songs[] = { "Mu", "Other", "Alpha", "Zeta" };
+     for (const char *song : first_songs) first.add_song(song);
+     for (const char *song : second_songs) second.add_song(song);
+     std::vector<Artist::Symbol> shared = first.get_collaborations(second);
+     assert(shared.size() == 3);
+     assert(Artist::symbols().get(shared[0]) == "Zeta");
+     assert(Artist::symbols().get(shared[1]) == "Alpha");
+     assert(Artist::symbols().get(shared[2]) == "Mu");
+     assert(first.get_collaboration(second) == "Zeta");
+     assert(second.get_collaboration(first) == "Mu");
+     assert(first.get_collaborations(Artist("Duo C")).empty());
+     CollabGraph duo;
+     duo.insert_vertex(first);
+     duo.insert_vertex(second);
+     duo.insert_edge(first, second, "Zeta");
+     duo.insert_edge(second, first, "Alpha");
+     duo.insert_edge(first, second, "Zeta");
+     assert(duo.get_edge(second, first) == "Zeta");
+     FrozenGraph frozen_duo = duo.freeze();
+     assert(frozen_duo.num_edges() == 1);
+     assert(song_lists(frozen_duo) ==
+            "Duo A / Duo B: [Zeta] [Alpha]\nDuo B / Duo A: [Zeta] [Alpha]\n");
+
+     // Test 16: Landmark bounds hold the true distance between them, and
+     // A* steered by them finds shortest paths, also around excluded artists
+     LandmarkIndex landmarks;
+     landmarks.build(big, 6);
+     assert(landmarks.num_landmarks() == 6);
+     assert(landmarks.lower_bound(5, 5) == 0 && landmarks.upper_bound(5, 5) == 0);
+     std::vector<FrozenGraph::VertexId> avoid;
+     for (FrozenGraph::VertexId v = 0; v < 8; v++) avoid.push_back(v);
+     for (FrozenGraph::VertexId source = 11; source < 3000; source += 397) {
+         std::vector<uint32_t> distance = queue_distances(big, source);
+         for (FrozenGraph::VertexId v = 0; v < big.num_vertices(); v++) {
+             uint32_t lower = landmarks.lower_bound(source, v);
+             uint32_t upper = landmarks.upper_bound(source, v);
+             if (distance[v] == BfsTree::UNREACHED) {
+                 assert(lower == LandmarkIndex::UNREACHED ||
+                        upper == LandmarkIndex::UNREACHED);
+             } else {
+                 assert(lower <= distance[v] && distance[v] <= upper);
+             }
+         }
+         engine.search(source, tree, FrozenGraph::NO_VERTEX, avoid);
+         for (FrozenGraph::VertexId dest = 8; dest < 3000; dest += 131) {
+             std::stack<FrozenGraph::VertexId> found =
+                 landmark_search(big, landmarks, source, dest,
+                                 std::vector<FrozenGraph::VertexId>(), context);
+             assert(found.size() == (distance[dest] == BfsTree::UNREACHED
+                                     ? 0 : distance[dest] + 1));
+             found = landmark_search(big, landmarks, source, dest, avoid,
+                                     context);
+             assert(found.size() == (tree.reaches(dest) ? tree.distance[dest] + 1
+                                                        : 0));
+         }
+     }
+
+     // Test 17: Distance labels give exact distances and rebuild shortest
+     // paths edge by edge, and travel in a snapshot with the graph
+     DistanceLabels labels;
+     assert(labels.empty());
+     labels.build(big);
+     assert(labels.num_vertices() == big.num_vertices());
+     GraphSnapshot::save(big, snap, &labels);
+     DistanceLabels mapped_labels;
+     FrozenGraph labelled = GraphSnapshot::load(snap, &mapped_labels);
+     assert(mapped_labels.num_entries() == labels.num_entries());
+     for (FrozenGraph::VertexId source = 5; source < 3000; source += 433) {
+         std::vector<uint32_t> distance = queue_distances(big, source);
+         for (FrozenGraph::VertexId v = 0; v < big.num_vertices(); v++) {
+             assert(labels.distance(source, v) == distance[v]);
+             assert(mapped_labels.distance(v, source) == distance[v]);
+             std::stack<FrozenGraph::VertexId> hops = labels.path(source, v);
+             if (distance[v] == BfsTree::UNREACHED) {
+                 assert(hops.empty());
+                 continue;
+             }
+             assert(hops.size() == distance[v] + 1 && hops.top() == source);
+             for (FrozenGraph::VertexId at = hops.top(); hops.pop(),
+                  !hops.empty(); at = hops.top()) {
+                 assert(labelled.find_edge(at, hops.top()) !=
+                        FrozenGraph::NO_EDGE);
+             }
+         }
+     }
+     GraphSnapshot::save(big, snap);
+     GraphSnapshot::load(snap, &mapped_labels);
+     assert(mapped_labels.empty());
+     std::remove(snap.c_str());
+
+     // Test 18: Component labels agree with reachability, whether built
+     // from a graph or grown one artist and collaboration at a time
+     FrozenGraph sparse = random_graph(2000, 1200, 5);
+     ComponentIndex components, grown;
+     components.build(sparse);
+     for (FrozenGraph::VertexId v = 0; v < sparse.num_vertices(); v++) {
+         assert(grown.add_vertex() == v);
+     }
+     for (FrozenGraph::VertexId v = 0; v < sparse.num_vertices(); v++) {
+         for (FrozenGraph::EdgeId e = sparse.edge_begin(v);
+              e < sparse.edge_end(v); e++) {
+             grown.unite(sparse.edge_target(e), v);
+         }
+     }
+     std::vector<size_t> sizes = components.sizes();
+     assert(sizes.size() == components.num_components() && sizes.size() > 1);
+     assert(grown.sizes() == sizes);
+     size_t covered = 0;
+     for (size_t size : sizes) covered += size;
+     assert(covered == sparse.num_vertices());
+     for (FrozenGraph::VertexId source = 0; source < 2000; source += 37) {
+         std::vector<uint32_t> distance = queue_distances(sparse, source);
+         size_t reached = 0;
+         for (FrozenGraph::VertexId v = 0; v < sparse.num_vertices(); v++) {
+             bool reachable = distance[v] != BfsTree::UNREACHED;
+             assert(components.connected(source, v) == reachable);
+             assert(grown.connected(v, source) == reachable);
+             reached += reachable;
+         }
+         assert(components.component_size(source) == reached);
+     }
+
+     // Test 19: An edited graph matches one built from scratch with the
+     // same edits, copies made before the edits keep the old graph, the
+     // component labels follow every added and removed collaboration, and
+     // a snapshot of the edited graph loads back the same
+     std::mt19937 edit_rng(19);
+     std::vector<std::string> edit_names;
+     EdgeMap edit_edges;
+     for (int i = 0; i < 300; i++) {
+         edit_names.push_back("Artist " + std::to_string(i));
+     }
+     for (int i = 0; i < 250; i++) {
+         FrozenGraph::VertexId a = edit_rng() % 300, b = edit_rng() % 300;
+         if (a == b) continue;
+         edit_edges[std::make_pair(std::min(a, b), std::max(a, b))].push_back(
+             "Song " + std::to_string(i));
+     }
+     FrozenGraph edited = build_edges(edit_names, edit_edges);
+     FrozenGraph unedited = edited;
+     std::string unedited_songs = song_lists(unedited);
+     GraphEditor editor(edited);
+     ComponentIndex edit_components;
+     edit_components.build(edited);
+
+     for (int step = 0; step < 600; step++) {
+         FrozenGraph::VertexId a = edit_rng() % edit_names.size();
+         if (edit_names[a].empty()) continue;
+         int op = edit_rng() % 20;
+         if (op == 0) {
+             std::string name = "New " + std::to_string(step);
+             assert(editor.insert_vertex(name) == edit_names.size());
+             assert(edit_components.add_vertex() == edit_names.size());
+             edit_names.push_back(name);
+         } else if (op == 1) {
+             std::vector<FrozenGraph::VertexId> partners;
+             for (FrozenGraph::EdgeId e = edited.edge_begin(a);
+                  e < edited.edge_end(a); e++) {
+                 partners.push_back(edited.edge_target(e));
+             }
+             for (FrozenGraph::VertexId w : partners) {
+                 editor.set_songs(a, w, std::vector<FrozenGraph::SongId>());
+                 edit_components.separate(edited, a, w);
+                 edit_edges.erase(std::make_pair(std::min(a, w), std::max(a, w)));
+             }
+             editor.remove_vertex(a);
+             edit_components.remove_vertex(a);
+             assert(edited.find_vertex(edit_names[a]) == FrozenGraph::NO_VERTEX);
+             edit_names[a] = "";
+         } else {
+             FrozenGraph::VertexId b = edit_rng() % edit_names.size();
+             if (a == b || edit_names[b].empty()) continue;
+             std::vector<std::string> titles;
+             std::vector<FrozenGraph::SongId> songs;
+             for (size_t k = edit_rng() % 3; k > 0; k--) {
+                 titles.push_back("Song " + std::to_string(edit_rng() % 400));
+                 if (std::count(titles.begin(), titles.end(), titles.back()) > 1) {
+                     titles.pop_back();
+                     continue;
+                 }
+                 songs.push_back(editor.insert_song(titles.back()));
+             }
+             bool existed = edited.find_edge(a, b) != FrozenGraph::NO_EDGE;
+             editor.set_songs(a, b, songs);
+             auto key = std::make_pair(std::min(a, b), std::max(a, b));
+             if (titles.empty()) {
+                 edit_edges.erase(key);
+                 if (existed) edit_components.separate(edited, a, b);
+             } else {
+                 edit_edges[key] = titles;
+                 edit_components.unite(a, b);
+             }
+         }
+     }
+
+     FrozenGraph rebuilt = build_edges(edit_names, edit_edges);
+     assert(song_lists(edited) == song_lists(rebuilt));
+     assert(edited.num_edges() == rebuilt.num_edges());
+     assert(song_lists(unedited) == unedited_songs);
+     assert(edit_components.num_vertices() == rebuilt.num_vertices());
+     for (FrozenGraph::VertexId source = 0; source < edit_names.size(); source += 7) {
+         if (edit_names[source].empty()) continue;
+         std::vector<uint32_t> distance = queue_distances(edited, source);
+         size_t reached = 0;
+         for (FrozenGraph::VertexId v = 0; v < edit_names.size(); v++) {
+             if (edit_names[v].empty()) continue;
+             bool reachable = distance[v] != BfsTree::UNREACHED;
+             assert(edit_components.connected(source, v) == reachable);
+             reached += reachable;
+         }
+         assert(edit_components.component_size(source) == reached);
+     }
+     ComponentIndex rebuilt_components;
+     rebuilt_components.build(rebuilt);
+     assert(edit_components.sizes() == rebuilt_components.sizes());
+
+     std::string edited_snap = "test_collabgraph_edited.snap";
+     GraphSnapshot::save(edited, edited_snap);
+     FrozenGraph edited_loaded = GraphSnapshot::load(edited_snap);
+     std::remove(edited_snap.c_str());
+     assert(song_lists(edited_loaded) == song_lists(rebuilt));
+     assert(edited_loaded.num_vertices() == rebuilt.num_vertices());
+
+     // Test 20: The block-cut tree finds exactly the artists and the
+     // collaborations whose removal disconnects others, and its verdict on
+     // an exclusion list agrees with searching around the excluded artists
+     FrozenGraph forest = random_graph(400, 420, 20);
+     BlockCutTree blocks;
+     blocks.build(forest);
+     assert(blocks.num_vertices() == forest.num_vertices());
+     assert(blocks.num_blocks() > 1 && !blocks.cut_vertices().empty());
+     for (FrozenGraph::VertexId x = 0; x < forest.num_vertices(); x++) {
+         bool cut = false;
+         if (forest.degree(x) > 1) {
+             std::vector<FrozenGraph::VertexId> without(1, x);
+             FrozenGraph::VertexId first = forest.edge_target(forest.edge_begin(x));
+             for (FrozenGraph::EdgeId e = forest.edge_begin(x) + 1;
+                  e < forest.edge_end(x); e++) {
+                 cut = cut || queue_path(forest, first, forest.edge_target(e),
+                                         without).empty();
+             }
+         }
+         assert(blocks.is_cut_vertex(x) == cut);
+         assert(std::binary_search(blocks.cut_vertices().begin(),
+                                   blocks.cut_vertices().end(), x) == cut);
+     }
+     size_t bridges = 0;
+     for (FrozenGraph::VertexId a = 0; a < forest.num_vertices(); a++) {
+         for (FrozenGraph::EdgeId e = forest.edge_begin(a);
+              e < forest.edge_end(a); e++) {
+             FrozenGraph::VertexId b = forest.edge_target(e);
+             if (b < a) continue;
+             // Other routes from a to b avoid the edge by way of a third artist
+             bool other_route = false;
+             for (FrozenGraph::EdgeId f = forest.edge_begin(a);
+                  f < forest.edge_end(a) && !other_route; f++) {
+                 FrozenGraph::VertexId c = forest.edge_target(f);
+                 if (c == b) continue;
+                 std::vector<FrozenGraph::VertexId> without(1, a);
+                 other_route = !queue_path(forest, c, b, without).empty();
+             }
+             bool bridge = std::binary_search(blocks.bridges().begin(),
+                                              blocks.bridges().end(),
+                                              std::make_pair(a, b));
+             assert(bridge == !other_route);
+             bridges += bridge;
+         }
+     }
+     assert(bridges == blocks.bridges().size() && bridges > 0);
+
+     std::mt19937 block_rng(20);
+     size_t verdicts[3] = { 0, 0, 0 };
+     for (int query = 0; query < 3000; query++) {
+         FrozenGraph::VertexId source = block_rng() % 400, dest = block_rng() % 400;
+         std::vector<FrozenGraph::VertexId> none;
+         std::vector<FrozenGraph::VertexId> plain = queue_path(forest, source, dest, none);
+         if (plain.empty()) continue;
+         std::vector<FrozenGraph::VertexId> exclude;
+         if (plain.size() > 2 && block_rng() % 2) {
+             exclude.push_back(plain[1 + block_rng() % (plain.size() - 2)]);
+         }
+         for (size_t k = block_rng() % 3; k > 0; k--) {
+             exclude.push_back(block_rng() % 400);
+         }
+         BlockCutTree::Effect effect = blocks.effect(source, dest, exclude);
+         verdicts[effect]++;
+         std::vector<FrozenGraph::VertexId> around =
+             queue_path(forest, source, dest, exclude);
+         if (effect == BlockCutTree::SEPARATES) assert(around.empty());
+         if (effect == BlockCutTree::NO_EFFECT) assert(around == plain);
+     }
+     assert(verdicts[BlockCutTree::NO_EFFECT] > 0);
+     assert(verdicts[BlockCutTree::MAY_SEPARATE] > 0);
+     assert(verdicts[BlockCutTree::SEPARATES] > 0);
+
+     // Test 21: Histogram percentiles are within a sixteenth of the exact
+     // ones, and traversal counts add up across both sides of a search
+     LatencyHistogram histogram;
+     assert(histogram.count() == 0 && histogram.percentile(0.5) == 0);
+     std::mt19937_64 latency_rng(21);
+     std::vector<uint64_t> latencies;
+     for (int i = 0; i < 20000; i++) {
+         // Spread over nine orders of magnitude, with some exact small ones
+         uint64_t ns = i % 10 == 0 ? latency_rng() % 32
+                                   : latency_rng() >> (34 + latency_rng() % 30);
+         latencies.push_back(ns);
+         histogram.record(ns);
+     }
+     std::sort(latencies.begin(), latencies.end());
+     assert(histogram.count() == latencies.size());
+     assert(histogram.max() == latencies.back());
+     assert(histogram.percentile(1.0) == latencies.back());
+     const double fractions[] = { 0.01, 0.1, 0.5, 0.9, 0.99, 0.999 };
+     for (double fraction : fractions) {
+         uint64_t exact = latencies[size_t(std::ceil(fraction * latencies.size())) - 1];
+         uint64_t estimate = histogram.percentile(fraction);
+         assert(estimate >= exact && estimate - exact <= exact / 16);
+     }
+     histogram.clear();
+     assert(histogram.count() == 0 && histogram.max() == 0);
+
+     TraversalContext counted;
+     counted.count_expansion(5, 3);
+     counted.count_expansion(2, 7);
+     counted.backward().count_expansion(4, 2);
+     TraversalContext::Counts counts = counted.take_counts();
+     assert(counts.visited == 3 && counts.scanned == 11 && counts.queue_peak == 9);
+     counts = counted.take_counts();
+     assert(counts.visited == 0 && counts.scanned == 0 && counts.queue_peak == 0);
+
+     // Test 22: Arena-built graphs copy deeply, predecessors included, and
+     // hand their lists to the arena; the arena itself releases in one go
+     Arena arena;
+     Arena::Array<uint64_t> numbers = Arena::Array<uint64_t>();
+     for (uint64_t i = 0; i < 100000; i++) numbers.push_back(arena, i);
+     assert(numbers.size() == 100000 && numbers[99999] == 99999);
+     assert(arena.used() >= 100000 * sizeof(uint64_t));
+     assert(arena.reserved() >= arena.used());
+     arena.release();
+     assert(arena.used() == 0 && arena.reserved() == 0);
+
+     CollabGraph original;
+     original.insert_vertex(a1);
+     original.insert_vertex(a2);
+     original.insert_vertex(a3);
+     original.insert_edge(a1, a2, "Bang Bang");
+     original.insert_edge(a2, a1, "Side to Side");
+     original.set_predecessor(a2, a1);
+     CollabGraph copied(original);
+     original = CollabGraph();
+     assert(!original.is_vertex(a1));
+     copied.insert_edge(a2, a3, "Girl On Fire (Inferno Version)");
+     assert(copied.get_edge(a2, a1) == "Bang Bang");
+     assert(copied.get_predecessor(a2) == a1);
+     assert(copied.get_predecessor(a1).get_name() == "");
+     std::string copied_songs = song_lists(copied.freeze());
+     assert(copied_songs == "Ariana Grande / Nicki Minaj: [Bang Bang] [Side to Side]\n"
+                            "Nicki Minaj / Ariana Grande: [Bang Bang] [Side to Side]\n"
+                            "Nicki Minaj / Alicia Keys: [Girl On Fire (Inferno Version)]\n"
+                            "Alicia Keys / Nicki Minaj: [Girl On Fire (Inferno Version)]\n");
+
+     // Test 23: A breadth-first search on vertex handles finds the path the
+     // frozen graph's classic search finds, and neighbors reads the rows
+     // in insertion order with each edge's first song
+     {
+         std::mt19937 handle_rng(23);
+         CollabGraph walked;
+         std::vector<Artist> members;
+         for (int i = 0; i < 300; i++) {
+             members.push_back(Artist("Artist " + std::to_string(i)));
+             walked.insert_vertex(members.back());
+         }
+         for (int i = 0; i < 900; i++) {
+             int a = handle_rng() % 300, b = handle_rng() % 300;
+             if (a != b) walked.insert_edge(members[a], members[b], "Song " + std::to_string(i));
+         }
+         FrozenGraph walked_frozen = walked.freeze();
+
+         CollabGraph::VertexHandle first = walked.find_vertex(members[0]);
+         assert(first.valid() && walked.get_artist(first) == members[0]);
+         size_t entry = 0;
+         for (CollabGraph::Neighbor n : walked.neighbors(first)) {
+             FrozenGraph::EdgeId e = walked_frozen.edge_begin(0) + entry++;
+             assert(walked.get_artist(n.vertex).get_name() ==
+                    walked_frozen.get_name(walked_frozen.edge_target(e)).str());
+             assert(Artist::symbols().get(n.song) == walked_frozen.get_song(walked_frozen.edge_song(e)));
+         }
+         assert(entry == walked_frozen.degree(0));
+         assert(!walked.get_predecessor(first).valid());
+         assert(!CollabGraph::VertexHandle().valid());
+
+         for (int dest = 1; dest < 300; dest += 37) {
+             walked.clear_metadata();
+             CollabGraph::VertexHandle source = walked.find_vertex(members[0]);
+             CollabGraph::VertexHandle target = walked.find_vertex(members[dest]);
+             std::vector<CollabGraph::VertexHandle> frontier(1, source);
+             walked.mark_vertex(source);
+             for (size_t head = 0; head < frontier.size(); head++) {
+                 CollabGraph::VertexHandle current = frontier[head];
+                 if (current == target) break;
+                 for (CollabGraph::Neighbor n : walked.neighbors(current)) {
+                     if (!walked.is_marked(n.vertex)) {
+                         walked.mark_vertex(n.vertex);
+                         walked.set_predecessor(n.vertex, current);
+                         frontier.push_back(n.vertex);
+                     }
+                 }
+             }
+             std::stack<Artist> found = walked.report_path(members[0], members[dest]);
+             std::vector<FrozenGraph::VertexId> expected =
+                 queue_path(walked_frozen, 0, dest, std::vector<FrozenGraph::VertexId>());
+             assert(found.size() == expected.size());
+             for (size_t i = expected.size(); i-- > 0; found.pop()) {
+                 assert(found.top().get_name() == walked_frozen.get_name(expected[i]).str());
+             }
+         }
+
+         bool threw = false;
+         try {
+             walked.neighbors(CollabGraph::VertexHandle());
+         } catch (const std::runtime_error &) {
+             threw = true;
+         }
+         assert(threw);
+     }
+
+     // Test 24: A hub with thousands of collaborators finds each edge, from
+     // either end, whether inserting a song again or looking it up
+     {
+         CollabGraph hubbed;
+         Artist hub("Hub");
+         hubbed.insert_vertex(hub);
+         std::vector<Artist> spokes;
+         for (int i = 0; i < 20000; i++) {
+             spokes.push_back(Artist("Spoke " + std::to_string(i)));
+             hubbed.insert_vertex(spokes.back());
+             hubbed.insert_edge(hub, spokes.back(), "First " + std::to_string(i));
+         }
+         for (int i = 19999; i >= 0; i--) {
+             hubbed.insert_edge(spokes[i], hub, "Second " + std::to_string(i));
+             hubbed.insert_edge(hub, spokes[i], "First " + std::to_string(i));
+         }
+         hubbed.insert_edge(spokes[0], spokes[1], "Aside");
+         assert(hubbed.get_edge(spokes[1], spokes[0]) == "Aside");
+         assert(hubbed.get_edge(spokes[1], spokes[2]) == "");
+         for (int i = 0; i < 20000; i += 997) {
+             assert(hubbed.get_edge(hub, spokes[i]) == "First " + std::to_string(i));
+             assert(hubbed.get_edge(spokes[i], hub) == "First " + std::to_string(i));
+         }
+
+         FrozenGraph hub_frozen = hubbed.freeze();
+         assert(hub_frozen.num_edges() == 20001);
+         assert(hub_frozen.degree(0) == 20000);
+         FrozenGraph::VertexId last = hub_frozen.find_vertex("Spoke 19999");
+         assert(hub_frozen.get_edge(0, last) == "First 19999");
+         assert(hub_frozen.get_edge(last, 0) == "First 19999");
+         FrozenGraph::EdgeId e = hub_frozen.find_edge(last, 0);
+         assert(hub_frozen.edge_songs_end(e) - hub_frozen.edge_songs_begin(e) == 2);
+         assert(hub_frozen.get_song(hub_frozen.edge_songs_begin(e)[1]) == "Second 19999");
+     }
+
+     // Test 25: Renumbering the vertices keeps every artist, edge and song,
+     // sorts every row by the new ids, and keeps shortest paths as short
+     {
+         FrozenGraph before = random_graph(400, 900, 25);
+         VertexOrder::Method methods[] = { VertexOrder::INSERTION_ORDER,
+                                           VertexOrder::BFS_ORDER,
+                                           VertexOrder::RCM_ORDER,
+                                           VertexOrder::HUB_ORDER };
+         for (VertexOrder::Method method : methods) {
+             std::vector<FrozenGraph::VertexId> new_id =
+                 VertexOrder::compute(before, method);
+             assert(new_id == VertexOrder::compute(before, method));
+             std::vector<FrozenGraph::VertexId> sorted(new_id);
+             std::sort(sorted.begin(), sorted.end());
+             for (FrozenGraph::VertexId v = 0; v < sorted.size(); v++) {
+                 assert(sorted[v] == v);
+             }
+
+             FrozenGraph after = VertexOrder::relabel(before, new_id);
+             assert(after.num_vertices() == before.num_vertices());
+             assert(after.num_edges() == before.num_edges());
+             assert(after.num_songs() == before.num_songs());
+             for (FrozenGraph::VertexId v = 0; v < before.num_vertices(); v++) {
+                 FrozenGraph::VertexId w = new_id[v];
+                 assert(after.find_vertex(before.get_name(v)) == w);
+                 assert(after.degree(w) == before.degree(v));
+                 for (FrozenGraph::EdgeId e = after.edge_begin(w) + 1;
+                      e < after.edge_end(w); e++) {
+                     assert(after.edge_target(e - 1) < after.edge_target(e));
+                 }
+                 for (FrozenGraph::EdgeId e = before.edge_begin(v);
+                      e < before.edge_end(v); e++) {
+                     FrozenGraph::EdgeId moved =
+                         after.find_edge(w, new_id[before.edge_target(e)]);
+                     assert(moved != FrozenGraph::NO_EDGE);
+                     assert(std::equal(before.edge_songs_begin(e),
+                                       before.edge_songs_end(e),
+                                       after.edge_songs_begin(moved)));
+                 }
+             }
+             if (method == VertexOrder::INSERTION_ORDER) {
+                 std::istringstream before_in(song_lists(before)),
+                                    after_in(song_lists(after));
+                 std::vector<std::string> before_lines, after_lines;
+                 for (std::string line; std::getline(before_in, line);) {
+                     before_lines.push_back(line);
+                 }
+                 for (std::string line; std::getline(after_in, line);) {
+                     after_lines.push_back(line);
+                 }
+                 std::sort(before_lines.begin(), before_lines.end());
+                 std::sort(after_lines.begin(), after_lines.end());
+                 assert(after_lines == before_lines);
+                 assert(song_lists(VertexOrder::relabel(after, new_id)) ==
+                        song_lists(after));
+             }
+
+             for (FrozenGraph::VertexId s = 0; s < 400; s += 41) {
+                 for (FrozenGraph::VertexId d = 3; d < 400; d += 53) {
+                     std::vector<FrozenGraph::VertexId> path =
+                         queue_path(before, s, d, std::vector<FrozenGraph::VertexId>());
+                     std::vector<FrozenGraph::VertexId> moved_path =
+                         queue_path(after, new_id[s], new_id[d],
+                                    std::vector<FrozenGraph::VertexId>());
+                     assert(moved_path.size() == path.size());
+                     for (size_t i = 0; i + 1 < moved_path.size(); i++) {
+                         assert(after.find_edge(moved_path[i], moved_path[i + 1]) !=
+                                FrozenGraph::NO_EDGE);
+                     }
+                     if (not path.empty()) {
+                         assert(moved_path.front() == new_id[path.front()]);
+                         assert(moved_path.back() == new_id[path.back()]);
+                     }
+                 }
+             }
+         }
+
+         // A path inserted out of order: reverse Cuthill-McKee numbers it
+         // end to end, and hub order puts the busiest artist first
+         CollabGraph line;
+         std::vector<Artist> stops;
+         int shuffled[] = { 5, 2, 7, 0, 3, 6, 1, 4 };
+         for (int i : shuffled) {
+             stops.push_back(Artist("Stop " + std::to_string(i)));
+             line.insert_vertex(stops.back());
+         }
+         for (int i = 0; i < 7; i++) {
+             line.insert_edge(Artist("Stop " + std::to_string(i)),
+                              Artist("Stop " + std::to_string(i + 1)), "Leg");
+         }
+         line.insert_edge(Artist("Stop 3"), Artist("Stop 6"), "Shortcut");
+         FrozenGraph line_frozen = line.freeze();
+         FrozenGraph rcm = VertexOrder::relabel(
+             line_frozen, VertexOrder::compute(line_frozen, VertexOrder::RCM_ORDER));
+         FrozenGraph::EdgeId widest = 0;
+         for (FrozenGraph::VertexId v = 0; v < rcm.num_vertices(); v++) {
+             for (FrozenGraph::Neighbor n : rcm.neighbors(v)) {
+                 widest = std::max<FrozenGraph::EdgeId>(
+                     widest, n.vertex > v ? n.vertex - v : v - n.vertex);
+             }
+         }
+         assert(widest <= 2);
+         FrozenGraph hubs = VertexOrder::relabel(
+             line_frozen, VertexOrder::compute(line_frozen, VertexOrder::HUB_ORDER));
+         assert(hubs.get_name(0) == "Stop 3" && hubs.get_name(1) == "Stop 6");
+         assert(hubs.get_name(2) == "Stop 5" && hubs.get_name(3) == "Stop 2");
+     }
+
+     // Test 26: Edge lookups on a hub give the same answers whether its
+     // row is searched in insertion order or, once sorted, by bisection,
+     // and stay right as an editor changes the row
+     {
+         CollabGraph shuffled;
+         std::vector<Artist> spokes;
+         Artist hub("Hub");
+         shuffled.insert_vertex(hub);
+         for (int i = 0; i < 3000; i++) {
+             spokes.push_back(Artist("Spoke " + std::to_string(i)));
+             shuffled.insert_vertex(spokes.back());
+         }
+         std::vector<int> joined;
+         for (int i = 0; i < 3000; i += 3) joined.push_back(i);
+         std::shuffle(joined.begin(), joined.end(), std::mt19937(26));
+         for (int i : joined) {
+             shuffled.insert_edge(hub, spokes[i], "Song " + std::to_string(i));
+         }
+         shuffled.insert_edge(spokes[1], spokes[2], "Aside");
+
+         FrozenGraph scanned = shuffled.freeze();
+         std::vector<FrozenGraph::VertexId> hub_row;
+         for (FrozenGraph::Neighbor next : scanned.neighbors(0)) {
+             hub_row.push_back(next.vertex);
+         }
+         assert(!std::is_sorted(hub_row.begin(), hub_row.end()));
+         std::vector<FrozenGraph::VertexId> same(scanned.num_vertices());
+         for (FrozenGraph::VertexId v = 0; v < same.size(); v++) same[v] = v;
+         FrozenGraph bisected = VertexOrder::relabel(scanned, same);
+         FrozenGraph::VertexId center = bisected.find_vertex("Hub");
+         assert(bisected.degree(center) == 1000);
+         for (FrozenGraph::VertexId v = 0; v < bisected.num_vertices(); v++) {
+             bool linked = v != center && (v - 1) % 3 == 0;
+             FrozenGraph::EdgeId there = bisected.find_edge(center, v);
+             FrozenGraph::EdgeId back = bisected.find_edge(v, center);
+             assert((there != FrozenGraph::NO_EDGE) == linked);
+             assert((back != FrozenGraph::NO_EDGE) == linked);
+             assert((scanned.find_edge(center, v) != FrozenGraph::NO_EDGE) == linked);
+             assert(bisected.get_edge(center, v) == scanned.get_edge(center, v));
+             assert(bisected.get_edge(v, center) == scanned.get_edge(v, center));
+             if (linked) {
+                 assert(bisected.edge_target(there) == v);
+                 assert(bisected.edge_target(back) == center);
+             }
+         }
+         assert(bisected.get_edge(bisected.find_vertex("Spoke 2"),
+                                  bisected.find_vertex("Spoke 1")) == "Aside");
+
+         GraphEditor hub_editor(bisected);
+         FrozenGraph::SongId late = hub_editor.insert_song("Late");
+         for (FrozenGraph::VertexId v = 2; v < bisected.num_vertices(); v += 7) {
+             hub_editor.set_songs(center, v, std::vector<FrozenGraph::SongId>(
+                                                  v % 2 ? 0 : 1, late));
+         }
+         for (FrozenGraph::VertexId v = 0; v < bisected.num_vertices(); v++) {
+             bool linked = v != center && (v - 1) % 3 == 0;
+             if (v >= 2 && (v - 2) % 7 == 0) linked = v % 2 == 0;
+             assert((bisected.find_edge(center, v) != FrozenGraph::NO_EDGE) == linked);
+             assert((bisected.find_edge(v, center) != FrozenGraph::NO_EDGE) == linked);
+         }
+     }
+
+     // Test 27: A long run of edits to a hub's row keeps the editor's arrays
+     // within twice the entries in use, and every collaboration right
+     {
+         CollabGraph star;
+         Artist hub("Hub");
+         star.insert_vertex(hub);
+         for (int i = 0; i < 2000; i++) {
+             Artist spoke("Spoke " + std::to_string(i));
+             star.insert_vertex(spoke);
+             star.insert_edge(hub, spoke, "Song " + std::to_string(i));
+         }
+         FrozenGraph growing = star.freeze();
+         GraphEditor star_editor(growing);
+         FrozenGraph::SongId encore = star_editor.insert_song("Encore");
+         std::vector<bool> linked(2001, true);
+         linked[0] = false;
+         std::mt19937 star_rng(27);
+         for (int step = 0; step < 3000; step++) {
+             FrozenGraph::VertexId v = 1 + star_rng() % 2000;
+             linked[v] = !linked[v];
+             star_editor.set_songs(0, v, std::vector<FrozenGraph::SongId>(
+                                             linked[v] ? 1 : 0, encore));
+             assert(star_editor.stored_entries() <= 4 * growing.num_edges());
+         }
+         for (FrozenGraph::VertexId v = 0; v <= 2000; v++) {
+             assert((growing.find_edge(0, v) != FrozenGraph::NO_EDGE) == linked[v]);
+             assert((growing.find_edge(v, 0) != FrozenGraph::NO_EDGE) == linked[v]);
+         }
+         assert(growing.degree(0) == growing.num_edges());
+     }
+
      std::cout << "All CollabGraph tests passed!\n";
      return 0;
  }
\ No newline at end of file